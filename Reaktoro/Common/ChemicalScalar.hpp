@@ -34,6 +34,14 @@ class ChemicalScalarBase;
 /// @see ThermoScalar, ChemicalVector, ThermoVector
 using ChemicalScalar = ChemicalScalarBase<double,Vector>;
 
+/// A type that represents a chemical scalar of a system with a number of species known at compile time.
+/// The mole derivatives are stored inline, so that no heap allocation happens when instances
+/// of this type are created, copied, or combined in expressions.
+/// @tparam NumSpecies The number of species in the chemical system
+/// @see ChemicalScalar
+template<int NumSpecies>
+using ChemicalScalarFixed = ChemicalScalarBase<double,VectorFixed<NumSpecies>>;
+
 /// A template base class to represent a chemical scalar and its partial derivatives.
 /// A *chemical scalar* is a quantity that depends on temperature, pressure,
 /// and mole amounts of species.
@@ -38,6 +38,19 @@ class ChemicalVectorBase;
 /// @see ThermoVector, ThermoScalar, ChemicalScalar
 using ChemicalVector = ChemicalVectorBase<Vector,Vector,Vector,Matrix>;
 
+/// A type that represents a vector of chemical scalars with sizes known at compile time.
+/// @tparam NumRows The number of chemical scalars in the vector
+/// @tparam NumSpecies The number of species in the chemical system
+/// @see ChemicalVector, ChemicalScalarFixed
+template<int NumRows, int NumSpecies>
+using ChemicalVectorFixed = ChemicalVectorBase<VectorFixed<NumRows>,VectorFixed<NumRows>,VectorFixed<NumRows>,MatrixFixed<NumRows,NumSpecies>>;
+
+/// The type of the evaluated result of an operation on a ChemicalVectorBase instance.
+/// This type preserves the storage of the operand, so that operations on a
+/// ChemicalVectorFixed instance produce another ChemicalVectorFixed instance.
+template<typename V, typename T, typename P, typename N>
+using ChemicalVectorPlain = ChemicalVectorBase<typename V::PlainObject, typename T::PlainObject, typename P::PlainObject, typename N::PlainObject>;
+
 /// A template base class to represent a vector of chemical scalars and their partial derivatives.
 /// @see ThermoScalar, ThermoVector, ChemicalScalar, ChemicalVector
 template<typename V, typename T, typename P, typename N>
@@ -504,9 +517,9 @@ auto operator%(const ChemicalVectorBase<VL,TL,PL,NL>& l, const Vector& r) -> dec
 }
 
 template<typename VL, typename TL, typename PL, typename NL, typename VR, typename TR, typename PR, typename NR>
-auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ChemicalVectorBase<VR,TR,PR,NR>& r) -> ChemicalVector
+auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ChemicalVectorBase<VR,TR,PR,NR>& r) -> ChemicalVectorPlain<VL,TL,PL,NL>
 {
-    const Vector tmp = 1.0/(r.val % r.val);
+    const typename VL::PlainObject tmp = 1.0/(r.val % r.val);
     return {l.val/r.val,
             diag(tmp) * (diag(r.val) * l.ddT - diag(l.val) * r.ddT),
             diag(tmp) * (diag(r.val) * l.ddP - diag(l.val) * r.ddP),
@@ -514,9 +527,9 @@ auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ChemicalVectorBas
 }
 
 template<typename VL, typename TL, typename PL, typename NL, typename VR, typename TR, typename PR, typename NR>
-auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ThermoVectorBase<VR,TR,PR>& r) -> ChemicalVector
+auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ThermoVectorBase<VR,TR,PR>& r) -> ChemicalVectorPlain<VL,TL,PL,NL>
 {
-    const Vector tmp = 1.0/(r.val % r.val);
+    const typename VL::PlainObject tmp = 1.0/(r.val % r.val);
     return {l.val/r.val,
             diag(tmp) * (diag(r.val) * l.ddT - diag(l.val) * r.ddT),
             diag(tmp) * (diag(r.val) * l.ddP - diag(l.val) * r.ddP),
@@ -524,7 +537,7 @@ auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ThermoVectorBase<
 }
 
 template<typename VL, typename TL, typename PL, typename NL, typename VR, typename NR>
-auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ChemicalScalarBase<VR,NR>& r) -> ChemicalVector
+auto operator/(const ChemicalVectorBase<VL,TL,PL,NL>& l, const ChemicalScalarBase<VR,NR>& r) -> ChemicalVectorPlain<VL,TL,PL,NL>
 {
     const double tmp = 1.0/(r.val * r.val);
     return {l.val/r.val,
@@ -696,41 +709,41 @@ auto rows(const ChemicalVectorBase<V,T,P,N>& vec, const Indices& irows, const In
 }
 
 template<typename V, typename T, typename P, typename N>
-auto abs(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVector
+auto abs(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVectorPlain<V,T,P,N>
 {
-    const Vector tmp1 = abs(l.val);
-    const Vector tmp2 = l.val/tmp1;
+    const typename V::PlainObject tmp1 = abs(l.val);
+    const typename V::PlainObject tmp2 = l.val/tmp1;
     return {tmp1, diag(tmp2) * l.ddT, diag(tmp2) * l.ddP, diag(tmp2) * l.ddn};
 }
 
 template<typename V, typename T, typename P, typename N>
-auto sqrt(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVector
+auto sqrt(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVectorPlain<V,T,P,N>
 {
-    const Vector tmp1 = sqrt(l.val);
-    const Vector tmp2 = 0.5 * tmp1/l.val;
+    const typename V::PlainObject tmp1 = sqrt(l.val);
+    const typename V::PlainObject tmp2 = 0.5 * tmp1/l.val;
     return {tmp1, diag(tmp2) * l.ddT, diag(tmp2) * l.ddP, diag(tmp2) * l.ddn};
 }
 
 template<typename V, typename T, typename P, typename N>
-auto pow(const ChemicalVectorBase<V,T,P,N>& l, double power) -> ChemicalVector
+auto pow(const ChemicalVectorBase<V,T,P,N>& l, double power) -> ChemicalVectorPlain<V,T,P,N>
 {
-    const Vector tmp1 = pow(l.val, power);
-    const Vector tmp2 = power * tmp1/l.val;
+    const typename V::PlainObject tmp1 = pow(l.val, power);
+    const typename V::PlainObject tmp2 = power * tmp1/l.val;
     return {tmp1, diag(tmp2) * l.ddT, diag(tmp2) * l.ddP, diag(tmp2) * l.ddn};
 }
 
 template<typename V, typename T, typename P, typename N>
-auto exp(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVector
+auto exp(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVectorPlain<V,T,P,N>
 {
-    const Vector tmp = exp(l.val);
+    const typename V::PlainObject tmp = exp(l.val);
     return {tmp, diag(tmp) * l.ddT, diag(tmp) * l.ddP, diag(tmp) * l.ddn};
 }
 
 template<typename V, typename T, typename P, typename N>
-auto log(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVector
+auto log(const ChemicalVectorBase<V,T,P,N>& l) -> ChemicalVectorPlain<V,T,P,N>
 {
-    const Vector tmp1 = log(l.val);
-    const Vector tmp2 = 1.0/l.val;
+    const typename V::PlainObject tmp1 = log(l.val);
+    const typename V::PlainObject tmp2 = 1.0/l.val;
     return {tmp1, diag(tmp2) * l.ddT, diag(tmp2) * l.ddP, diag(tmp2) * l.ddn};
 }
 
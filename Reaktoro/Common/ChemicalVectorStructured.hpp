@@ -0,0 +1,115 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/ChemicalScalar.hpp>
+#include <Reaktoro/Common/ChemicalVector.hpp>
+#include <Reaktoro/Common/Index.hpp>
+#include <Reaktoro/Common/ThermoVector.hpp>
+#include <Reaktoro/Math/Matrix.hpp>
+
+namespace Reaktoro {
+
+/// A type that represents a chemical vector whose mole derivatives are a diagonal plus a rank-one matrix.
+/// The molar fractions and the molalities of the species in a phase depend only on the
+/// mole amounts of the species, and their mole derivatives have the form
+/// `diag(d) + u*tr(v)`. This type stores only the vectors `d`, `u`, and `v`, so that
+/// the dense matrix of mole derivatives is only assembled when converted to a ChemicalVector.
+/// @see ChemicalVector
+class ChemicalVectorStructured
+{
+public:
+    /// The values of the chemical vector.
+    Vector val;
+
+    /// The diagonal part of the mole derivatives of the chemical vector.
+    Vector d;
+
+    /// The left vector of the rank-one part of the mole derivatives of the chemical vector.
+    Vector u;
+
+    /// The right vector of the rank-one part of the mole derivatives of the chemical vector.
+    Vector v;
+
+    /// Construct a default ChemicalVectorStructured instance.
+    ChemicalVectorStructured()
+    {}
+
+    /// Construct a ChemicalVectorStructured instance with zero values and derivatives.
+    /// @param nspecies The number of species
+    explicit ChemicalVectorStructured(Index nspecies)
+    : val(zeros(nspecies)), d(zeros(nspecies)), u(zeros(nspecies)), v(zeros(nspecies)) {}
+
+    /// Return the number of rows of the chemical vector.
+    auto size() const -> Index
+    {
+        return val.size();
+    }
+
+    /// Return the mole derivatives of the chemical vector as a dense matrix.
+    auto ddn() const -> Matrix
+    {
+        Matrix res = u * tr(v);
+        res.diagonal() += d;
+        return res;
+    }
+
+    /// Return a chemical scalar with the value and the mole derivatives of a row of this chemical vector.
+    auto operator[](Index irow) const -> ChemicalScalar
+    {
+        ChemicalScalar res(size());
+        res.val = val[irow];
+        res.ddn = u[irow] * v;
+        res.ddn[irow] += d[irow];
+        return res;
+    }
+
+    /// Convert this ChemicalVectorStructured instance into a ChemicalVector instance with dense mole derivatives.
+    explicit operator ChemicalVector() const
+    {
+        const Index nspecies = size();
+        ChemicalVector res(nspecies, nspecies);
+        res.val = val;
+        res.ddn = ddn();
+        return res;
+    }
+};
+
+/// Return the dot product of a vector of constant weights and a ChemicalVectorStructured instance.
+/// The mole derivatives of the result are `d % w + v*dot(u, w)`, computed without forming the dense matrix.
+inline auto dot(const Vector& w, const ChemicalVectorStructured& x) -> ChemicalScalar
+{
+    ChemicalScalar res(x.size());
+    res.val = dot(w, x.val);
+    res.ddn = diag(x.d) * w + x.v * dot(x.u, w);
+    return res;
+}
+
+/// Return the dot product of a ThermoVector instance and a ChemicalVectorStructured instance.
+/// This is the structured counterpart of `sum(x % t)`, used for the molar properties of a phase.
+template<typename VR, typename TR, typename PR>
+auto dot(const ThermoVectorBase<VR,TR,PR>& t, const ChemicalVectorStructured& x) -> ChemicalScalar
+{
+    ChemicalScalar res = dot(t.val, x);
+    res.ddT = dot(t.ddT, x.val);
+    res.ddP = dot(t.ddP, x.val);
+    return res;
+}
+
+} // namespace Reaktoro
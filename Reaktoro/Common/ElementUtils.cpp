@@ -19,13 +19,9 @@
 
 // C++ includes
 #include <algorithm>
-#include <cassert>
-#include <map>
-#include <stdexcept>
+#include <mutex>
 #include <string>
-using std::string;
-using std::map;
-using std::pair;
+#include <unordered_map>
 
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
@@ -33,123 +29,198 @@ using std::pair;
 namespace Reaktoro {
 namespace internal {
 
-/// The list of all known chemical elements
-const std::vector<std::string> elements =
-{
-    "H",  "He", "Li", "Be", "B",   "C",   "N",   "O",   "F",   "Ne",  "Na",  "Mg", "Al", "Si", "P",
-    "S",  "Cl", "Ar", "K",  "Ca",  "Sc",  "Ti",  "V",   "Cr",  "Mn",  "Fe",  "Co", "Ni", "Cu", "Zn",
-    "Ga", "Ge", "As", "Se", "Br",  "Kr",  "Rb",  "Sr",  "Y",   "Zr",  "Nb",  "Mo", "Tc", "Ru", "Rh",
-    "Pd", "Ag", "Cd", "In", "Sn",  "Sb",  "Te",  "I",   "Xe",  "Cs",  "Ba",  "La", "Ce", "Pr", "Nd",
-    "Pm", "Sm", "Eu", "Gd", "Tb",  "Dy",  "Ho",  "Er",  "Tm",  "Yb",  "Lu",  "Hf", "Ta", "W",  "Re",
-    "Os", "Ir", "Pt", "Au", "Hg",  "Tl",  "Pb",  "Bi",  "Po",  "At",  "Rn",  "Fr", "Ra", "Ac", "Th",
-    "Pa", "U",  "Np", "Pu", "Am",  "Cm",  "Bk",  "Cf",  "Es",  "Fm",  "Md",  "No", "Lr", "Rf", "Db",
-    "Sg", "Hs", "Bh", "Mt", "Uun", "Uuu", "Uub", "Uut", "Uuq", "Uup", "Uuh"
+/// The symbol and atomic weight (in units of g/mol) of a chemical element
+struct ElementEntry
+{
+    const char* symbol;
+    double weight;
 };
 
-/// The atomic weights of all known chemical elements (in units of g/mol)
-const std::map<std::string, double> atomicWeights =
-{
-      {"H",   1.00794},    {"He",  4.002602}, {"Li",  6.941},     {"Be",  9.012182},  {"B",  10.811},    {"C",   12.0107}, {"N",   14.0067},   {"O",   15.9994},
-      {"F",   18.9984032}, {"Ne",  20.1797},  {"Na",  22.98977},  {"Mg",  24.305},    {"Al", 26.981538}, {"Si",  28.0855}, {"P",   30.973761}, {"S",   32.065},
-      {"Cl",  35.453},     {"Ar",  39.948},   {"K",   39.0983},   {"Ca",  40.078},    {"Sc", 44.95591},  {"Ti",  47.867},  {"V",   50.9415},   {"Cr",  51.9961},
-      {"Mn",  54.938049},  {"Fe",  55.845},   {"Co",  58.9332},   {"Ni",  58.6934},   {"Cu", 63.546},    {"Zn",  65.409},  {"Ga",  69.723},    {"Ge",  72.64},
-      {"As",  74.9216},    {"Se",  78.96},    {"Br",  79.904},    {"Kr",  83.798},    {"Rb", 85.4678},   {"Sr",  87.62},   {"Y",   88.90585},  {"Zr",  91.224},
-      {"Nb",  92.90638},   {"Mo",  95.94},    {"Tc",  98.0},      {"Ru",  101.07},    {"Rh", 102.9055},  {"Pd",  106.42},  {"Ag",  107.8682},  {"Cd",  112.411},
-      {"In",  114.818},    {"Sn",  118.71},   {"Sb",  121.76},    {"Te",  127.6},     {"I",  126.90447}, {"Xe",  131.293}, {"Cs",  132.90545}, {"Ba",  137.327},
-      {"La",  138.9055},   {"Ce",  140.116},  {"Pr",  140.90765}, {"Nd",  144.24},    {"Pm", 145.0},     {"Sm",  150.36},  {"Eu",  151.964},   {"Gd",  157.25},
-      {"Tb",  158.92534},  {"Dy",  162.5},    {"Ho",  164.93032}, {"Er",  167.259},   {"Tm", 168.93421}, {"Yb",  173.04},  {"Lu",  174.967},   {"Hf",  178.49},
-      {"Ta",  180.9479},   {"W",   183.84},   {"Re",  186.207},   {"Os",  190.23},    {"Ir", 192.217},   {"Pt",  195.078}, {"Au",  196.96655}, {"Hg",  200.59},
-      {"Tl",  204.3833},   {"Pb",  207.2},    {"Bi",  208.98038}, {"Po",  209.0},     {"At", 210.0},     {"Rn",  222.0},   {"Fr",  223.0},     {"Ra",  226.0},
-      {"Ac",  227.0},      {"Th",  232.0381}, {"Pa",  231.03588}, {"U",   238.02891}, {"Np", 237.0},     {"Pu",  244.0},   {"Am",  243.0},     {"Cm",  247.0},
-      {"Bk",  247.0},      {"Cf",  251.0},    {"Es",  252.0},     {"Fm",  257.0},     {"Md", 258.0},     {"No",  259.0},   {"Lr",  262.0},     {"Rf",  261.0},
-      {"Db",  262.0},      {"Sg",  266.0},    {"Hs",  264.0},     {"Bh",  277.0},     {"Mt", 268.0},     {"Uun", 281.0},   {"Uuu", 272.0},     {"Uub", 285.0},
-      {"Uut", 284.0},      {"Uuq", 289.0},    {"Uup", 288.0},     {"Uuh", 292.0}
+/// The table of all known chemical elements, whose positions are their identifiers
+const ElementEntry element_table[] =
+{
+    {"H",   1.00794},    {"He",  4.002602}, {"Li",  6.941},     {"Be",  9.012182},  {"B",   10.811},    {"C",   12.0107},   {"N",   14.0067},   {"O",   15.9994},
+    {"F",   18.9984032}, {"Ne",  20.1797},  {"Na",  22.98977},  {"Mg",  24.305},    {"Al",  26.981538}, {"Si",  28.0855},   {"P",   30.973761}, {"S",   32.065},
+    {"Cl",  35.453},     {"Ar",  39.948},   {"K",   39.0983},   {"Ca",  40.078},    {"Sc",  44.95591},  {"Ti",  47.867},    {"V",   50.9415},   {"Cr",  51.9961},
+    {"Mn",  54.938049},  {"Fe",  55.845},   {"Co",  58.9332},   {"Ni",  58.6934},   {"Cu",  63.546},    {"Zn",  65.409},    {"Ga",  69.723},    {"Ge",  72.64},
+    {"As",  74.9216},    {"Se",  78.96},    {"Br",  79.904},    {"Kr",  83.798},    {"Rb",  85.4678},   {"Sr",  87.62},     {"Y",   88.90585},  {"Zr",  91.224},
+    {"Nb",  92.90638},   {"Mo",  95.94},    {"Tc",  98.0},      {"Ru",  101.07},    {"Rh",  102.9055},  {"Pd",  106.42},    {"Ag",  107.8682},  {"Cd",  112.411},
+    {"In",  114.818},    {"Sn",  118.71},   {"Sb",  121.76},    {"Te",  127.6},     {"I",   126.90447}, {"Xe",  131.293},   {"Cs",  132.90545}, {"Ba",  137.327},
+    {"La",  138.9055},   {"Ce",  140.116},  {"Pr",  140.90765}, {"Nd",  144.24},    {"Pm",  145.0},     {"Sm",  150.36},    {"Eu",  151.964},   {"Gd",  157.25},
+    {"Tb",  158.92534},  {"Dy",  162.5},    {"Ho",  164.93032}, {"Er",  167.259},   {"Tm",  168.93421}, {"Yb",  173.04},    {"Lu",  174.967},   {"Hf",  178.49},
+    {"Ta",  180.9479},   {"W",   183.84},   {"Re",  186.207},   {"Os",  190.23},    {"Ir",  192.217},   {"Pt",  195.078},   {"Au",  196.96655}, {"Hg",  200.59},
+    {"Tl",  204.3833},   {"Pb",  207.2},    {"Bi",  208.98038}, {"Po",  209.0},     {"At",  210.0},     {"Rn",  222.0},     {"Fr",  223.0},     {"Ra",  226.0},
+    {"Ac",  227.0},      {"Th",  232.0381}, {"Pa",  231.03588}, {"U",   238.02891}, {"Np",  237.0},     {"Pu",  244.0},     {"Am",  243.0},     {"Cm",  247.0},
+    {"Bk",  247.0},      {"Cf",  251.0},    {"Es",  252.0},     {"Fm",  257.0},     {"Md",  258.0},     {"No",  259.0},     {"Lr",  262.0},     {"Rf",  261.0},
+    {"Db",  262.0},      {"Sg",  266.0},    {"Hs",  264.0},     {"Bh",  277.0},     {"Mt",  268.0},     {"Uun", 281.0},     {"Uuu", 272.0},     {"Uub", 285.0},
+    {"Uut", 284.0},      {"Uuq", 289.0},    {"Uup", 288.0},     {"Uuh", 292.0}
 };
 
-auto parseElementAtom(string::iterator begin, string::iterator end) -> pair<string, string::iterator>
+/// The number of known chemical elements
+const Index num_known_elements = sizeof(element_table)/sizeof(ElementEntry);
+
+/// Return true if a character is an uppercase letter
+inline auto isUpper(char c) -> bool
 {
-    assert(isupper(*begin) && "***Error*** `parseElementAtom` requires the first character to be uppercase.");
-    if(begin == end) return {"", begin};
-    auto endelement = std::find_if(begin + 1, end, [](char c){return isupper(c) || !isalpha(c);});
-    string element = string(begin, endelement);
-    return {element, endelement};
+    return c >= 'A' && c <= 'Z';
 }
 
-auto parseNumAtoms(string::iterator begin, string::iterator end) -> pair<double, string::iterator>
+/// Return true if a character is a lowercase letter
+inline auto isLower(char c) -> bool
 {
-    if(begin == end) return {1.0, begin};
-    if(!isdigit(*begin)) return {1.0, begin};
-    auto endnumber = std::find_if(begin, end, [](char c){return !isdigit(c);});
-    double number = atof(string(begin, endnumber).c_str());
-    return {number, endnumber};
+    return c >= 'a' && c <= 'z';
 }
 
-auto findMatchedParenthesis(string::iterator begin, string::iterator end) -> string::iterator
+/// Return true if a character is a decimal digit
+inline auto isDigit(char c) -> bool
 {
-    if(begin == end) return end;
-    int level = 0;
-    for(auto iter = begin+1; iter < end; ++iter)
-    {
-        level = (*iter == '(') ? level + 1 : level;
-        level = (*iter == ')') ? level - 1 : level;
-        if(*iter == ')' && level == -1)
-            return iter;
-    }
-    return end;
+    return c >= '0' && c <= '9';
 }
 
-auto parseFormula(string::iterator begin, string::iterator end, map<string, double>& result, double scalar) -> void
-{
-    if(begin == end) return;
+/// The value in the lookup table of element symbols that denotes an unknown symbol
+const Index unknown_symbol = -1;
 
-    if(*begin != '(' && *begin != '.' && !isupper(*begin))
+/// The identifiers of the known elements with one- or two-letter symbols.
+/// The entry `[i][0]` corresponds to the symbol with the `i`-th uppercase letter
+/// only, and the entry `[i][j]` to the one followed by the `j`-th lowercase letter.
+const std::vector<std::vector<Index>> element_lookup = []()
+{
+    std::vector<std::vector<Index>> lookup(26, std::vector<Index>(27, unknown_symbol));
+    for(Index i = 0; i < num_known_elements; ++i)
     {
-        parseFormula(begin + 1, end, result, scalar);
+        const std::string symbol = element_table[i].symbol;
+        if(symbol.size() == 1) lookup[symbol[0] - 'A'][0] = i;
+        if(symbol.size() == 2) lookup[symbol[0] - 'A'][symbol[1] - 'a' + 1] = i;
     }
-    else if(*begin == '(')
-    {
-        string::iterator begin1 = begin + 1;
-        string::iterator end1   = findMatchedParenthesis(begin, end);
-
-        auto res = parseNumAtoms(end1 + 1, end);
-
-        const double number = res.first;
+    return lookup;
+}();
 
-        string::iterator begin2 = res.second;
-        string::iterator end2   = end;
+/// Return the identifier of a known element symbol given by a range of characters, or `unknown_symbol` otherwise
+auto knownElementId(const char* begin, const char* end) -> Index
+{
+    if(end - begin == 1 && isUpper(begin[0]))
+        return element_lookup[begin[0] - 'A'][0];
+    if(end - begin == 2 && isUpper(begin[0]) && isLower(begin[1]))
+        return element_lookup[begin[0] - 'A'][begin[1] - 'a' + 1];
+    for(Index i = 0; i < num_known_elements; ++i)
+        if(std::equal(begin, end, element_table[i].symbol) && element_table[i].symbol[end - begin] == '\0')
+            return i;
+    return unknown_symbol;
+}
 
-        parseFormula(begin1, end1, result, scalar * number);
-        parseFormula(begin2, end2, result, scalar);
-    }
-    else if(*begin == '.')
-    {
-        auto res = parseNumAtoms(begin + 1, end);
+/// The registry of element symbols that are not in the table of known elements
+struct ElementRegistry
+{
+    /// The registered symbols, whose identifiers are their positions plus the number of known elements
+    std::vector<std::string> symbols;
 
-        const double number = res.first;
+    /// The identifiers of the registered symbols
+    std::unordered_map<std::string, Index> ids;
 
-        string::iterator begin1 = res.second;
-        string::iterator end1   = end;
+    /// The mutex that guards the registration of new symbols
+    std::mutex mutex;
+};
 
-        parseFormula(begin1, end1, result, scalar * number);
-    }
-    else
-    {
-        auto res1 = parseElementAtom(begin, end);
-        auto res2 = parseNumAtoms(res1.second, end);
+/// Return the registry of element symbols that are not in the table of known elements
+auto registry() -> ElementRegistry&
+{
+    static ElementRegistry instance;
+    return instance;
+}
 
-        string element = res1.first;
-        double natoms  = res2.first;
+/// Return the identifier of an element symbol given by a range of characters
+auto elementId(const char* begin, const char* end) -> Index
+{
+    // Search the table of known elements without allocating memory
+    const Index id = knownElementId(begin, end);
+    if(id != unknown_symbol)
+        return id;
+
+    // Otherwise, find or register the symbol in the registry of other elements
+    ElementRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const std::string symbol(begin, end);
+    const auto iter = reg.ids.find(symbol);
+    if(iter != reg.ids.end())
+        return iter->second;
+    const Index newid = num_known_elements + reg.symbols.size();
+    reg.symbols.push_back(symbol);
+    reg.ids.emplace(symbol, newid);
+    return newid;
+}
 
-        if(result.count(element)) result[element] += scalar * natoms;
-        else result[element] = scalar * natoms;
+/// Return the position of the number of atoms that follows a given position in a formula and its value
+auto parseNumAtoms(const char* begin, const char* end, double& number) -> const char*
+{
+    number = 1.0;
+    if(begin == end || !isDigit(*begin)) return begin;
+    double value = 0.0;
+    for(; begin != end && isDigit(*begin); ++begin)
+        value = 10.0*value + (*begin - '0');
+    number = value;
+    return begin;
+}
 
-        string::iterator begin1 = res2.second;
-        string::iterator end1   = end;
+/// Return the position of the parenthesis that closes the one at a given position in a formula
+auto findMatchedParenthesis(const char* begin, const char* end) -> const char*
+{
+    int level = 0;
+    for(const char* iter = begin + 1; iter < end; ++iter)
+    {
+        level = (*iter == '(') ? level + 1 : level;
+        level = (*iter == ')') ? level - 1 : level;
+        if(*iter == ')' && level == -1)
+            return iter;
+    }
+    return end;
+}
 
-        parseFormula(begin1, end1, result, scalar);
+/// Parse the elements in a range of a chemical formula and append them with their coefficients to a composition.
+/// A group in parentheses is scaled by the number that follows it, a dot followed by a number scales the rest
+/// of the enclosing group (e.g., the water of hydration in `CaSO4.2H2O`), and other characters are skipped.
+/// An error is raised if a parenthesis is opened but not closed.
+auto parseFormula(const char* begin, const char* end, ElementComposition& result, double scalar) -> void
+{
+    while(begin != end)
+    {
+        if(*begin == '(')
+        {
+            const char* end1 = findMatchedParenthesis(begin, end);
+            Assert(end1 != end, "Cannot parse the chemical formula.",
+                "The parenthesis in `" + std::string(begin, end) + "` is not closed.");
+            double number = 1.0;
+            const char* next = parseNumAtoms(end1 + 1, end, number);
+            parseFormula(begin + 1, end1, result, scalar * number);
+            begin = next;
+        }
+        else if(*begin == '.')
+        {
+            double number = 1.0;
+            begin = parseNumAtoms(begin + 1, end, number);
+            scalar *= number;
+        }
+        else if(isUpper(*begin))
+        {
+            const char* endelement = std::find_if(begin + 1, end, [](char c) { return isUpper(c) || !isLower(c); });
+            const Index id = elementId(begin, endelement);
+            double natoms = 1.0;
+            begin = parseNumAtoms(endelement, end, natoms);
+            result.emplace_back(id, scalar * natoms);
+        }
+        else ++begin;
     }
 }
 
+/// The list of the symbols of all known chemical elements
+const std::vector<std::string> elements = []()
+{
+    std::vector<std::string> symbols;
+    symbols.reserve(num_known_elements);
+    for(const ElementEntry& entry : element_table)
+        symbols.push_back(entry.symbol);
+    return symbols;
+}();
+
 } // namespace internal
 
 auto elements() -> std::vector<std::string>
@@ -159,17 +230,55 @@ auto elements() -> std::vector<std::string>
 
 auto elements(std::string formula) -> std::map<std::string, double>
 {
+    ElementComposition composition;
+    elementComposition(formula, composition);
+
     std::map<std::string, double> result;
+    for(const auto& pair : composition)
+        result.emplace(elementSymbol(pair.first), pair.second);
+    return result;
+}
 
-    internal::parseFormula(formula.begin(), formula.end(), result, 1.0);
+auto elementId(const std::string& symbol) -> Index
+{
+    return internal::elementId(symbol.data(), symbol.data() + symbol.size());
+}
 
-    return result;
+auto elementSymbol(Index id) -> std::string
+{
+    if(id < internal::num_known_elements)
+        return internal::element_table[id].symbol;
+    internal::ElementRegistry& reg = internal::registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    Assert(id - internal::num_known_elements < reg.symbols.size(),
+        "Cannot get the symbol of the chemical element.",
+        "The element identifier " + std::to_string(id) + " is not registered.");
+    return reg.symbols[id - internal::num_known_elements];
+}
+
+auto elementComposition(const std::string& formula, ElementComposition& result) -> void
+{
+    // Collect the elements in the order they appear in the formula
+    result.clear();
+    internal::parseFormula(formula.data(), formula.data() + formula.size(), result, 1.0);
+
+    // Sort the elements by identifier and merge repeated elements
+    std::sort(result.begin(), result.end(),
+        [](const std::pair<Index, double>& l, const std::pair<Index, double>& r) { return l.first < r.first; });
+    Index count = 0;
+    for(Index i = 0; i < result.size(); ++i)
+    {
+        if(count > 0 && result[count - 1].first == result[i].first)
+            result[count - 1].second += result[i].second;
+        else result[count++] = result[i];
+    }
+    result.resize(count);
 }
 
 auto atomicMass(std::string element) -> double
 {
-    auto entry = internal::atomicWeights.find(element);
-    if(entry == internal::atomicWeights.end())
+    const Index id = elementId(element);
+    if(id >= internal::num_known_elements)
     {
         Exception exception;
         exception.error << "Cannot calculate the atomic mass of the provided chemical element.";
@@ -177,7 +286,7 @@ auto atomicMass(std::string element) -> double
         RaiseError(exception);
     }
     const auto gram_to_kilogram = 0.001;
-    const auto atomic_mass = entry->second;
+    const auto atomic_mass = internal::element_table[id].weight;
     return atomic_mass * gram_to_kilogram;
 }
 
@@ -189,9 +298,23 @@ auto molarMass(const std::map<std::string, double>& elements) -> double
     return molar_mass;
 }
 
+auto molarMass(const ElementComposition& compound) -> double
+{
+    double molar_mass = 0.0;
+    for(const auto& pair : compound)
+    {
+        if(pair.first >= internal::num_known_elements)
+            atomicMass(elementSymbol(pair.first)); // raise the error of an unknown element
+        molar_mass += pair.second * (internal::element_table[pair.first].weight * 0.001);
+    }
+    return molar_mass;
+}
+
 auto molarMass(std::string formula) -> double
 {
-    return molarMass(elements(formula));
+    ElementComposition composition;
+    elementComposition(formula, composition);
+    return molarMass(composition);
 }
 
 auto charge(const std::string& formula) -> double
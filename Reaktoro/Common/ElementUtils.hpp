@@ -22,8 +22,16 @@
 #include <vector>
 #include <map>
 
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+
 namespace Reaktoro {
 
+/// The elemental composition of a chemical compound as pairs of element identifiers and coefficients.
+/// The pairs are sorted in ascending order of element identifiers, without repetitions.
+/// @see elementId, elementSymbol, elementComposition
+using ElementComposition = std::vector<std::pair<Index, double>>;
+
 /// Return a vector of all known 116 chemical elements.
 auto elements() -> std::vector<std::string>;
 
@@ -32,6 +40,24 @@ auto elements() -> std::vector<std::string>;
 /// @return The elemental composition of the chemical compound
 auto elements(std::string formula) -> std::map<std::string, double>;
 
+/// Return the identifier of a chemical element.
+/// The identifier of a known element is its index in the list returned by @ref elements().
+/// An unknown symbol is registered on its first use and given an identifier
+/// greater than or equal to the number of known elements.
+/// @param symbol The symbol of the chemical element
+auto elementId(const std::string& symbol) -> Index;
+
+/// Return the symbol of a chemical element with given identifier.
+/// @param id The identifier of the chemical element returned by @ref elementId
+auto elementSymbol(Index id) -> std::string;
+
+/// Determine the elemental composition of a chemical compound.
+/// This method parses the formula in a single pass and reuses the memory of `result`,
+/// so that repeated calls with the same container do not allocate memory.
+/// @param formula The formula of the chemical compound
+/// @param[out] result The elemental composition of the chemical compound
+auto elementComposition(const std::string& formula, ElementComposition& result) -> void;
+
 /// Return the atomic mass of a chemical element (in units of kg/mol).
 /// @param element The symbol of the chemical element
 /// @return The atomic mass of the chemical element
@@ -42,6 +68,11 @@ auto atomicMass(std::string element) -> double;
 /// @return The molar mass of the chemical compound
 auto molarMass(const std::map<std::string, double>& compound) -> double;
 
+/// Calculate the molar mass of a chemical compound (in units of kg/mol).
+/// @param compound The elemental composition of the chemical compound
+/// @return The molar mass of the chemical compound
+auto molarMass(const ElementComposition& compound) -> double;
+
 /// Calculate the molar mass of a chemical compound (in units of kg/mol).
 /// @param compound The formula of the chemical compound
 /// @return The molar mass of the chemical compound
@@ -81,15 +81,28 @@ auto interpolate(
 
     std::vector<BilinearInterpolator> val(size), ddT(size), ddP(size);
 
+    // The values of a function at the interpolation points, with the
+    // temperature varying fastest as expected by BilinearInterpolator
+    const unsigned npoints = temperatures.size() * pressures.size();
+    std::vector<double> vals(npoints), ddTs(npoints), ddPs(npoints);
+
     for(unsigned i = 0; i < size; ++i)
     {
-        auto val_func = [=](double T, double P) { return fs[i](T, P).val; };
-        auto ddT_func = [=](double T, double P) { return fs[i](T, P).ddT; };
-        auto ddP_func = [=](double T, double P) { return fs[i](T, P).ddP; };
-
-        val[i] = BilinearInterpolator(temperatures, pressures, val_func);
-        ddT[i] = BilinearInterpolator(temperatures, pressures, ddT_func);
-        ddP[i] = BilinearInterpolator(temperatures, pressures, ddP_func);
+        // Evaluate each function only once per interpolation point
+        unsigned k = 0;
+        for(double P : pressures)
+            for(double T : temperatures)
+            {
+                const ThermoScalar f = fs[i](T, P);
+                vals[k] = f.val;
+                ddTs[k] = f.ddT;
+                ddPs[k] = f.ddP;
+                ++k;
+            }
+
+        val[i] = BilinearInterpolator(temperatures, pressures, vals);
+        ddT[i] = BilinearInterpolator(temperatures, pressures, ddTs);
+        ddP[i] = BilinearInterpolator(temperatures, pressures, ddPs);
     }
 
     ThermoVector res(size);
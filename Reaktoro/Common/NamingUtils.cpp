@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <map>
+#include <mutex>
 #include <cctype>
 
 // Reaktoro includes
@@ -37,6 +38,10 @@ std::map<std::pair<std::string, double>, std::vector<std::string>> alternative_c
 /// The map with alternative names for neutral species
 std::map<std::string, std::vector<std::string>> alternative_neutral_names;
 
+/// The mutex that guards the insertion of alternative names in the maps above,
+/// so that species can be looked up by alternative names from several threads
+std::mutex alternative_names_mutex;
+
 } // namespace
 
 auto alternativeWaterNames() -> std::vector<std::string>&
@@ -66,6 +71,7 @@ auto alternativeChargedSpeciesNames(std::string name) -> std::vector<std::string
     alternatives.push_back(base + sign_charge);                   // e.g.: Ca+2
     alternatives.push_back(base + "[" + charge_sign + "]");       // e.g.: Ca[2+]
 
+    std::lock_guard<std::mutex> lock(alternative_names_mutex);
     auto res = alternative_charged_names.insert({{base, charge}, unique(alternatives)});
 
     return res.first->second; // return the iterator to the existing or just added alternative names
@@ -82,6 +88,7 @@ auto alternativeNeutralSpeciesNames(std::string name) -> std::vector<std::string
     alternatives.push_back(base + "@");    // e.g.: CO2@
     alternatives.push_back(base + ",aq");  // e.g.: CO2,aq
 
+    std::lock_guard<std::mutex> lock(alternative_names_mutex);
     auto res = alternative_neutral_names.insert({base, unique(alternatives)});
 
     return res.first->second; // return the iterator to the existing or just added alternative names
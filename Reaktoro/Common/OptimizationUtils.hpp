@@ -18,23 +18,35 @@
 #pragma once
 
 // C++ includes
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
 #include <tuple>
+#include <unordered_map>
 
 namespace Reaktoro {
 
 template <typename Ret, typename... Args>
 auto memoize(std::function<Ret(Args...)> f) -> std::function<Ret(Args...)>
 {
-    auto cache = std::make_shared<std::map<std::tuple<Args...>, Ret>>();
-    return [=](Args... args) mutable -> Ret
+    using Cache = std::map<std::tuple<typename std::decay<Args>::type...>, Ret>;
+
+    // The memoized functions may be shared among threads (e.g., by ChemicalSolver threads),
+    // so that every thread keeps its own caches, identified by a never reused number
+    static std::atomic<std::size_t> counter(0);
+    const std::size_t id = counter++;
+
+    return [=](Args... args) -> Ret
     {
-        std::tuple<Args...> t(args...);
-        if(cache->find(t) == cache->end())
-            (*cache)[t] = f(args...);
-        return (*cache)[t];
+        thread_local std::unordered_map<std::size_t, Cache> caches;
+        Cache& cache = caches[id];
+        auto key = std::make_tuple(args...);
+        auto iter = cache.find(key);
+        if(iter == cache.end())
+            iter = cache.emplace(std::move(key), f(args...)).first;
+        return iter->second;
     };
 }
 
@@ -0,0 +1,95 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "Profiling.hpp"
+
+// C++ includes
+#include <sstream>
+
+namespace Reaktoro {
+
+auto Profiler::record(const std::string& event, double time) -> void
+{
+    ProfilingEntry& entry = m_entries[event];
+    entry.count += 1;
+    entry.time += time;
+}
+
+auto Profiler::count(const std::string& event, unsigned long count) -> void
+{
+    m_entries[event].count += count;
+}
+
+auto Profiler::clear() -> void
+{
+    m_entries.clear();
+}
+
+auto Profiler::entry(const std::string& event) const -> ProfilingEntry
+{
+    auto iter = m_entries.find(event);
+    return iter != m_entries.end() ? iter->second : ProfilingEntry();
+}
+
+auto Profiler::entries() const -> const std::map<std::string, ProfilingEntry>&
+{
+    return m_entries;
+}
+
+auto Profiler::json() const -> std::string
+{
+    std::stringstream ss;
+    ss.precision(12);
+    ss << "{";
+    for(auto iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+    {
+        ss << (iter == m_entries.begin() ? "\n" : ",\n");
+        ss << "  \"" << iter->first << "\": ";
+        ss << "{\"count\": " << iter->second.count << ", \"time\": " << iter->second.time << "}";
+    }
+    ss << (m_entries.empty() ? "}" : "\n}");
+    return ss.str();
+}
+
+auto Profiler::operator+=(const Profiler& other) -> Profiler&
+{
+    for(const auto& pair : other.m_entries)
+    {
+        ProfilingEntry& entry = m_entries[pair.first];
+        entry.count += pair.second.count;
+        entry.time += pair.second.time;
+    }
+    return *this;
+}
+
+auto profiler() -> Profiler&
+{
+    static thread_local Profiler instance;
+    return instance;
+}
+
+ScopedTimer::ScopedTimer(std::string event)
+: m_event(std::move(event)), m_begin(time())
+{}
+
+ScopedTimer::~ScopedTimer()
+{
+    profiler().record(m_event, elapsed(m_begin));
+}
+
+} // namespace Reaktoro
@@ -0,0 +1,122 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// C++ includes
+#include <map>
+#include <string>
+
+// Reaktoro includes
+#include <Reaktoro/Common/TimeUtils.hpp>
+
+namespace Reaktoro {
+
+/// A type that stores the accumulated number of occurrences and wall time of a profiled event
+struct ProfilingEntry
+{
+    /// The number of occurrences of the event
+    unsigned long count = 0;
+
+    /// The accumulated wall time spent in the event (in units of s)
+    double time = 0;
+};
+
+/// A type that stores the counters and timers of events recorded during the calculations.
+/// The events are identified by names such as `EquilibriumSolver::solve` or
+/// `KktSolver::decompose`. Each thread records its events in its own Profiler
+/// instance, accessed with function @ref profiler. The recording of events in the
+/// library is only active if Reaktoro is compiled with the `ENABLE_PROFILING` option.
+/// @see profiler, ScopedTimer
+class Profiler
+{
+public:
+    /// Record an occurrence of an event and the wall time spent on it.
+    /// @param event The name of the event
+    /// @param time The wall time spent in the event (in units of s)
+    auto record(const std::string& event, double time) -> void;
+
+    /// Increment the number of occurrences of an event.
+    /// @param event The name of the event
+    /// @param count The number of occurrences to be added
+    auto count(const std::string& event, unsigned long count = 1) -> void;
+
+    /// Remove all recorded events.
+    auto clear() -> void;
+
+    /// Return the counter and timer of an event, which are zero if the event was not recorded.
+    auto entry(const std::string& event) const -> ProfilingEntry;
+
+    /// Return the counters and timers of all recorded events.
+    auto entries() const -> const std::map<std::string, ProfilingEntry>&;
+
+    /// Return the recorded events as a JSON object with entries `"event": {"count": ..., "time": ...}`.
+    auto json() const -> std::string;
+
+    /// Add the counters and timers of another Profiler instance to this one.
+    auto operator+=(const Profiler& other) -> Profiler&;
+
+private:
+    /// The counters and timers of the events
+    std::map<std::string, ProfilingEntry> m_entries;
+};
+
+/// Return the Profiler instance of the current thread.
+auto profiler() -> Profiler&;
+
+/// A type that records the wall time of its lifetime in the Profiler instance of the current thread.
+class ScopedTimer
+{
+public:
+    /// Construct a ScopedTimer instance that starts timing an event.
+    explicit ScopedTimer(std::string event);
+
+    /// Destroy this ScopedTimer instance and record the elapsed time of the event.
+    ~ScopedTimer();
+
+private:
+    /// The name of the timed event
+    std::string m_event;
+
+    /// The time point when the timing started
+    Time m_begin;
+};
+
+} // namespace Reaktoro
+
+#ifdef ENABLE_PROFILING
+
+#define ProfileConcatenate(a, b) a##b
+#define ProfileScopedName(line) ProfileConcatenate(scoped_timer_, line)
+
+/// Define a macro that times the enclosing scope as an occurrence of an event.
+#define ProfileScope(event) \
+    Reaktoro::ScopedTimer ProfileScopedName(__LINE__)(event)
+
+/// Define a macro that increments the number of occurrences of an event.
+#define ProfileCount(event, num) \
+    Reaktoro::profiler().count(event, num)
+
+#else
+
+// The disabled macros expand to a void expression, so that they remain valid
+// statements in any context (e.g., `else ProfileCount(event, 1);`)
+#define ProfileScope(event) ((void)0)
+#define ProfileCount(event, num) ((void)0)
+
+#endif
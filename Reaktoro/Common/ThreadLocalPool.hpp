@@ -0,0 +1,153 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+
+namespace Reaktoro {
+
+/// A pool of objects from which every thread leases an object of its own.
+/// The first call of @ref local in a thread leases an idle object of the pool, or creates a
+/// new one if none is idle, and later calls in the same thread return the same object. The
+/// object is returned to the pool when the thread exits, so that later threads reuse it
+/// instead of creating another one. The threads do not keep the pool alive: the objects
+/// leased from a pool that was destroyed are deleted the next time their thread calls
+/// @ref local on any pool of the same type, or when the thread exits.
+/// @tparam T The type of the objects in the pool
+template<typename T>
+class ThreadLocalPool
+{
+public:
+    /// Construct a ThreadLocalPool instance.
+    /// @param create The function that creates a new object for a thread
+    explicit ThreadLocalPool(std::function<std::unique_ptr<T>()> create)
+    : shared(std::make_shared<Shared>())
+    {
+        shared->create = create;
+    }
+
+    /// Return the object leased by the current thread, leasing one if needed.
+    auto local() -> T&
+    {
+        std::vector<Lease>& leases = threadLeases();
+
+        // Delete the objects leased from pools that no longer exist
+        leases.erase(std::remove_if(leases.begin(), leases.end(),
+            [](const Lease& lease) { return lease.pool.expired(); }), leases.end());
+
+        for(Lease& lease : leases)
+            if(lease.pool.lock() == shared)
+                return *lease.object;
+
+        std::unique_ptr<T> object;
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            if(!shared->idle.empty())
+            {
+                object = std::move(shared->idle.back());
+                shared->idle.pop_back();
+            }
+            else ++shared->created;
+        }
+
+        if(!object)
+            object = shared->create();
+
+        leases.emplace_back(shared, std::move(object));
+
+        return *leases.back().object;
+    }
+
+    /// Return the number of objects created by this pool.
+    auto numCreated() const -> Index
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        return shared->created;
+    }
+
+    /// Return the number of objects of this pool not leased by any thread.
+    auto numIdle() const -> Index
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        return shared->idle.size();
+    }
+
+private:
+    /// The state of the pool shared with the leases of the threads.
+    struct Shared
+    {
+        /// The function that creates a new object for a thread
+        std::function<std::unique_ptr<T>()> create;
+
+        /// The objects not leased by any thread
+        std::vector<std::unique_ptr<T>> idle;
+
+        /// The number of objects created by the pool
+        Index created = 0;
+
+        /// The mutex that protects the idle objects and the number of created objects
+        std::mutex mutex;
+    };
+
+    /// An object leased by a thread, returned to its pool when the lease is destroyed.
+    struct Lease
+    {
+        /// The pool from which the object was leased
+        std::weak_ptr<Shared> pool;
+
+        /// The leased object
+        std::unique_ptr<T> object;
+
+        Lease(const std::shared_ptr<Shared>& pool, std::unique_ptr<T> object)
+        : pool(pool), object(std::move(object))
+        {}
+
+        Lease(Lease&& other) = default;
+
+        auto operator=(Lease&& other) -> Lease& = default;
+
+        ~Lease()
+        {
+            if(!object) return;
+            std::shared_ptr<Shared> owner = pool.lock();
+            if(!owner) return;
+            std::lock_guard<std::mutex> lock(owner->mutex);
+            owner->idle.push_back(std::move(object));
+        }
+    };
+
+    /// Return the leases of the current thread.
+    static auto threadLeases() -> std::vector<Lease>&
+    {
+        thread_local std::vector<Lease> leases;
+        return leases;
+    }
+
+    /// The state of the pool shared with the leases of the threads
+    std::shared_ptr<Shared> shared;
+};
+
+} // namespace Reaktoro
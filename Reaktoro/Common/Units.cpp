@@ -15,6 +15,8 @@
 // You should have received a copy of the GNU General Public License
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
+#include "Units.hpp"
+
 // C++ includes
 #include <algorithm>
 #include <cmath>
@@ -22,8 +24,10 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 using std::endl;
 using std::pow;
@@ -388,20 +392,6 @@ map<string, TemperatureUnit> temperatureUnitsMap =
     {"rankine"    , {1, 0, "degR"}}
 };
 
-double toKelvin(double value, const string& from)
-{
-    if(from == "K") return value;
-    auto unit = temperatureUnitsMap[from];
-    return toKelvin((value - unit.translate)/unit.factor, unit.symbol);
-}
-
-double fromKelvin(double value, const string& to)
-{
-    if(to == "K") return value;
-    auto unit = temperatureUnitsMap[to];
-    return unit.factor * fromKelvin(value, unit.symbol) + unit.translate;
-}
-
 inline void checkTemperatureUnit(const string& symbol)
 {
     if(!temperatureUnitsMap.count(symbol))
@@ -420,14 +410,6 @@ inline void checkDerivedUnit(const string& symbol)
     }
 }
 
-double convertTemperature(double value, const string& from, const string& to)
-{
-    checkTemperatureUnit(from);
-    checkTemperatureUnit(to);
-
-    return fromKelvin(toKelvin(value, from), to);
-}
-
 double factor(const string& symbol)
 {
     if(temperatureUnitsMap.count(symbol)) return 1.0;
@@ -598,16 +580,78 @@ inline void checkConvertibleUnits(const DerivedUnit& from, const DerivedUnit& to
     }
 }
 
+Conversion compileTemperature(const string& from, const string& to)
+{
+    checkTemperatureUnit(from);
+    checkTemperatureUnit(to);
+
+    // Compose the affine maps along the chain of units from `from` to kelvin and from kelvin to `to`
+    Conversion tokelvin, fromkelvin;
+    for(string symbol = from; symbol != "K"; symbol = temperatureUnitsMap[symbol].symbol)
+    {
+        const auto& unit = temperatureUnitsMap[symbol];
+        tokelvin.offset = (tokelvin.offset - unit.translate)/unit.factor;
+        tokelvin.factor = tokelvin.factor/unit.factor;
+    }
+    for(string symbol = to; symbol != "K"; symbol = temperatureUnitsMap[symbol].symbol)
+    {
+        const auto& unit = temperatureUnitsMap[symbol];
+        fromkelvin.offset = fromkelvin.factor * unit.translate + fromkelvin.offset;
+        fromkelvin.factor = fromkelvin.factor * unit.factor;
+    }
+
+    Conversion res;
+    res.factor = fromkelvin.factor * tokelvin.factor;
+    res.offset = fromkelvin.factor * tokelvin.offset + fromkelvin.offset;
+    return res;
+}
+
+Conversion compile(const string& from, const string& to)
+{
+    if(temperatureUnitsMap.count(from) && temperatureUnitsMap.count(to))
+        return compileTemperature(from, to);
+    auto parsed_from = parseUnit(from);
+    auto parsed_to   = parseUnit(to);
+    checkConvertibleUnits(parsed_from, parsed_to, from, to);
+    Conversion res;
+    res.factor = factor(parsed_from)/factor(parsed_to);
+    return res;
+}
+
+/// The cache of compiled conversions, indexed by the units from and to which the conversion is made
+std::unordered_map<string, std::unordered_map<string, Conversion>> conversions;
+
+/// The mutex that protects the cache of compiled conversions
+std::mutex conversions_mutex;
+
+/// Return the compiled conversion in the shared cache, compiling it if needed
+const Conversion& sharedConversion(const string& from, const string& to)
+{
+    std::lock_guard<std::mutex> lock(conversions_mutex);
+    auto& cached = conversions[from];
+    auto iter = cached.find(to);
+    if(iter == cached.end())
+        iter = cached.emplace(to, compile(from, to)).first;
+    return iter->second;
+}
+
 } // namespace internal
 
+const Conversion& conversion(const string& from, const string& to)
+{
+    // The conversions already used by this thread, which point to the entries of the shared
+    // cache (never removed), so that only the first use in each thread locks its mutex
+    thread_local std::unordered_map<string, std::unordered_map<string, const Conversion*>> used;
+    auto& cached = used[from];
+    auto iter = cached.find(to);
+    if(iter == cached.end())
+        iter = cached.emplace(to, &internal::sharedConversion(from, to)).first;
+    return *iter->second;
+}
+
 double convert(double value, const string& from, const string& to)
 {
-    if(internal::temperatureUnitsMap.count(from) && internal::temperatureUnitsMap.count(to))
-        return internal::convertTemperature(value, from, to);
-    auto parsed_from = internal::parseUnit(from);
-    auto parsed_to   = internal::parseUnit(to);
-    internal::checkConvertibleUnits(parsed_from, parsed_to, from, to);
-    return value * internal::factor(parsed_from)/internal::factor(parsed_to);
+    return conversion(from, to)(value);
 }
 
 bool convertible(const std::string& from, const std::string& to)
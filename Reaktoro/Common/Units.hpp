@@ -22,6 +22,30 @@
 
 namespace units {
 
+/// A compiled conversion between two units, defined by `to = factor * from + offset`.
+/// @see conversion
+struct Conversion
+{
+    /// The multiplicative factor of the conversion.
+    double factor = 1.0;
+
+    /// The additive offset of the conversion (non-zero only for temperature units).
+    double offset = 0.0;
+
+    /// Convert a numeric value with this conversion
+    auto operator()(double value) const -> double { return factor * value + offset; }
+};
+
+/// Return the compiled conversion from a unit to another.
+/// The unit strings are parsed only in the first call for a given pair of units.
+/// The resulting conversion is then stored in a thread-safe cache, so that subsequent
+/// calls with the same pair of units only perform a lookup, which does not lock a mutex
+/// after the first call in each thread.
+/// @param from The string representing the unit from which the conversion is made
+/// @param to The string representing the unit to which the conversion is made
+/// @return The compiled conversion, which remains valid for the lifetime of the program
+auto conversion(const std::string& from, const std::string& to) -> const Conversion&;
+
 /// Convert a numeric value from a unit to another
 /// @param value The value
 /// @param from The string representing the unit from which the conversion is made
@@ -18,15 +18,21 @@
 #include "ChemicalPlot.hpp"
 
 // C++ includes
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
+#include <thread>
 
 // Boost includes
 #include <boost/format.hpp>
 
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Index.hpp>
 #include <Reaktoro/Common/StringList.hpp>
 #include <Reaktoro/Common/StringUtils.hpp>
 #include <Reaktoro/Common/Units.hpp>
@@ -91,6 +97,51 @@ pause %4%
 if(current ne previous && previous ne '') @COMMAND
 if(finished == 0) reread)xyz";
 
+/// A row of the data file, containing the value of the x-quantity followed by the values of the y-quantities.
+using Row = std::vector<double>;
+
+/// A bucket of consecutive rows of the data file.
+struct Bucket
+{
+    /// The number of rows that have been grouped in this bucket.
+    Index count = 0;
+
+    /// The rows of this bucket that are output to the data file.
+    std::vector<Row> rows;
+};
+
+/// Return the first and last rows, and the rows where each y-quantity attains its minimum or maximum.
+auto extremes(const std::vector<Row>& rows) -> std::vector<Row>
+{
+    if(rows.size() <= 2)
+        return rows;
+
+    Indices selected = {0, rows.size() - 1};
+    for(Index j = 1; j < rows.front().size(); ++j)
+    {
+        auto compare = [=](const Row& a, const Row& b) { return a[j] < b[j]; };
+        selected.push_back(std::min_element(rows.begin(), rows.end(), compare) - rows.begin());
+        selected.push_back(std::max_element(rows.begin(), rows.end(), compare) - rows.begin());
+    }
+
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+    std::vector<Row> res;
+    res.reserve(selected.size());
+    for(Index i : selected)
+        res.push_back(rows[i]);
+    return res;
+}
+
+/// Output a row of the data file.
+auto operator<<(std::ostream& out, const Row& row) -> std::ostream&
+{
+    for(double val : row)
+        out << std::left << std::setw(20) << val;
+    return out << "\n";
+}
+
 } // namespace
 
 struct ChemicalPlot::Impl
@@ -131,6 +182,9 @@ struct ChemicalPlot::Impl
     /// The frequency in which the plot is refreshed per second.
     unsigned frequency = 30;
 
+    /// The maximum number of lines in the data file (zero if no decimation is performed).
+    unsigned maxpoints = 0;
+
     /// The name of the data file.
     std::string dataname;
 
@@ -149,9 +203,42 @@ struct ChemicalPlot::Impl
     /// The file that is open to signal Gnuplot to start rereading.
     std::ofstream endfile;
 
+    /// The header line of the data file.
+    std::string header;
+
     /// The pointer to the pipe connecting to Gnuplot
     FILE* pipe = nullptr;
 
+    /// The rows produced by `update` and not yet consumed by the writer thread.
+    std::vector<Row> queue;
+
+    /// The mutex that protects the queue of rows and the stop flag.
+    std::mutex mutex;
+
+    /// The condition variable used to wake up the writer thread.
+    std::condition_variable cv;
+
+    /// The thread that writes the data file and opens Gnuplot in the background.
+    std::thread writer;
+
+    /// The boolean flag that indicates that the writer thread should finish.
+    bool stop = false;
+
+    /// The closed buckets of rows, used only by the writer thread when decimating.
+    std::vector<Bucket> buckets;
+
+    /// The bucket currently receiving new rows, used only by the writer thread when decimating.
+    Bucket current;
+
+    /// The number of rows grouped in each closed bucket.
+    Index stride = 1;
+
+    /// The number of closed buckets already written to the data file.
+    Index written = 0;
+
+    /// The boolean flag that indicates if at least one row has been written to the data file.
+    bool nonempty = false;
+
     /// The iteration number for every update call
     Index iteration = 0;
 
@@ -205,10 +292,12 @@ struct ChemicalPlot::Impl
         datafile << std::setprecision(10);
 
         // Output the name of each quantity in the data file
-        datafile << std::left << std::setw(20) << x;
+        std::stringstream ss;
+        ss << std::left << std::setw(20) << x;
         for(auto item : y)
-            datafile << std::left << std::setw(20) << std::get<1>(item);
-        datafile << std::endl;
+            ss << std::left << std::setw(20) << std::get<1>(item);
+        header = ss.str();
+        datafile << header << std::endl;
 
         // For each discrete point data, output a file with given data
         for(auto item : points)
@@ -279,10 +368,35 @@ struct ChemicalPlot::Impl
 
         // Flush the plot file to ensure its correct state before the plot starts
         plotfile.flush();
+
+        // Reset the state of the decimation of the data
+        buckets.clear();
+        current = Bucket();
+        stride = 1;
+        written = 0;
+        nonempty = false;
+
+        // Start the thread that writes the data file in the background
+        stop = false;
+        writer = std::thread([=]() { run(); });
     }
 
     auto close() -> void
     {
+        // Stop the writer thread after it has written all remaining rows
+        if(writer.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            cv.notify_one();
+            writer.join();
+        }
+
+        // Close the data file
+        datafile.close();
+
         if(pipe != nullptr)
         {
             // Create the file that signals Gnuplot to stop rereading the input script
@@ -304,28 +418,148 @@ struct ChemicalPlot::Impl
 
     auto update(const ChemicalState& state, double t) -> void
     {
-        // Output the current chemical state to the data file.
+        // Evaluate the plotted quantities at the current chemical state
         quantity.update(state, t);
-        datafile << std::left << std::setw(20) << quantity.value(x);
+        Row row;
+        row.reserve(1 + y.size());
+        row.push_back(quantity.value(x));
         for(auto item : y)
         {
             std::string qstr = std::get<1>(item);
-            auto val = (qstr == "i") ? iteration : quantity.value(qstr);
-            datafile << std::left << std::setw(20) << val;
+            row.push_back((qstr == "i") ? iteration : quantity.value(qstr));
         }
-        datafile << std::endl;
 
-        // Open the Gnuplot plot after the first data has been output to the data file.
-        // This ensures that Gnuplot opens the plot without errors/warnings.
-        if(pipe == nullptr)
+        // Hand the row to the writer thread
         {
-            std::string command = ("gnuplot -persist -e \"current=''\" " + plotname + " >> gnuplot.log 2>&1");
-            pipe = popen(command.c_str(), "w");
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(row));
         }
 
         // Update the iteration number
         ++iteration;
     }
+
+    auto run() -> void
+    {
+        // The time interval between two consecutive updates of the data file
+        const auto interval = std::chrono::duration<double>(1.0/std::max(frequency, 1u));
+
+        std::vector<Row> rows;
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            cv.wait_for(lock, interval, [&]() { return stop; });
+            const bool finish = stop;
+            rows.swap(queue);
+            lock.unlock();
+
+            if(!rows.empty() || finish)
+                write(rows, finish);
+            rows.clear();
+
+            // Open the Gnuplot plot after the first data has been output to the data file.
+            // This ensures that Gnuplot opens the plot without errors/warnings.
+            if(pipe == nullptr && nonempty && !finish)
+            {
+                std::string command = ("gnuplot -persist -e \"current=''\" " + plotname + " >> gnuplot.log 2>&1");
+                pipe = popen(command.c_str(), "w");
+            }
+
+            lock.lock();
+            if(finish) break;
+        }
+    }
+
+    auto write(const std::vector<Row>& rows, bool finish) -> void
+    {
+        // Append the new rows to the data file if no decimation is performed
+        if(maxpoints == 0)
+        {
+            for(const Row& row : rows)
+                datafile << row;
+            datafile.flush();
+            nonempty = nonempty || !rows.empty();
+            return;
+        }
+
+        // The maximum number of rows kept in a bucket before it is reduced to its extremes
+        const Index maxrows = 4 + 4*y.size();
+
+        // Group the new rows in buckets
+        for(const Row& row : rows)
+        {
+            current.rows.push_back(row);
+            if(current.rows.size() > maxrows)
+                current.rows = extremes(current.rows);
+            if(++current.count == stride)
+            {
+                current.rows = extremes(current.rows);
+                buckets.push_back(std::move(current));
+                current = Bucket();
+            }
+        }
+
+        // Close the last bucket if the plot is finishing
+        if(finish && current.count > 0)
+        {
+            current.rows = extremes(current.rows);
+            buckets.push_back(std::move(current));
+            current = Bucket();
+        }
+
+        // The number of rows in the closed buckets
+        auto numrows = [&]() { Index n = 0; for(const Bucket& b : buckets) n += b.rows.size(); return n; };
+
+        // Merge pairs of consecutive buckets while there are too many rows
+        bool rewrite = false;
+        while(buckets.size() > 1 && numrows() > maxpoints)
+        {
+            std::vector<Bucket> merged;
+            for(Index i = 0; i < buckets.size(); i += 2)
+            {
+                Bucket bucket = std::move(buckets[i]);
+                if(i + 1 < buckets.size())
+                {
+                    bucket.count += buckets[i + 1].count;
+                    bucket.rows.insert(bucket.rows.end(), buckets[i + 1].rows.begin(), buckets[i + 1].rows.end());
+                    bucket.rows = extremes(bucket.rows);
+                }
+                merged.push_back(std::move(bucket));
+            }
+            buckets = std::move(merged);
+            stride *= 2;
+            rewrite = true;
+        }
+
+        // Rewrite the whole data file if buckets were merged, otherwise append the new closed buckets
+        if(rewrite)
+        {
+            const std::string tmpname = dataname + ".tmp";
+            std::ofstream file(tmpname);
+            file << std::setprecision(10) << header << std::endl;
+            for(const Bucket& bucket : buckets)
+                for(const Row& row : bucket.rows)
+                    file << row;
+            file.close();
+            datafile.close();
+#if _WIN32
+            std::remove(dataname.c_str());
+#endif
+            std::rename(tmpname.c_str(), dataname.c_str());
+            datafile.open(dataname, std::ios::app);
+            datafile << std::setprecision(10);
+        }
+        else
+        {
+            for(Index i = written; i < buckets.size(); ++i)
+                for(const Row& row : buckets[i].rows)
+                    datafile << row;
+            datafile.flush();
+        }
+
+        written = buckets.size();
+        nonempty = !buckets.empty();
+    }
 };
 
 // Initialize the counter of ChemicalPlot instances
@@ -451,6 +685,11 @@ auto ChemicalPlot::frequency(unsigned frequency) -> void
     pimpl->frequency = frequency;
 }
 
+auto ChemicalPlot::maxpoints(unsigned npoints) -> void
+{
+    pimpl->maxpoints = npoints;
+}
+
 auto ChemicalPlot::operator<<(std::string command) -> ChemicalPlot&
 {
     pimpl->config.append(command + "\n");
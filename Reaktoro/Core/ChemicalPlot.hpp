@@ -165,8 +165,22 @@ public:
     auto ylogscale(int base=10) -> void;
 
     /// Set the refresh rate of the real-time plot.
+    /// The data file is also updated at most this number of times per second.
+    /// The rows generated between two refreshes are buffered in memory and
+    /// written by a background thread, so that calls to @ref update never
+    /// block on file or pipe I/O.
     auto frequency(unsigned frequency) -> void;
 
+    /// Set the maximum number of lines in the data file of the plot.
+    /// If the number of updates exceeds this value, consecutive rows are
+    /// grouped into buckets of growing size, and only the rows where each
+    /// plotted quantity attains its minimum or maximum in a bucket are kept,
+    /// together with the first and last rows of the bucket. This bounds the
+    /// size of the data file while preserving the envelope of every curve.
+    /// The default value of zero disables this decimation.
+    /// @param npoints The maximum number of lines in the data file.
+    auto maxpoints(unsigned npoints) -> void;
+
     /// Inject a gnuplot command to the script file.
     auto operator<<(std::string command) -> ChemicalPlot&;
 
@@ -21,6 +21,7 @@
 #include <Reaktoro/Common/ChemicalScalar.hpp>
 #include <Reaktoro/Common/Constants.hpp>
 #include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Profiling.hpp>
 #include <Reaktoro/Common/ThermoScalar.hpp>
 #include <Reaktoro/Core/ChemicalPropertiesAqueousPhase.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
@@ -82,21 +83,22 @@ struct ChemicalProperties::Impl
 
         // Update the thermodynamic properties of each phase
         for(unsigned i = 0; i < num_phases; ++i)
+        {
+            ProfileScope("ChemicalProperties::update::" + system.phase(i).name());
             tres[i] = system.phase(i).thermoModel()(T_, P_);
+        }
     }
 
-    /// Update the chemical properties of the chemical system.
-    auto update(double T_, double P_, const Vector& n_) -> void
+    /// Update the chemical properties of the chemical system at the current temperature and pressure.
+    auto update(const Vector& n_) -> void
     {
-        // Set temperature, pressure and composition
-        T = T_;
-        P = P_;
+        // Set the composition
         n = n_;
 
         // The offset index of the first species in each phase
         Index offset = 0;
 
-        // Update the thermodynamic and chemical properties of each phase
+        // Update the chemical properties of each phase
         for(unsigned i = 0; i < num_phases; ++i)
         {
             // The number of species in the current phase
@@ -105,15 +107,24 @@ struct ChemicalProperties::Impl
             // The vector of molar amounts of the species in the current phase
             auto np = rows(n, offset, size);
 
-            // Calculate the phase thermodynamic and chemical properties
-            tres[i] = system.phase(i).thermoModel()(T_, P_);
-            cres[i] = system.phase(i).chemicalModel()(T_, P_, np);
+            // Calculate the phase chemical properties
+            {
+                ProfileScope("ChemicalProperties::update::" + system.phase(i).name());
+                cres[i] = system.phase(i).chemicalModel()(T.val, P.val, np);
+            }
 
             // Update the index of the first species in the next phase
             offset += size;
         }
     }
 
+    /// Update the chemical properties of the chemical system.
+    auto update(double T_, double P_, const Vector& n_) -> void
+    {
+        update(T_, P_);
+        update(n_);
+    }
+
     /// Return the molar fractions of the species.
     auto molarFractions() const -> ChemicalVector
     {
@@ -124,7 +135,7 @@ struct ChemicalProperties::Impl
             const unsigned size = system.numSpeciesInPhase(i);
             const auto np = rows(n, offset, size);
             const auto xp = Reaktoro::molarFractions(np);
-            rows(res, offset, offset, size, size) = xp;
+            rows(res, offset, offset, size, size) = ChemicalVector(xp);
             offset += size;
         }
         return res;
@@ -285,7 +296,7 @@ struct ChemicalProperties::Impl
             const unsigned size = system.numSpeciesInPhase(i);
             const auto np = rows(n, offset, size);
             const auto xp = Reaktoro::molarFractions(np);
-            row(res, i, offset, size) = sum(xp % tres[i].standard_partial_molar_gibbs_energies);
+            row(res, i, offset, size) = dot(tres[i].standard_partial_molar_gibbs_energies, xp);
             row(res, i, offset, size) += cres[i].residual_molar_gibbs_energy;
             offset += size;
         }
@@ -302,7 +313,7 @@ struct ChemicalProperties::Impl
             const unsigned size = system.numSpeciesInPhase(i);
             const auto np = rows(n, offset, size);
             const auto xp = Reaktoro::molarFractions(np);
-            row(res, i, offset, size) = sum(xp % tres[i].standard_partial_molar_enthalpies);
+            row(res, i, offset, size) = dot(tres[i].standard_partial_molar_enthalpies, xp);
             row(res, i, offset, size) += cres[i].residual_molar_enthalpy;
             offset += size;
         }
@@ -323,7 +334,7 @@ struct ChemicalProperties::Impl
             {
                 const auto np = rows(n, offset, size);
                 const auto xp = Reaktoro::molarFractions(np);
-                row(res, i, offset, size) = sum(xp % tres[i].standard_partial_molar_volumes);
+                row(res, i, offset, size) = dot(tres[i].standard_partial_molar_volumes, xp);
             }
 
             offset += size;
@@ -365,7 +376,7 @@ struct ChemicalProperties::Impl
             const unsigned size = system.numSpeciesInPhase(i);
             const auto np = rows(n, offset, size);
             const auto xp = Reaktoro::molarFractions(np);
-            row(res, i, offset, size) = sum(xp % tres[i].standard_partial_molar_heat_capacities_cp);
+            row(res, i, offset, size) = dot(tres[i].standard_partial_molar_heat_capacities_cp, xp);
             row(res, i, offset, size) += cres[i].residual_molar_heat_capacity_cp;
             offset += size;
         }
@@ -382,7 +393,7 @@ struct ChemicalProperties::Impl
             const unsigned size = system.numSpeciesInPhase(i);
             const auto np = rows(n, offset, size);
             const auto xp = Reaktoro::molarFractions(np);
-            row(res, i, offset, size) = sum(xp % tres[i].standard_partial_molar_heat_capacities_cv);
+            row(res, i, offset, size) = dot(tres[i].standard_partial_molar_heat_capacities_cv, xp);
             row(res, i, offset, size) += cres[i].residual_molar_heat_capacity_cv;
             offset += size;
         }
@@ -523,6 +534,11 @@ auto ChemicalProperties::update(double T, double P) -> void
     pimpl->update(T, P);
 }
 
+auto ChemicalProperties::update(const Vector& n) -> void
+{
+    pimpl->update(n);
+}
+
 auto ChemicalProperties::update(double T, double P, const Vector& n) -> void
 {
     pimpl->update(T, P, n);
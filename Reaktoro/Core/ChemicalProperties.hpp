@@ -47,6 +47,13 @@ public:
     /// @param P The pressure in the system (in units of Pa)
     auto update(double T, double P) -> void;
 
+    /// Update the chemical properties of the chemical system at its current temperature and pressure.
+    /// This method evaluates only the composition dependent part of the chemical properties, so that
+    /// the thermodynamic properties of the species from the last call to @ref update(double, double)
+    /// are reused. It is intended for the inner iterations of equilibrium and kinetic calculations.
+    /// @param n The amounts of the species in the system (in units of mol)
+    auto update(const Vector& n) -> void;
+
     /// Update the chemical properties of the chemical system.
     /// @param T The temperature in the system (in units of K)
     /// @param P The pressure in the system (in units of Pa)
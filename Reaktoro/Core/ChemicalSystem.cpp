@@ -21,6 +21,7 @@
 #include <iostream>
 #include <iomanip>
 #include <set>
+#include <unordered_set>
 
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
@@ -37,15 +38,29 @@ auto formulaMatrix(const std::vector<Element>& elements, const std::vector<Speci
 {
     const auto& num_elements = elements.size();
     const auto& num_species = species.size();
+    const NameIndexMap element_index = nameIndexMap(elements);
     Matrix W = zeros(num_elements, num_species);
     for(unsigned i = 0; i < num_species; ++i)
-        for(unsigned j = 0; j < num_elements; ++j)
-            W(j, i) = species[i].elementCoefficient(elements[j].name());
+        for(const auto& pair : species[i].elements())
+            W(lookup(element_index, pair.first.name(), num_elements), i) = pair.second;
     return W;
 }
 
+auto hasDuplicatedSpeciesNames(const std::vector<Phase>& phases) -> bool
+{
+    std::unordered_set<std::string> names;
+    for(const Phase& phase : phases) for(const Species& species : phase.species())
+        if(!names.insert(species.name()).second)
+            return true;
+    return false;
+}
+
 auto fixDuplicatedSpeciesNames(std::vector<Phase> phases) -> std::vector<Phase>
 {
+    // Skip the quadratic search below in the common case of no duplicates
+    if(!hasDuplicatedSpeciesNames(phases))
+        return phases;
+
     for(Phase& p1 : phases) for(Species& s1 : p1.species())
     {
         int suffix = 1;
@@ -57,6 +72,11 @@ auto fixDuplicatedSpeciesNames(std::vector<Phase> phases) -> std::vector<Phase>
         if(suffix > 1)
             s1.setName(s1.name() + "(" + std::to_string(1) + ")");
     }
+
+    // Rebuild the name lookup tables of the phases with the new species names
+    for(Phase& phase : phases)
+        phase.setSpecies(phase.species());
+
     return phases;
 }
 
@@ -102,6 +122,15 @@ struct ChemicalSystem::Impl
     // The molar masses of the species in each phase
     std::vector<Vector> molar_masses;
 
+    /// The hash tables of the indices of the phases, species and elements by name
+    NameIndexMap phase_index, species_index, element_index;
+
+    /// The index of the first species in each phase, with the total number of species as last entry
+    Indices phase_offsets = Indices(1, 0);
+
+    /// The index of the phase containing each species
+    Indices species_phase;
+
     Impl()
     {}
 
@@ -115,6 +144,20 @@ struct ChemicalSystem::Impl
         molar_masses.reserve(phases.size());
         for(const Phase& phase : phases)
             molar_masses.push_back(molarMasses(phase.species()));
+
+        // Initialize the hash tables for the lookup of phases, species and elements by name
+        phase_index = nameIndexMap(phases);
+        species_index = nameIndexMap(species);
+        element_index = nameIndexMap(elements);
+
+        // Initialize the offsets of the phases and the phase of each species
+        phase_offsets.reserve(phases.size() + 1);
+        species_phase.reserve(species.size());
+        for(Index i = 0; i < phases.size(); ++i)
+        {
+            phase_offsets.push_back(phase_offsets.back() + phases[i].numSpecies());
+            species_phase.insert(species_phase.end(), phases[i].numSpecies(), i);
+        }
     }
 };
 
@@ -204,7 +247,7 @@ auto ChemicalSystem::formulaMatrix() const -> const Matrix&
 
 auto ChemicalSystem::indexElement(std::string name) const -> Index
 {
-    return index(name, elements());
+    return lookup(pimpl->element_index, name, numElements());
 }
 
 auto ChemicalSystem::indexElementWithError(std::string name) const -> Index
@@ -220,7 +263,7 @@ auto ChemicalSystem::indexElementWithError(std::string name) const -> Index
 
 auto ChemicalSystem::indexSpecies(std::string name) const -> Index
 {
-    return index(name, species());
+    return lookup(pimpl->species_index, name, numSpecies());
 }
 
 auto ChemicalSystem::indexSpeciesWithError(std::string name) const -> Index
@@ -234,7 +277,7 @@ auto ChemicalSystem::indexSpeciesWithError(std::string name) const -> Index
 
 auto ChemicalSystem::indexSpeciesAny(const std::vector<std::string>& names) const -> Index
 {
-    return indexAny(names, species());
+    return lookupAny(pimpl->species_index, names, numSpecies());
 }
 
 auto ChemicalSystem::indexSpeciesAnyWithError(const std::vector<std::string>& names) const -> Index
@@ -249,7 +292,7 @@ auto ChemicalSystem::indexSpeciesAnyWithError(const std::vector<std::string>& na
 
 auto ChemicalSystem::indexPhase(std::string name) const -> Index
 {
-    return index(name, phases());
+    return lookup(pimpl->phase_index, name, numPhases());
 }
 
 auto ChemicalSystem::indexPhaseWithError(std::string name) const -> Index
@@ -265,21 +308,15 @@ auto ChemicalSystem::indexPhaseWithError(std::string name) const -> Index
 
 auto ChemicalSystem::indexPhaseWithSpecies(Index index) const -> Index
 {
-    unsigned counter = 0;
-    for(unsigned i = 0; i < numPhases(); ++i)
-    {
-        counter += numSpeciesInPhase(i);
-        if(counter > index) return i;
-    }
-    return numPhases();
+    return index < numSpecies() ? pimpl->species_phase[index] : numPhases();
 }
 
 auto ChemicalSystem::indexFirstSpeciesInPhase(Index iphase) const -> unsigned
 {
-    unsigned counter = 0;
-    for(unsigned i = 0; i < iphase; ++i)
-        counter += phase(i).species().size();
-    return counter;
+    Assert(iphase <= numPhases(),
+        "Could not get the index of the first species in the phase.",
+        "The given phase index " + std::to_string(iphase) + " is out of bounds.");
+    return pimpl->phase_offsets[iphase];
 }
 
 auto ChemicalSystem::indicesElements(const std::vector<std::string>& names) const -> Indices
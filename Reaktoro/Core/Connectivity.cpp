@@ -17,8 +17,10 @@
 
 #include "Connectivity.hpp"
 
+// C++ includes
+#include <algorithm>
+
 // Reaktoro includes
-#include <Reaktoro/Common/SetUtils.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 
 namespace Reaktoro {
@@ -48,39 +50,55 @@ struct Connectivity::Impl
 
     Impl(const ChemicalSystem& system)
     {
-        const auto& elements = system.elements();
-        const auto& species = system.species();
-        const auto& phases = system.phases();
-
-        const unsigned num_elements = elements.size();
-        const unsigned num_species = species.size();
-        const unsigned num_phases = phases.size();
+        const unsigned num_elements = system.numElements();
+        const unsigned num_species = system.numSpecies();
+        const unsigned num_phases = system.numPhases();
 
         element_to_species.resize(num_elements);
         species_to_elements.resize(num_species);
-        for(unsigned j = 0; j < num_elements; ++j)
-            for(unsigned i = 0; i < num_species; ++i)
-                if(species[i].elements().count(elements[j])) {
-                    element_to_species[j].push_back(i);
-                    species_to_elements[i].push_back(j); }
-
         species_to_phase.resize(num_species);
         phase_to_species.resize(num_phases);
-        for(unsigned k = 0; k < num_phases; ++k)
-            for(unsigned i = 0; i < num_species; ++i)
-                if(contained(species[i], phases[k].species())) {
-                    species_to_phase[i] = k;
-                    phase_to_species[k].push_back(i);
-                }
-
         element_to_phases.resize(num_elements);
         phase_to_elements.resize(num_phases);
-        for(unsigned k = 0; k < num_phases; ++k)
-            for(unsigned j = 0; j < num_elements; ++j)
-                if(contained(elements[j], phases[k].elements())) {
-                    element_to_phases[j].push_back(k);
-                    phase_to_elements[k].push_back(j);
+
+        // The last phase in which each element was found, used to collect the elements of a phase only once
+        Indices element_last_phase(num_elements, num_phases);
+
+        // Collect all connectivity maps in a single pass over the species of each phase and their elements.
+        // The species are ordered by phase in the system and the elements of a species are ordered as the
+        // elements of the system, so the species indices are collected in ascending order.
+        Index ispecies = 0;
+        for(Index k = 0; k < num_phases; ++k)
+        {
+            const Index nspecies = system.numSpeciesInPhase(k);
+            phase_to_species[k].reserve(nspecies);
+
+            for(Index n = 0; n < nspecies; ++n, ++ispecies)
+            {
+                species_to_phase[ispecies] = k;
+                phase_to_species[k].push_back(ispecies);
+
+                const auto& elements = system.species(ispecies).elements();
+                species_to_elements[ispecies].reserve(elements.size());
+
+                for(const auto& pair : elements)
+                {
+                    const Index j = system.indexElement(pair.first.name());
+                    species_to_elements[ispecies].push_back(j);
+                    element_to_species[j].push_back(ispecies);
+                    if(element_last_phase[j] != k)
+                    {
+                        element_last_phase[j] = k;
+                        element_to_phases[j].push_back(k);
+                        phase_to_elements[k].push_back(j);
+                    }
                 }
+
+                std::sort(species_to_elements[ispecies].begin(), species_to_elements[ispecies].end());
+            }
+
+            std::sort(phase_to_elements[k].begin(), phase_to_elements[k].end());
+        }
     }
 };
 
@@ -50,6 +50,9 @@ struct Phase::Impl
 
     // The molar masses of the species
     Vector molar_masses;
+
+    /// The hash table of the indices of the species by name
+    NameIndexMap species_index;
 };
 
 Phase::Phase()
@@ -70,6 +73,7 @@ auto Phase::setSpecies(const std::vector<Species>& species) -> void
 {
     pimpl->species = species;
     pimpl->molar_masses = molarMasses(species);
+    pimpl->species_index = nameIndexMap(species);
 }
 
 auto Phase::setThermoModel(const PhaseThermoModel& model) -> void
@@ -149,7 +153,7 @@ auto Phase::chemicalModel() const -> const PhaseChemicalModel&
 
 auto Phase::indexSpecies(std::string name) const -> Index
 {
-    return index(name, species());
+    return lookup(pimpl->species_index, name, numSpecies());
 }
 
 auto Phase::indexSpeciesWithError(std::string name) const -> Index
@@ -163,7 +167,7 @@ auto Phase::indexSpeciesWithError(std::string name) const -> Index
 
 auto Phase::indexSpeciesAny(const std::vector<std::string>& names) const -> Index
 {
-    return indexAny(names, species());
+    return lookupAny(pimpl->species_index, names, numSpecies());
 }
 
 auto Phase::indexSpeciesAnyWithError(const std::vector<std::string>& names) const -> Index
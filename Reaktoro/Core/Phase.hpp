@@ -85,6 +85,8 @@ public:
     auto species() const -> const std::vector<Species>&;
 
     /// Return the species of the phase.
+    /// **Note:** If the names of the species are changed, call @ref setSpecies
+    /// afterwards so that the lookup of species by name is updated.
     auto species() -> std::vector<Species>&;
 
     /// Return the species of the phase with a given index.
@@ -43,7 +43,7 @@ struct PhaseChemicalProperties::Impl
     Vector n;
 
     /// The molar fractions of the species in the phase (in units of mol/mol).
-    ChemicalVector x;
+    ChemicalVectorStructured x;
 
     /// The results of the evaluation of the PhaseThermoModel function of the phase.
     PhaseThermoModelResult tres;
@@ -88,7 +88,7 @@ struct PhaseChemicalProperties::Impl
     /// Return the molar fractions of the species.
     auto molarFractions() const -> ChemicalVector
     {
-        return x;
+        return ChemicalVector(x);
     }
 
     /// Return the ln activity coefficients of the species.
@@ -175,7 +175,7 @@ struct PhaseChemicalProperties::Impl
     /// Return the molar Gibbs energy of the phase (in units of J/mol).
     auto molarGibbsEnergy() const -> ChemicalScalar
     {
-        ChemicalScalar res = sum(x % tres.standard_partial_molar_gibbs_energies);
+        ChemicalScalar res = dot(tres.standard_partial_molar_gibbs_energies, x);
         res += cres.residual_molar_gibbs_energy;
         return res;
     }
@@ -183,7 +183,7 @@ struct PhaseChemicalProperties::Impl
     /// Return the molar enthalpy of the phase (in units of J/mol).
     auto molarEnthalpy() const -> ChemicalScalar
     {
-        ChemicalScalar res = sum(x % tres.standard_partial_molar_enthalpies);
+        ChemicalScalar res = dot(tres.standard_partial_molar_enthalpies, x);
         res += cres.residual_molar_enthalpy;
         return res;
     }
@@ -193,7 +193,7 @@ struct PhaseChemicalProperties::Impl
     {
         if(cres.molar_volume.val > 0.0)
             return cres.molar_volume;
-        return sum(x % tres.standard_partial_molar_volumes);
+        return dot(tres.standard_partial_molar_volumes, x);
     }
 
     /// Return the molar entropy of the phase (in units of J/(mol*K)).
@@ -223,7 +223,7 @@ struct PhaseChemicalProperties::Impl
     /// Return the molar isobaric heat capacities of the phase (in units of J/(mol*K)).
     auto molarHeatCapacityConstP() const -> ChemicalScalar
     {
-        ChemicalScalar res = sum(x % tres.standard_partial_molar_heat_capacities_cp);
+        ChemicalScalar res = dot(tres.standard_partial_molar_heat_capacities_cp, x);
         res += cres.residual_molar_heat_capacity_cp;
         return res;
     }
@@ -231,7 +231,7 @@ struct PhaseChemicalProperties::Impl
     /// Return the molar isochoric heat capacities of the phase (in units of J/(mol*K)).
     auto molarHeatCapacityConstV() const -> ChemicalScalar
     {
-        ChemicalScalar res = sum(x % tres.standard_partial_molar_heat_capacities_cv);
+        ChemicalScalar res = dot(tres.standard_partial_molar_heat_capacities_cv, x);
         res += cres.residual_molar_heat_capacity_cv;
         return res;
     }
@@ -19,16 +19,38 @@
 
 // C++ includes
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // Reaktoro includes
 #include <Reaktoro/Common/ChemicalScalar.hpp>
 #include <Reaktoro/Common/ChemicalVector.hpp>
+#include <Reaktoro/Common/ChemicalVectorStructured.hpp>
 #include <Reaktoro/Common/Index.hpp>
 #include <Reaktoro/Math/Matrix.hpp>
 
 namespace Reaktoro {
 
+/// The type of a hash table that maps the names of the entries in a container to their indices.
+using NameIndexMap = std::unordered_map<std::string, Index>;
+
+/// Return a hash table that maps the names of the entries in a container to their indices.
+/// If more than one entry has the same name, the index of the first one is used.
+template<typename NamedValues>
+auto nameIndexMap(const NamedValues& values) -> NameIndexMap;
+
+/// Return the index of an entry with given name in a hash table of names and indices.
+/// @param map The hash table of names and indices
+/// @param name The name of the entry
+/// @param notfound The index returned if the name is not in the table
+auto lookup(const NameIndexMap& map, const std::string& name, Index notfound) -> Index;
+
+/// Return the index of the first entry with any of the given names in a hash table of names and indices.
+/// @param map The hash table of names and indices
+/// @param names The names of the entry in order of preference
+/// @param notfound The index returned if none of the names is in the table
+auto lookupAny(const NameIndexMap& map, const std::vector<std::string>& names, Index notfound) -> Index;
+
 /// Return the names of the entries in a container.
 template<typename NamedValues>
 auto names(const NamedValues& values) -> std::vector<std::string>;
@@ -42,8 +64,10 @@ template<typename SpeciesValues>
 auto molarMasses(const SpeciesValues& species) -> Vector;
 
 /// Return the molar fractions of the species.
+/// The mole derivatives are kept in their diagonal plus rank-one form. Convert the
+/// result to a ChemicalVector only where the dense derivatives are needed.
 template<typename Derived>
-auto molarFractions(const Eigen::MatrixBase<Derived>& n) -> ChemicalVector;
+auto molarFractions(const Eigen::MatrixBase<Derived>& n) -> ChemicalVectorStructured;
 
 } // namespace Reaktoro
 
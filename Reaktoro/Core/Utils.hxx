@@ -18,6 +18,34 @@
 // C++ includes
 namespace Reaktoro {
 
+template<typename NamedValues>
+auto nameIndexMap(const NamedValues& values) -> NameIndexMap
+{
+    NameIndexMap map;
+    map.reserve(values.size());
+    Index idx = 0;
+    for(const auto& entry : values)
+        map.emplace(entry.name(), idx++);
+    return map;
+}
+
+inline auto lookup(const NameIndexMap& map, const std::string& name, Index notfound) -> Index
+{
+    const auto iter = map.find(name);
+    return iter != map.end() ? iter->second : notfound;
+}
+
+inline auto lookupAny(const NameIndexMap& map, const std::vector<std::string>& names, Index notfound) -> Index
+{
+    for(const auto& name : names)
+    {
+        const auto iter = map.find(name);
+        if(iter != map.end())
+            return iter->second;
+    }
+    return notfound;
+}
+
 template<typename NamedValues>
 auto names(const NamedValues& values) -> std::vector<std::string>
 {
@@ -47,14 +75,24 @@ auto molarMasses(const SpeciesValues& species) -> Vector
 }
 
 template<typename Derived>
-auto molarFractions(const Eigen::MatrixBase<Derived>& n) -> ChemicalVector
+auto molarFractions(const Eigen::MatrixBase<Derived>& n) -> ChemicalVectorStructured
 {
-	const auto nc = composition(n);
     const unsigned nspecies = n.size();
+    ChemicalVectorStructured x(nspecies);
     if(nspecies == 1)
-        return ChemicalVector(nspecies, nspecies, 1.0);
-    const ChemicalScalar nt = sum(nc);
-    return (nt != 0.0) ? nc/nt : ChemicalVector(nspecies);
+    {
+        x.val[0] = 1.0;
+        return x;
+    }
+    const double nt = n.sum();
+    if(nt == 0.0)
+        return x;
+    // The derivatives have the structure diag(1/nt) - x*1^T/nt
+    x.val = n/nt;
+    x.d.fill(1.0/nt);
+    x.u = -x.val/nt;
+    x.v.fill(1.0);
+    return x;
 }
 
 } // namespace Reaktoro
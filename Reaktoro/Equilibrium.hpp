@@ -18,6 +18,7 @@
 #pragma once
 
 #include <Reaktoro/Equilibrium/EquilibriumBalance.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumBatch.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumCompositionProblem.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumInverseProblem.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumInverseSolver.hpp>
@@ -0,0 +1,73 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+
+namespace Reaktoro {
+
+/// A type that describes a batch of independent equilibrium problems.
+/// The data of the equilibrium problems is stored in caller-owned, contiguous
+/// buffers in a structure-of-arrays layout, so that many problems can be solved
+/// without constructing a ChemicalState instance for each of them. The entries
+/// of the `k`-th problem start at `k*stride`, where `stride` is the dimension
+/// of the corresponding quantity (e.g., `be + k*Ee`, `n + k*N`).
+/// The buffers for the sensitivities are optional and skipped if null.
+/// @see EquilibriumSolver
+struct EquilibriumBatch
+{
+    /// The number of equilibrium problems in the batch
+    Index size = 0;
+
+    /// The temperatures of the problems with dimension `size` (in units of K)
+    const double* T = nullptr;
+
+    /// The pressures of the problems with dimension `size` (in units of Pa)
+    const double* P = nullptr;
+
+    /// The molar amounts of the equilibrium elements with dimension `size*Ee` (in units of mol)
+    const double* be = nullptr;
+
+    /// The molar amounts of all species with dimension `size*N` (in units of mol).
+    /// On input, the initial guess (including the amounts of the inert species).
+    /// On output, the molar amounts at equilibrium.
+    double* n = nullptr;
+
+    /// The dual potentials of the elements with dimension `size*E` (in units of J/mol)
+    double* y = nullptr;
+
+    /// The dual potentials of the species with dimension `size*N` (in units of J/mol)
+    double* z = nullptr;
+
+    /// The optional derivatives of `ne` with respect to temperature with dimension `size*Ne` (in units of mol/K)
+    double* dnedT = nullptr;
+
+    /// The optional derivatives of `ne` with respect to pressure with dimension `size*Ne` (in units of mol/Pa)
+    double* dnedP = nullptr;
+
+    /// The optional derivatives of `ne` with respect to `be` with dimension `size*Ne*Ee` (in units of mol/mol).
+    /// The `Ne`-by-`Ee` matrix of each problem is stored in column-major order.
+    double* dnedbe = nullptr;
+
+    /// The optional convergence flags of the problems with dimension `size`
+    bool* succeeded = nullptr;
+};
+
+} // namespace Reaktoro
@@ -17,17 +17,28 @@
 
 #include "EquilibriumInverseSolver.hpp"
 
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
 // Reaktoro includes
+#include <Reaktoro/Common/ChemicalVector.hpp>
+#include <Reaktoro/Common/Constants.hpp>
+#include <Reaktoro/Common/Profiling.hpp>
+#include <Reaktoro/Common/TimeUtils.hpp>
 #include <Reaktoro/Core/ChemicalProperties.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 #include <Reaktoro/Core/Partition.hpp>
+#include <Reaktoro/Core/ThermoProperties.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumInverseProblem.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumSensitivity.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumState.hpp>
+#include <Reaktoro/Math/Eigen/LU>
 #include <Reaktoro/Optimization/NonlinearSolver.hpp>
+#include <Reaktoro/Optimization/Utils.hpp>
 
 namespace Reaktoro {
 
@@ -69,6 +80,18 @@ struct EquilibriumInverseSolver::Impl
     /// Solve an inverse equilibrium problem
     auto solve(EquilibriumState& state, const EquilibriumInverseProblem& problem) -> EquilibriumResult
     {
+        switch(options.inverse)
+        {
+        case InverseMethod::Monolithic: return solveMonolithic(state, problem);
+        default: return solveNested(state, problem);
+        }
+    }
+
+    /// Solve an inverse equilibrium problem with an equilibrium calculation at every evaluation of the constraints
+    auto solveNested(EquilibriumState& state, const EquilibriumInverseProblem& problem) -> EquilibriumResult
+    {
+        ProfileScope("EquilibriumInverseSolver::nested");
+
         // The accumulated equilibrium result of this inverse problem calculation
         EquilibriumResult result;
 
@@ -163,6 +186,225 @@ struct EquilibriumInverseSolver::Impl
 
         return result;
     }
+
+    /// Solve an inverse equilibrium problem with a Newton iteration on the equilibrium
+    /// conditions augmented with the titrant amounts and the equilibrium constraints.
+    /// The unknowns are the logarithms of the amounts of the equilibrium species `ne`,
+    /// the normalized dual potentials of the equilibrium elements `ye`, and the amounts
+    /// of the titrants `x`. The dual potentials of the species `ze` are eliminated using the
+    /// linearized complementarity conditions `ne⋅ze = μ`, so that the Newton system is:
+    /// @code
+    /// [H⋅N + Z  -Aeᵀ   0 ] [d(ln ne)]   [-(g - Aeᵀye - ze) - (ne⋅ze - μ)/ne]
+    /// [  Ae⋅N     0   -Ce ] [  dye   ] = [-(Ae⋅ne - be0 - Ce⋅x)              ]
+    /// [  Fn⋅N     0    Fx ] [  dx    ]   [-F(x, n)                           ]
+    /// @endcode
+    /// where `g` and `H` are the gradient and Hessian of the normalized Gibbs energy function,
+    /// and `Fn` and `Fx` are the derivatives of the equilibrium constraints `F` w.r.t. `ne` and `x`.
+    /// The amounts of the titrants are kept positive. The nested method is used instead if the
+    /// number of constraints and titrants differ, and as a fallback if the Newton iteration does
+    /// not converge (e.g., when a titrant needs to be removed rather than added).
+    auto solveMonolithic(EquilibriumState& state, const EquilibriumInverseProblem& problem) -> EquilibriumResult
+    {
+        ProfileScope("EquilibriumInverseSolver::monolithic");
+
+        // The accumulated equilibrium result of this inverse problem calculation
+        EquilibriumResult result;
+
+        // Define auxiliary variables from the inverse problem definition
+        const Index Nt = problem.numTitrants();
+        const Index Nc = problem.numConstraints();
+
+        // The Newton system is square only if there are as many constraints as titrants
+        if(Nt != Nc)
+            return solveNested(state, problem);
+
+        const Matrix C = problem.formulaMatrixTitrants();
+        const Vector b0 = problem.elementInitialAmounts();
+        const Indices ies = partition.indicesEquilibriumSpecies();
+        const Indices iee = partition.indicesEquilibriumElements();
+        const Matrix Ae = partition.formulaMatrixEquilibriumPartition();
+        const Index Ne = ies.size();
+        const Index Ee = iee.size();
+        const Index Nk = Ne + Ee + Nt;
+
+        // Get the rows corresponding to equilibrium elements only
+        const Matrix Ce = rows(C, iee);
+        const Vector be0 = rows(b0, iee);
+
+        // The temperature and pressure for the calculation, and the RT factor
+        const double T = problem.temperature();
+        const double P = problem.pressure();
+        const double RT = universalGasConstant*T;
+
+        // The parameters of the Newton iteration
+        const double mu = options.optimum.ipnewton.mu;
+        const double tau = options.optimum.ipnewton.tau;
+        const double tol = options.optimum.tolerance;
+        const double tolF = options.nonlinear.tolerance;
+        const unsigned max_iterations = options.optimum.max_iterations;
+
+        // The amount below which the optimality of a species is not used to check convergence
+        const double eps = std::sqrt(options.epsilon);
+
+        // The maximum variation of the logarithm of a species amount in one iteration
+        const double max_lnstep = 10.0;
+
+        // The maximum number of step halvings in the backtracking of an iteration
+        const unsigned max_backtracks = 8;
+
+        // Set the temperature and pressure of the chemical state
+        state.setTemperature(T);
+        state.setPressure(P);
+
+        // Set the options and partition in the equilibrium solver
+        solver.setOptions(options);
+        solver.setPartition(partition);
+
+        // Initialize the initial guess of the titrant amounts
+        Vector x = problem.titrantInitialAmounts();
+
+        // Replace zeros in x by small molar amounts
+        x = (x.array() > 0.0).select(x, 1e-6);
+
+        // Compute the equilibrium state for the initial guess of the titrant amounts
+        result += solver.solve(state, T, P, be0 + Ce*x);
+
+        // Check if the equilibrium calculation converged
+        if(!result.optimum.succeeded)
+        {
+            // If not, solve using cold start
+            state.setSpeciesAmounts(0.0);
+            result += solver.solve(state, T, P, be0 + Ce*x);
+        }
+
+        // Use the nested method if no starting point could be calculated
+        if(!result.optimum.succeeded)
+            return solveNested(state, problem);
+
+        // The state from which the nested method restarts in case of failure
+        const EquilibriumState state0 = state;
+
+        // The normalized standard Gibbs energies of the species at (T,P)
+        const ThermoVector G0 = system.properties(T, P).standardPartialMolarGibbsEnergies()/RT;
+
+        // Initialize the unknowns from the calculated equilibrium state
+        Vector n = state.speciesAmounts();
+        Vector ne = rows(n, ies);
+        Vector ye = Vector(rows(state.elementDualPotentials(), iee))/RT;
+        Vector ze = Vector(rows(state.speciesDualPotentials(), ies))/RT;
+
+        // Define auxiliary instances to avoid memory reallocation
+        ChemicalProperties properties;
+        ChemicalVector u, ue;
+        ResidualEquilibriumConstraints res;
+        Vector rx, ry, rz, rF, rhs, delta, dz;
+        Vector ne0, ye0, ze0, x0;
+        Matrix K = zeros(Nk, Nk);
+        Eigen::PartialPivLU<Matrix> lu;
+
+        // Initialize the constant block of the Newton matrix
+        K.block(Ne, Ne + Ee, Ee, Nt) = -Ce;
+
+        // The function that updates the residuals of the Newton system and returns its error
+        auto update_residuals = [&]() -> double
+        {
+            // Update the chemical state and its properties
+            rows(n, ies) = ne;
+            state.setSpeciesAmounts(n);
+            properties = system.properties(T, P, n);
+
+            // Calculate the normalized chemical potentials of the equilibrium species
+            u = G0 + properties.lnActivities();
+            ue = rows(u, ies, ies);
+
+            // Calculate the residuals of the equilibrium constraints
+            res = problem.residualEquilibriumConstraints(x, state);
+
+            // Calculate the optimality, feasibility, centrality and constraint residuals
+            rx.noalias() = ue.val - tr(Ae)*ye - ze;
+            ry.noalias() = Ae*ne - be0 - Ce*x;
+            rz = ne % ze - mu;
+            rF = res.val;
+
+            // The optimality residuals of species with amounts near the numerical zero are
+            // disregarded, since these are resolved by the final equilibrium calculation
+            return std::max({norminf(ne % rx/(ne + eps)), norminf(ry), norminf(rz), norminf(rF)/tolF*tol});
+        };
+
+        // The start time of the Newton iteration
+        Time begin = time();
+
+        // The error of the current iterate
+        double error = update_residuals();
+
+        // The number of iterations and evaluations of the residuals
+        unsigned iterations = 0;
+        unsigned evaluations = 1;
+
+        while(std::isfinite(error) && error >= tol && iterations++ < max_iterations)
+        {
+            // Assemble the Newton matrix with respect to the logarithms of the species amounts
+            K.topLeftCorner(Ne, Ne) = ue.ddn * diag(ne);
+            K.topLeftCorner(Ne, Ne).diagonal() += ze;
+            K.block(0, Ne, Ne, Ee) = -tr(Ae);
+            K.block(Ne, 0, Ee, Ne) = Ae * diag(ne);
+            K.block(Ne + Ee, 0, Nt, Ne) = cols(res.ddn, ies) * diag(ne);
+            K.block(Ne + Ee, Ne + Ee, Nt, Nt) = res.ddx;
+
+            // Assemble the right-hand side vector of the Newton system
+            rhs.resize(Nk);
+            rhs << -(rx + rz/ne), -ry, -rF;
+
+            // Solve the Newton system and recover the step of the dual potentials of the species
+            lu.compute(K);
+            delta = lu.solve(rhs);
+            dz = -(rz/ne + ze % delta.head(Ne));
+
+            // Limit the variation of the logarithms of the species amounts
+            delta.head(Ne) = delta.head(Ne).cwiseMax(-max_lnstep).cwiseMin(max_lnstep);
+
+            // Backtrack the Newton step until the error decreases, starting
+            // from the longest step that keeps the titrant amounts positive
+            ne0 = ne; ye0 = ye; ze0 = ze; x0 = x;
+            const double error0 = error;
+            double alpha = fractionToTheBoundary(x0, delta.tail(Nt), tau);
+            bool decreased = false;
+            for(unsigned k = 0; k <= max_backtracks && !decreased; ++k, alpha *= 0.5)
+            {
+                ne = ne0 % exp(alpha * delta.head(Ne));
+                ye = ye0 + alpha * delta.segment(Ne, Ee);
+                x  = x0  + alpha * delta.tail(Nt);
+                for(Index i = 0; i < Ne; ++i)
+                    ze[i] = (ze0[i] + alpha*dz[i] > 0.0) ? ze0[i] + alpha*dz[i] : ze0[i]*(1.0 - tau);
+                error = update_residuals();
+                decreased = std::isfinite(error) && error < error0;
+                ++evaluations;
+            }
+
+            // Stop the Newton iteration if the error could not be decreased
+            if(!decreased)
+                break;
+        }
+
+        // Update the result with the cost of the Newton iteration
+        result.optimum.iterations += iterations;
+        result.optimum.num_objective_evals += evaluations;
+        result.optimum.time += elapsed(begin);
+
+        // Use the nested method if the Newton iteration did not converge
+        if(!std::isfinite(error) || error >= tol)
+        {
+            state = state0;
+            result += solveNested(state, problem);
+            return result;
+        }
+
+        // Finalize with the equilibrium solver, which updates the dual potentials
+        // of all species and the sensitivity of the equilibrium state
+        result += solver.solve(state, T, P, be0 + Ce*x);
+
+        return result;
+    }
 };
 
 EquilibriumInverseSolver::EquilibriumInverseSolver(const ChemicalSystem& system)
@@ -33,6 +33,8 @@ EquilibriumOptions::EquilibriumOptions(const char* str)
         auto pair = split(word, "=");
         if(pair.front() == "output")
             optimum.output.active = pair.back() == "true" ? true : false;
+        if(pair.front() == "inverse")
+            inverse = pair.back() == "monolithic" ? InverseMethod::Monolithic : InverseMethod::Nested;
     }
 }
 
@@ -40,6 +40,19 @@ enum class GibbsHessian
     ApproximationDiagonal,
 };
 
+/// The methods for the solution of inverse equilibrium problems
+enum class InverseMethod
+{
+    /// The titrant amounts are the unknowns of a nonlinear solver that performs
+    /// a complete equilibrium calculation at every evaluation of its residual.
+    Nested,
+
+    /// The titrant amounts and the equilibrium constraints are appended to the
+    /// Newton system of the equilibrium optimality conditions, so that all
+    /// unknowns are computed simultaneously in a single interior-point iteration.
+    Monolithic,
+};
+
 /// The options for the equilibrium calculations
 struct EquilibriumOptions
 {
@@ -69,6 +82,9 @@ struct EquilibriumOptions
     /// The optimisation method to be used for the equilibrium calculation.
     OptimumMethod method = OptimumMethod::IpNewton;
 
+    /// The method to be used for the inverse equilibrium calculation.
+    InverseMethod inverse = InverseMethod::Nested;
+
     /// The options for the optimisation calculation.
     OptimumOptions optimum;
 
@@ -18,6 +18,7 @@
 #include "EquilibriumPath.hpp"
 
 // C++ includes
+#include <algorithm>
 #include <list>
 
 // Reaktoro includes
@@ -69,6 +70,16 @@ struct EquilibriumPath::Impl
 
     /// Solve the path of equilibrium states between two chemical states
     auto solve(const EquilibriumState& state_i, const EquilibriumState& state_f) -> EquilibriumPathResult
+    {
+        switch(options.method)
+        {
+        case EquilibriumPathMethod::Continuation: return solveContinuation(state_i, state_f);
+        default: return solveODE(state_i, state_f);
+        }
+    }
+
+    /// Solve the path of equilibrium states by integrating the equilibrium species amounts with an ODE solver
+    auto solveODE(const EquilibriumState& state_i, const EquilibriumState& state_f) -> EquilibriumPathResult
     {
         // The result of this equilibrium path calculation
         EquilibriumPathResult result;
@@ -183,6 +194,174 @@ struct EquilibriumPath::Impl
 
         return result;
     }
+
+    /// Solve the path of equilibrium states with a predictor-corrector continuation method
+    auto solveContinuation(const EquilibriumState& state_i, const EquilibriumState& state_f) -> EquilibriumPathResult
+    {
+        // The result of this equilibrium path calculation
+        EquilibriumPathResult result;
+
+        // The options of the continuation method
+        const EquilibriumPathContinuationOptions& copts = options.continuation;
+
+        // The number of phases in the chemical system
+        const unsigned num_phases = system.numPhases();
+
+        // The indices of species in the equilibrium partition
+        const Indices& ies = partition.indicesEquilibriumSpecies();
+
+        // The temperatures, pressures and element amounts at the initial and final chemical states
+        const double T_i = state_i.temperature();
+        const double T_f = state_f.temperature();
+        const double P_i = state_i.pressure();
+        const double P_f = state_f.pressure();
+        const Vector be_i = state_i.elementAmountsInSpecies(ies);
+        const Vector be_f = state_f.elementAmountsInSpecies(ies);
+
+        // The equilibrium solver used as corrector
+        EquilibriumSolver equilibrium(system);
+        equilibrium.setOptions(options.equilibrium);
+        equilibrium.setPartition(partition);
+
+        // The chemical state at the last accepted point of the path and the trial state of the corrector
+        EquilibriumState state = state_i;
+        EquilibriumState trial = state_i;
+
+        // The auxiliary function that determines the stable phases of an equilibrium state
+        auto stablePhases = [&](const EquilibriumState& s)
+        {
+            const Vector si = s.phaseStabilityIndices();
+            std::vector<bool> stable(num_phases);
+            for(unsigned i = 0; i < num_phases; ++i)
+                stable[i] = si[i] > -copts.stability_tolerance;
+            return stable;
+        };
+
+        // The auxiliary function that calculates the rate of change of the equilibrium species
+        // amounts with respect to t using the sensitivity of the last equilibrium calculation
+        auto tangent = [&]() -> Vector
+        {
+            const EquilibriumSensitivity sensitivity = equilibrium.sensitivity();
+            return sensitivity.dnedT * (T_f - T_i) +
+                   sensitivity.dnedP * (P_f - P_i) +
+                   sensitivity.dnedbe * (be_f - be_i);
+        };
+
+        // Compute the equilibrium state at the start of the path
+        result.equilibrium += equilibrium.solve(state, T_i, P_i, be_i);
+
+        // Check if the calculation succeeded
+        if(!result.equilibrium.optimum.succeeded)
+            return result;
+
+        // The rate of change of the equilibrium species amounts with respect to t at the last accepted point
+        Vector dnedt = tangent();
+
+        // The stable phases at the last accepted point
+        std::vector<bool> stable = stablePhases(state);
+
+        // Initialize the output and the plots of the equilibrium path calculation
+        if(output) output.open();
+        for(auto& plot : plots) plot.open();
+
+        // Update the output and the plots with the initial state
+        if(output) output.update(state, 0.0);
+        for(auto& plot : plots) plot.update(state, 0.0);
+
+        double t = 0.0;
+        double dt = std::min(copts.initial_step, copts.max_step);
+
+        // The step length in use before the bisection of a phase event started (zero if none in progress)
+        double dt_event = 0.0;
+
+        while(t < 1.0)
+        {
+            // Ensure the last step finishes exactly at t = 1
+            const double h = std::min(dt, 1.0 - t);
+            const double tnew = (t + h > 1.0 - copts.min_step) ? 1.0 : t + h;
+
+            // Predict the equilibrium species amounts at t + h along the tangent of the path
+            const Vector ne = rows(state.speciesAmounts(), ies);
+            Vector ne_pred = ne + (tnew - t) * dnedt;
+
+            // Ensure the predicted amounts remain positive by damping the decrease of vanishing species
+            for(unsigned i = 0; i < ne_pred.rows(); ++i)
+                if(ne_pred[i] <= 0.0) ne_pred[i] = 0.01 * ne[i];
+
+            // Correct the predicted state with a warm-started equilibrium calculation
+            trial = state;
+            trial.setSpeciesAmounts(ne_pred, ies);
+
+            const double T  = T_i + tnew * (T_f - T_i);
+            const double P  = P_i + tnew * (P_f - P_i);
+            const Vector be = be_i + tnew * (be_f - be_i);
+
+            EquilibriumResult res = equilibrium.solve(trial, T, P, be);
+            result.equilibrium += res;
+
+            const unsigned iterations = res.optimum.iterations;
+
+            // Reject the step if the corrector failed or converged too slowly
+            if(!res.optimum.succeeded || iterations > copts.max_iterations)
+            {
+                if(h <= copts.min_step) break;
+                dt = std::max(0.5 * h, copts.min_step);
+                continue;
+            }
+
+            // Check if phases appeared or disappeared within the step
+            const std::vector<bool> stable_new = stablePhases(trial);
+            const bool event = stable_new != stable;
+
+            if(event && copts.locate_events && h > copts.event_tolerance)
+            {
+                if(dt_event == 0.0) dt_event = h;
+                dt = std::max(0.5 * h, copts.event_tolerance);
+                continue;
+            }
+
+            for(unsigned i = 0; i < num_phases; ++i)
+            {
+                if(stable_new[i] == stable[i]) continue;
+                EquilibriumPathEvent e;
+                e.t = tnew;
+                e.iphase = i;
+                e.appeared = stable_new[i];
+                result.events.push_back(e);
+            }
+
+            // Accept the step and update the tangent of the path at the new point
+            t = tnew;
+            state = trial;
+            stable = stable_new;
+            ++result.steps;
+
+            dnedt = tangent();
+
+            // Update the output and the plots with the accepted state
+            if(output) output.update(state, t);
+            for(auto& plot : plots) plot.update(state, t);
+
+            // Scale the step length by the ratio of the desired and actual number of iterations of
+            // the corrector, so that it increases (at most doubling) if the corrector converged in
+            // fewer iterations than desired, and decreases (at most halving) otherwise
+            dt = h * std::max(0.5, std::min(2.0, double(copts.target_iterations)/std::max(iterations, 1u)));
+
+            // Resume the step length used before the bisection once the phase event has been passed
+            if(event && dt_event > 0.0)
+            {
+                dt = std::max(dt, dt_event);
+                dt_event = 0.0;
+            }
+
+            dt = std::max(copts.min_step, std::min(dt, copts.max_step));
+        }
+
+        // Ensure a failure in the corrector is reported if the path was not completed
+        if(t < 1.0) result.equilibrium.optimum.succeeded = false;
+
+        return result;
+    }
 };
 
 EquilibriumPath::EquilibriumPath(const ChemicalSystem& system)
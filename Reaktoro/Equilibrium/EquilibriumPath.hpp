@@ -23,6 +23,7 @@
 #include <vector>
 
 // Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
 #include <Reaktoro/Math/ODE.hpp>
@@ -36,14 +37,81 @@ class ChemicalSystem;
 class EquilibriumState;
 class Partition;
 
+/// The methods for tracing a path of equilibrium states.
+enum class EquilibriumPathMethod
+{
+    /// The equilibrium species amounts are integrated along the path with an
+    /// ODE solver, whose right-hand side function performs an equilibrium
+    /// calculation and a sensitivity calculation at every evaluation.
+    ODE,
+
+    /// The path is traced with a predictor-corrector continuation method,
+    /// in which the sensitivity of the last equilibrium state is used to
+    /// predict the next one, which is then corrected with a warm-started
+    /// equilibrium calculation.
+    Continuation,
+};
+
+/// A struct that describes the options for the continuation method of an equilibrium path calculation.
+struct EquilibriumPathContinuationOptions
+{
+    /// The initial step length along the path parameter `t`, with `t` in [0, 1].
+    double initial_step = 0.01;
+
+    /// The minimum step length along the path parameter `t`.
+    double min_step = 1e-8;
+
+    /// The maximum step length along the path parameter `t`.
+    double max_step = 0.1;
+
+    /// The desired number of iterations of each corrector equilibrium calculation.
+    /// The step length is increased if the corrector converges with fewer iterations
+    /// than this, and decreased otherwise.
+    unsigned target_iterations = 15;
+
+    /// The maximum number of iterations of a corrector equilibrium calculation
+    /// before the step is rejected and retried with half the step length.
+    unsigned max_iterations = 50;
+
+    /// The flag that indicates if phase appearance and disappearance events
+    /// should be located by bisection on the step length.
+    bool locate_events = true;
+
+    /// The tolerance on the path parameter `t` used to locate phase events.
+    double event_tolerance = 1e-4;
+
+    /// The tolerance on the stability index of a phase for it to be considered stable.
+    /// A phase is stable if its stability index is greater than `-stability_tolerance`.
+    double stability_tolerance = 1e-3;
+};
+
 /// A struct that describes the options from an equilibrium path calculation.
 struct EquilibriumPathOptions
 {
     /// The options for the chemical equilibrium calculations.
     EquilibriumOptions equilibrium;
 
+    /// The method used to trace the equilibrium path.
+    EquilibriumPathMethod method = EquilibriumPathMethod::ODE;
+
     /// The options for the ODE solver
     ODEOptions ode;
+
+    /// The options for the continuation method
+    EquilibriumPathContinuationOptions continuation;
+};
+
+/// A struct that describes the appearance or disappearance of a phase along an equilibrium path.
+struct EquilibriumPathEvent
+{
+    /// The value of the path parameter `t` at which the event was located.
+    double t = 0.0;
+
+    /// The index of the phase that appeared or disappeared.
+    Index iphase = 0;
+
+    /// The flag that indicates if the phase appeared (true) or disappeared (false).
+    bool appeared = false;
 };
 
 /// A struct that describes the result of an equilibrium path calculation.
@@ -51,6 +119,12 @@ struct EquilibriumPathResult
 {
     /// The accumulated result of the equilibrium calculations.
     EquilibriumResult equilibrium;
+
+    /// The number of accepted steps along the path (continuation method only).
+    unsigned steps = 0;
+
+    /// The phase appearance and disappearance events along the path (continuation method only).
+    std::vector<EquilibriumPathEvent> events;
 };
 
 /// A class that describes a path of equilibrium states.
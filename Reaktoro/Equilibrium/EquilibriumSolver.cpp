@@ -17,16 +17,24 @@
 
 #include "EquilibriumSolver.hpp"
 
+// C++ includes
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 // Reaktoro includes
 #include <Reaktoro/Common/ChemicalVector.hpp>
 #include <Reaktoro/Common/Constants.hpp>
 #include <Reaktoro/Common/ConvertUtils.hpp>
 #include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Profiling.hpp>
+#include <Reaktoro/Common/SetUtils.hpp>
 #include <Reaktoro/Core/ChemicalProperties.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 #include <Reaktoro/Core/Connectivity.hpp>
 #include <Reaktoro/Core/Partition.hpp>
 #include <Reaktoro/Core/ThermoProperties.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumBatch.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumProblem.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
@@ -98,6 +106,9 @@ struct EquilibriumSolver::Impl
     /// The indices of the inert species (i.e., the species in disequilibrium)
     Indices iis;
 
+    /// The indices of the phases of the equilibrium species (i.e., the diagonal blocks of the Gibbs Hessian)
+    Indices ieblocks;
+
     /// The number of species and elements in the system
     unsigned N, E;
 
@@ -113,13 +124,33 @@ struct EquilibriumSolver::Impl
     /// The formula matrix of the inert species
     Matrix Ai;
 
+    /// The auxiliary equilibrium state reused by every problem in a batch calculation
+    EquilibriumState batchstate;
+
+    /// The properties of the chemical system, whose thermodynamic part is updated only when (T,P) changes
+    ChemicalProperties properties;
+
+    /// The normalized standard Gibbs energies of the species at the (T,P) of `properties`
+    ThermoVector G0;
+
+    /// The temperature and pressure of `properties`, which are reset when copied, so that a
+    /// copy of this solver recreates `properties` instead of sharing it with the original
+    struct ThermoPoint
+    {
+        double T = std::numeric_limits<double>::quiet_NaN();
+        double P = std::numeric_limits<double>::quiet_NaN();
+        ThermoPoint() {}
+        ThermoPoint(const ThermoPoint&) {}
+        auto operator=(const ThermoPoint&) -> ThermoPoint& { return *this = ThermoPoint(); }
+    } thermopoint;
+
     /// Construct a default Impl instance
     Impl()
     {}
 
     /// Construct a Impl instance
     Impl(const ChemicalSystem& system)
-    : system(system)
+    : system(system), batchstate(system)
     {
         // Initialize the formula matrix
         A = system.formulaMatrix();
@@ -157,6 +188,27 @@ struct EquilibriumSolver::Impl
 
         // Initialize the formula matrix of the inert species
         Ai = cols(A, iis);
+
+        // Initialize the indices of the phases of the equilibrium species
+        ieblocks.clear();
+        ieblocks.reserve(Ne);
+        for(Index i : ies)
+            ieblocks.push_back(system.indexPhaseWithSpecies(i));
+    }
+
+    /// Update the thermodynamic properties of the chemical system if (T,P) has changed since the last update
+    auto updateThermoProperties(double T, double P) -> void
+    {
+        if(T == thermopoint.T && P == thermopoint.P)
+            return;
+
+        ProfileScope("EquilibriumSolver::updateThermoProperties");
+
+        properties = ChemicalProperties(system);
+        properties.update(T, P);
+        G0 = properties.standardPartialMolarGibbsEnergies()/(universalGasConstant*T);
+        thermopoint.T = T;
+        thermopoint.P = P;
     }
 
     /// Update the OptimumOptions instance with given EquilibriumOptions instance
@@ -202,32 +254,24 @@ struct EquilibriumSolver::Impl
     /// Update the OptimumProblem instance with given EquilibriumProblem and EquilibriumState instances
     auto updateOptimumProblem(const EquilibriumState& state) -> void
     {
-        // The temperature and pressure of the equilibrium calculation
-        const auto T  = state.temperature();
-        const auto P  = state.pressure();
-        const auto RT = universalGasConstant*T;
-
         // Set the molar amounts of the species
         n = state.speciesAmounts();
 
-        // The thermodynamic properties of the chemical system
-        ChemicalProperties properties;
+        // The thermodynamic properties of the chemical system at (T,P), including the
+        // normalized standard Gibbs energies of the species, reused while (T,P) is unchanged
+        updateThermoProperties(state.temperature(), state.pressure());
 
         // The result of the objective evaluation
         ObjectiveResult res;
 
-        // The normalized standard Gibbs energies of the species at (T,P)
-        ThermoVector G0 = system.properties(T, P).
-            standardPartialMolarGibbsEnergies()/RT;
-
         // The Gibbs energy function to be minimized
         optimum_problem.objective = [=](const Vector& ne) mutable
         {
             // Set the molar amounts of the species
             rows(n, ies) = ne;
 
-            // Calculate the thermodynamic properties of the chemical system
-            properties = system.properties(T, P, n);
+            // Calculate the chemical properties of the chemical system at the fixed (T,P)
+            properties.update(n);
 
             // Set the scaled chemical potentials of the species
             u = G0 + properties.lnActivities();
@@ -248,6 +292,7 @@ struct EquilibriumSolver::Impl
             case GibbsHessian::Exact:
                 res.hessian.mode = Hessian::Dense;
                 res.hessian.dense = ue.ddn;
+                res.hessian.blocks = ieblocks;
                 break;
             case GibbsHessian::ExactDiagonal:
                 res.hessian.mode = Hessian::Diagonal;
@@ -256,6 +301,7 @@ struct EquilibriumSolver::Impl
             case GibbsHessian::Approximation:
                 res.hessian.mode = Hessian::Dense;
                 res.hessian.dense = diag(inv(xe.val)) * xe.ddn;
+                res.hessian.blocks = ieblocks;
                 break;
             case GibbsHessian::ApproximationDiagonal:
                 res.hessian.mode = Hessian::Diagonal;
@@ -349,13 +395,14 @@ struct EquilibriumSolver::Impl
         z = state.speciesDualPotentials();
 
         // Calculate the standard thermodynamic properties of the system
-        ChemicalProperties props = system.properties(T, P, n);
+        updateThermoProperties(T, P);
+        properties.update(n);
 
         // Get the standard Gibbs energies of the equilibrium species
-        const Vector ge0 = rows(props.standardPartialMolarGibbsEnergies().val, ies);
+        const Vector ge0 = rows(properties.standardPartialMolarGibbsEnergies().val, ies);
 
         // Get the ln activity constants of the equilibrium species
-        const Vector ln_ce = rows(props.lnActivityConstants().val, ies);
+        const Vector ln_ce = rows(properties.lnActivityConstants().val, ies);
 
         // Define the optimisation problem
         OptimumProblem optimum_problem;
@@ -463,6 +510,8 @@ struct EquilibriumSolver::Impl
     /// Solve the equilibrium problem
     auto solve(EquilibriumState& state, double T, double P, const double* b) -> EquilibriumResult
     {
+        ProfileScope("EquilibriumSolver::solve");
+
         // Set the molar amounts of the elements
         be = Vector::Map(b, Ee);
 
@@ -472,7 +521,11 @@ struct EquilibriumSolver::Impl
 
         // Check if a simplex cold-start approximation must be performed
         if(coldstart(state))
+        {
+            ProfileScope("EquilibriumSolver::coldstart");
             initialguess(state, T, P, be);
+        }
+        else ProfileCount("EquilibriumSolver::warmstart", 1);
 
         // The result of the equilibrium calculation
         EquilibriumResult result;
@@ -520,6 +573,68 @@ struct EquilibriumSolver::Impl
 
         return sensitivity;
     }
+
+    /// Solve a batch of independent equilibrium problems
+    auto solve(EquilibriumBatch& batch) -> EquilibriumResult
+    {
+        // Check the mandatory buffers of the batch were given
+        Assert(batch.size == 0 || (batch.T && batch.P && batch.be && batch.n),
+            "Cannot proceed with method EquilibriumSolver::solve.",
+            "The given batch of equilibrium problems has no buffers for "
+            "temperature, pressure, element amounts, or species amounts.");
+
+        // The accumulated result of the equilibrium calculations
+        EquilibriumResult result;
+
+        // The flag that indicates if the sensitivities are needed
+        const bool derivatives = batch.dnedT || batch.dnedP || batch.dnedbe;
+
+        // The flag that indicates if all equilibrium calculations succeeded
+        bool succeeded = true;
+
+        // The order in which the problems are solved, with problems at the same (T,P) grouped
+        // together, so that the thermodynamic properties are calculated once per distinct (T,P)
+        Indices order = range(batch.size);
+        std::stable_sort(order.begin(), order.end(), [&](Index i, Index j)
+            { return std::make_pair(batch.T[i], batch.P[i]) < std::make_pair(batch.T[j], batch.P[j]); });
+
+        for(Index k : order)
+        {
+            // Copy the initial guess of the k-th problem into the auxiliary state
+            batchstate.setSpeciesAmounts(Vector::Map(batch.n + k*N, N));
+            batchstate.setElementDualPotentials(batch.y ? Vector(Vector::Map(batch.y + k*E, E)) : Vector(zeros(E)));
+            batchstate.setSpeciesDualPotentials(batch.z ? Vector(Vector::Map(batch.z + k*N, N)) : Vector(zeros(N)));
+
+            // Solve the k-th equilibrium problem
+            EquilibriumResult res = solve(batchstate, batch.T[k], batch.P[k], batch.be + k*Ee);
+
+            // Copy the calculated state back into the buffers of the caller (n, y, z were updated in `solve`)
+            Vector::Map(batch.n + k*N, N) = n;
+            if(batch.y) Vector::Map(batch.y + k*E, E) = y;
+            if(batch.z) Vector::Map(batch.z + k*N, N) = z;
+
+            if(batch.succeeded)
+                batch.succeeded[k] = res.optimum.succeeded;
+
+            // Calculate the sensitivities of the k-th problem if requested
+            if(derivatives)
+            {
+                const EquilibriumSensitivity sens = sensitivity();
+                if(batch.dnedT) Vector::Map(batch.dnedT + k*Ne, Ne) = sens.dnedT;
+                if(batch.dnedP) Vector::Map(batch.dnedP + k*Ne, Ne) = sens.dnedP;
+                if(batch.dnedbe) Matrix::Map(batch.dnedbe + k*Ne*Ee, Ne, Ee) = sens.dnedbe;
+            }
+
+            succeeded = succeeded && res.optimum.succeeded;
+
+            result += res;
+        }
+
+        // The batch succeeded only if every problem succeeded
+        result.optimum.succeeded = succeeded;
+
+        return result;
+    }
 };
 
 EquilibriumSolver::EquilibriumSolver()
@@ -568,6 +683,11 @@ auto EquilibriumSolver::solve(EquilibriumState& state, double T, double P, const
     return pimpl->solve(state, T, P, be);
 }
 
+auto EquilibriumSolver::solve(EquilibriumBatch& batch) -> EquilibriumResult
+{
+    return pimpl->solve(batch);
+}
+
 auto EquilibriumSolver::sensitivity() -> EquilibriumSensitivity
 {
     return pimpl->sensitivity();
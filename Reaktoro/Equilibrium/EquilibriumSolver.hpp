@@ -29,6 +29,7 @@ namespace Reaktoro {
 class EquilibriumState;
 class ChemicalSystem;
 class Partition;
+struct EquilibriumBatch;
 struct EquilibriumOptions;
 struct EquilibriumResult;
 struct EquilibriumSensitivity;
@@ -75,6 +76,18 @@ public:
     /// @param be The molar amounts of the elements in the equilibrium partition
     auto solve(EquilibriumState& state, double T, double P, const double* be) -> EquilibriumResult;
 
+    /// Solve a batch of independent equilibrium problems stored in caller-owned buffers.
+    /// The problems are solved in sequence, each using the molar amounts and dual potentials
+    /// in the buffers as initial guess, which are then overwritten with the calculated ones.
+    /// Problems at the same temperature and pressure are solved one after the other, so that
+    /// the thermodynamic properties of the species are calculated once per distinct (T,P).
+    /// A single auxiliary state is reused for all problems, so that no ChemicalState instance
+    /// needs to be kept per problem. Distribute sub-batches among EquilibriumSolver instances
+    /// constructed from independent ChemicalSystem instances for thread-level parallelism.
+    /// @param batch[in,out] The buffers with the inputs and outputs of the equilibrium problems
+    /// @return The accumulated result of all equilibrium calculations
+    auto solve(EquilibriumBatch& batch) -> EquilibriumResult;
+
     /// Return the sensitivity of the equilibrium state.
     /// The sensitivity of the equilibrium state is defined as the rate of change of the
     /// molar amounts of the equilibrium species with respect to temperature `T`, pressure `P`,
@@ -20,8 +20,16 @@
 #ifdef LINK_GEMS
 
 // C++ includes
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <vector>
 
 // Gems includes
@@ -31,9 +39,13 @@
 
 // Reaktoro includes
 #include <Reaktoro/Common/Constants.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/ThreadLocalPool.hpp>
 #include <Reaktoro/Common/TimeUtils.hpp>
+#include <Reaktoro/Core/ChemicalProperties.hpp>
 #include <Reaktoro/Core/ChemicalState.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/ThermoProperties.hpp>
 
 namespace Reaktoro {
 namespace {
@@ -92,54 +104,303 @@ auto uniqueSpeciesNames(const Gems& gems) -> std::vector<std::string>
     return species_names;
 }
 
-} // namespace
+/// Initialize a TNode instance from a Gems specification file.
+auto initializeNode(TNode& node, std::string filename) -> void
+{
+    // Initialize the GEMS `node` instance
+    if(node.GEM_init(filename.c_str()))
+        throw std::runtime_error("Error reading the Gems chemical system specification file.");
 
-struct Gems::Impl
+    //------------------------------------------------------------------------------------------------------
+    // The following parameters in GEMS have to be set to extremely small values to ensure that
+    // small molar amounts do not interfere with activity coefficient and chemical potential calculations
+    //------------------------------------------------------------------------------------------------------
+    // Reset the cutoff minimum amount of stable phase in GEMS (default: 1e-20)
+    node.pActiv()->GetActivityDataPtr()->DSM = 1e-300;
+
+    // Set the cutoff mole amount of water-solvent for aqueous phase elimination in GEMS (default: 1e-13)
+    node.pActiv()->GetActivityDataPtr()->XwMinM = 1e-300;
+
+    // Set the cutoff mole amount of solid sorbent for sorption phase elimination (default: 1e-13)
+    node.pActiv()->GetActivityDataPtr()->ScMinM = 1e-300;
+
+    // Set the cutoff mole amount for elimination of DC (species) in multi-component phase (default: 1e-33)
+    node.pActiv()->GetActivityDataPtr()->DcMinM = 1e-300;
+
+    // Set the cutoff mole amount for elimination of solution phases other than aqueous (default: 1e-20)
+    node.pActiv()->GetActivityDataPtr()->PhMinM = 1e-300;
+
+    // Set the cutoff effective molal ionic strength for calculation of aqueous activity coefficients (default: 1e-5)
+    node.pActiv()->GetActivityDataPtr()->ICmin = 1e-300;
+}
+
+/// A TNode instance together with the standard thermodynamic properties last computed with it.
+struct GemsNode
 {
     /// The TNode instance from Gems
     TNode node;
 
-    /// The elapsed time of the equilibrate method (in units of s)
+    /// The temperature and pressure at which the standard Gibbs energies in `node` were last updated
+    double T = std::numeric_limits<double>::quiet_NaN();
+    double P = std::numeric_limits<double>::quiet_NaN();
+
+    /// The temperature and pressure of the cached thermodynamic properties of the phases
+    double thermo_T = std::numeric_limits<double>::quiet_NaN();
+    double thermo_P = std::numeric_limits<double>::quiet_NaN();
+
+    /// The cached thermodynamic properties of the phases at `thermo_T` and `thermo_P`
+    std::vector<PhaseThermoModelResult> thermo;
+
+    /// The flags that indicate the phases whose thermodynamic properties are cached
+    std::vector<bool> cached;
+
+    /// The elapsed time of the last equilibrium calculation with `node` (in units of s)
     double elapsed_time = 0;
 
+    /// Discard the cached standard thermodynamic properties
+    auto reset() -> void
+    {
+        T = P = std::numeric_limits<double>::quiet_NaN();
+        thermo_T = thermo_P = std::numeric_limits<double>::quiet_NaN();
+        cached.clear();
+    }
+};
+
+/// The worker threads of a Gems instance, which are kept alive among the batched property calculations.
+/// Every worker thread keeps the TNode instance it leases, so that it is initialized only once.
+struct GemsWorkers
+{
+    /// The worker threads
+    std::vector<std::thread> threads;
+
+    /// The function applied by every thread with its index, where the calling thread has index 0
+    std::function<void(Index)> task;
+
+    /// The number of tasks assigned so far, which wakes the worker threads when it changes
+    Index generation = 0;
+
+    /// The number of worker threads still applying the current task
+    Index pending = 0;
+
+    /// The flag that tells the worker threads to exit
+    bool stop = false;
+
+    /// The mutex and the condition variables that synchronize the worker threads
+    std::mutex mutex;
+    std::condition_variable wake, done;
+
+    ~GemsWorkers()
+    {
+        shutdown();
+    }
+
+    /// Stop and join all worker threads
+    auto shutdown() -> void
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for(std::thread& thread : threads)
+            thread.join();
+        threads.clear();
+        stop = false;
+    }
+
+    /// Set the number of worker threads, restarting them only if the number changes
+    auto resize(Index size) -> void
+    {
+        if(threads.size() == size)
+            return;
+        shutdown();
+        const Index seen = generation;
+        for(Index t = 1; t <= size; ++t)
+            threads.emplace_back([=]() { run(t, seen); });
+    }
+
+    /// The loop of a worker thread, which applies every task after a given one until the thread is stopped
+    auto run(Index t, Index seen) -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            wake.wait(lock, [&]() { return stop || generation != seen; });
+            if(stop) return;
+            seen = generation;
+            lock.unlock();
+            task(t);
+            lock.lock();
+            if(--pending == 0)
+                done.notify_one();
+        }
+    }
+
+    /// Apply a function `f(t)` in every worker thread and in the calling thread, returning after all of them.
+    /// The function must not throw.
+    auto apply(const std::function<void(Index)>& f) -> void
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = f;
+            pending = threads.size();
+            ++generation;
+        }
+        wake.notify_all();
+
+        f(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return pending == 0; });
+    }
+};
+
+/// Update the temperature, pressure, and standard Gibbs energies of a TNode instance.
+auto update(GemsNode& data, double T, double P) -> void
+{
+    data.node.setTemperature(T);
+    data.node.setPressure(P);
+
+    if(T == data.T && P == data.P)
+        return;
+
+    data.node.updateStandardGibbsEnergies();
+    data.T = T;
+    data.P = P;
+}
+
+/// The TNode instances of a Gems instance, which are shared with the Gems instances created from it.
+struct GemsNodes
+{
+    /// The TNode instance from Gems used by the thread that constructed this instance
+    GemsNode main;
+
+    /// The TNode instances used by the other threads
+    ThreadLocalPool<GemsNode> pool;
+
+    /// The thread that constructed this instance
+    std::thread::id owner = std::this_thread::get_id();
+
     /// The options for Gems
     GemsOptions options;
 
     /// The unique names of the species
     std::vector<std::string> species_names;
 
+    /// Construct a default GemsNodes instance
+    GemsNodes()
+    : pool([]() { return std::unique_ptr<GemsNode>(new GemsNode()); })
+    {}
+
+    /// Construct a GemsNodes instance from a Gems specification file
+    GemsNodes(std::string filename)
+    : pool([=]()
+      {
+          std::unique_ptr<GemsNode> node(new GemsNode());
+          initializeNode(node->node, filename);
+          return node;
+      })
+    {
+        // Initialize the GEMS `node` member
+        initializeNode(main.node, filename);
+    }
+
+    /// Return the TNode instance used by the current thread
+    auto current() -> GemsNode&
+    {
+        if(std::this_thread::get_id() == owner)
+            return main;
+        return pool.local();
+    }
+};
+
+} // namespace
+
+struct Gems::Impl
+{
+    /// The TNode instances of this instance
+    std::shared_ptr<GemsNodes> nodes;
+
+    /// The number of threads used for the batched property calculations
+    Index nthreads = 1;
+
+    /// The worker threads of the batched property calculations
+    GemsWorkers workers;
+
+    /// The mutex that serializes the batched property calculations
+    std::mutex batch;
+
+    /// The chemical system used in the batched property calculations, created in the first of them
+    std::unique_ptr<ChemicalSystem> system;
+
     /// Construct a default Impl instance
     Impl()
+    : nodes(std::make_shared<GemsNodes>())
     {}
 
-    /// Construct a default Impl instance
+    /// Construct an Impl instance from a Gems specification file
     Impl(std::string filename)
-    {
-        // Initialize the GEMS `node` member
-        if(node.GEM_init(filename.c_str()))
-            throw std::runtime_error("Error reading the Gems chemical system specification file.");
+    : nodes(std::make_shared<GemsNodes>(filename))
+    {}
 
-        //------------------------------------------------------------------------------------------------------
-        // The following parameters in GEMS have to be set to extremely small values to ensure that
-        // small molar amounts do not interfere with activity coefficient and chemical potential calculations
-        //------------------------------------------------------------------------------------------------------
-        // Reset the cutoff minimum amount of stable phase in GEMS (default: 1e-20)
-        node.pActiv()->GetActivityDataPtr()->DSM = 1e-300;
+    /// Construct an Impl instance that shares the TNode instances of another
+    Impl(const std::shared_ptr<GemsNodes>& nodes)
+    : nodes(nodes)
+    {}
 
-        // Set the cutoff mole amount of water-solvent for aqueous phase elimination in GEMS (default: 1e-13)
-        node.pActiv()->GetActivityDataPtr()->XwMinM = 1e-300;
+    /// Return the TNode instance used by the current thread
+    auto current() -> GemsNode&
+    {
+        return nodes->current();
+    }
 
-        // Set the cutoff mole amount of solid sorbent for sorption phase elimination (default: 1e-13)
-        node.pActiv()->GetActivityDataPtr()->ScMinM = 1e-300;
+    /// Return the chemical system used in the batched property calculations.
+    /// The system is created from a Gems instance that shares the TNode instances of this
+    /// instance, but not this Impl instance, so that the chemical properties calculated with
+    /// the system remain valid after this instance is destroyed, without a reference cycle.
+    auto chemicalSystem() -> const ChemicalSystem&
+    {
+        if(!system)
+        {
+            Gems view;
+            view.pimpl = std::make_shared<Impl>(nodes);
+            system.reset(new ChemicalSystem(view.system()));
+        }
+        return *system;
+    }
 
-        // Set the cutoff mole amount for elimination of DC (species) in multi-component phase (default: 1e-33)
-        node.pActiv()->GetActivityDataPtr()->DcMinM = 1e-300;
+    /// Apply a function `f(i)` for every index in `[0, size)` using all threads.
+    template<typename Function>
+    auto parallel(Index size, const Function& f) -> void
+    {
+        // The number of threads, with at least one index in each of them
+        const Index nworkers = std::max<Index>(std::min(nthreads, size), 1);
 
-        // Set the cutoff mole amount for elimination of solution phases other than aqueous (default: 1e-20)
-        node.pActiv()->GetActivityDataPtr()->PhMinM = 1e-300;
+        // The exceptions thrown by the threads, if any
+        std::vector<std::exception_ptr> errors(nworkers);
 
-        // Set the cutoff effective molal ionic strength for calculation of aqueous activity coefficients (default: 1e-5)
-        node.pActiv()->GetActivityDataPtr()->ICmin = 1e-300;
+        // Apply the function in the range of indices of a given thread
+        auto apply = [&](Index t)
+        {
+            if(t >= nworkers)
+                return;
+            const Index begin = t * size / nworkers;
+            const Index end = (t + 1) * size / nworkers;
+            try {
+                for(Index i = begin; i < end; ++i)
+                    f(i);
+            } catch(...) {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        // Process the first range of indices in the calling thread and the others in the worker threads
+        workers.resize(nthreads - 1);
+        workers.apply(apply);
+
+        // Rethrow the first exception in the calling thread
+        for(const std::exception_ptr& error : errors)
+            if(error) std::rethrow_exception(error);
     }
 };
 
@@ -151,7 +412,7 @@ Gems::Gems(std::string filename)
 : pimpl(new Impl(filename))
 {
     // Initialize the unique names of the species
-    pimpl->species_names = uniqueSpeciesNames(*this);
+    pimpl->nodes->species_names = uniqueSpeciesNames(*this);
 }
 
 Gems::~Gems()
@@ -177,53 +438,71 @@ auto Gems::speciesAmounts() const -> Vector
 
 auto Gems::numElements() const -> unsigned
 {
-    return node().pCSD()->nIC;
+    return pimpl->nodes->main.node.pCSD()->nIC;
 }
 
 auto Gems::numSpecies() const -> unsigned
 {
-    return node().pCSD()->nDC;
+    return pimpl->nodes->main.node.pCSD()->nDC;
 }
 
 auto Gems::numPhases() const -> unsigned
 {
-    return node().pCSD()->nPH;
+    return pimpl->nodes->main.node.pCSD()->nPH;
 }
 
 auto Gems::numSpeciesInPhase(Index iphase) const -> unsigned
 {
-    return node().pCSD()->nDCinPH[iphase];
+    return pimpl->nodes->main.node.pCSD()->nDCinPH[iphase];
 }
 
 auto Gems::elementName(Index ielement) const -> std::string
 {
-    return node().pCSD()->ICNL[ielement];
+    return pimpl->nodes->main.node.pCSD()->ICNL[ielement];
 }
 
 auto Gems::elementMolarMass(Index ielement) const -> double
 {
-    return node().ICmm(ielement);
+    return pimpl->nodes->main.node.ICmm(ielement);
 }
 
 auto Gems::elementStoichiometry(Index ispecies, Index ielement) const -> double
 {
-    return node().DCaJI(ispecies, ielement);
+    return pimpl->nodes->main.node.DCaJI(ispecies, ielement);
 }
 
 auto Gems::speciesName(Index ispecies) const -> std::string
 {
-    return pimpl->species_names[ispecies];
+    return pimpl->nodes->species_names[ispecies];
 }
 
 auto Gems::phaseName(Index iphase) const -> std::string
 {
-    return node().pCSD()->PHNL[iphase];
+    return pimpl->nodes->main.node.pCSD()->PHNL[iphase];
 }
 
 auto Gems::properties(Index iphase, double T, double P) -> PhaseThermoModelResult
 {
-    // Update the temperature and pressure of the Gems instance
-    set(T, P);
+    // The TNode instance of the current thread
+    GemsNode& data = pimpl->current();
+    TNode& node = data.node;
+
+    // Update the temperature and pressure of the TNode instance
+    node.setTemperature(T);
+    node.setPressure(P);
+
+    // Discard the cached thermodynamic properties if the temperature or pressure changed
+    if(T != data.thermo_T || P != data.thermo_P || data.cached.empty())
+    {
+        data.thermo_T = T;
+        data.thermo_P = P;
+        data.thermo.resize(numPhases());
+        data.cached.assign(numPhases(), false);
+    }
+
+    // Return the cached thermodynamic properties of the phase, if any
+    if(data.cached[iphase])
+        return data.thermo[iphase];
 
     // The number of species in the phase
     const Index nspecies = numSpeciesInPhase(iphase);
@@ -237,18 +516,25 @@ auto Gems::properties(Index iphase, double T, double P) -> PhaseThermoModelResul
     // Set the thermodynamic properties of given phase
     for(unsigned j = 0; j < nspecies; ++j)
     {
-        res.standard_partial_molar_gibbs_energies.val[j] = node().DC_G0(ifirst + j, P, T, false);
-        res.standard_partial_molar_enthalpies.val[j] = node().DC_H0(ifirst + j, P, T);
-        res.standard_partial_molar_volumes.val[j] = node().DC_V0(ifirst + j, P, T);
-        res.standard_partial_molar_heat_capacities_cp.val[j] = node().DC_Cp0(ifirst + j, P, T);
-        res.standard_partial_molar_heat_capacities_cv.val[j] = node().DC_Cp0(ifirst + j, P, T);
+        res.standard_partial_molar_gibbs_energies.val[j] = node.DC_G0(ifirst + j, P, T, false);
+        res.standard_partial_molar_enthalpies.val[j] = node.DC_H0(ifirst + j, P, T);
+        res.standard_partial_molar_volumes.val[j] = node.DC_V0(ifirst + j, P, T);
+        res.standard_partial_molar_heat_capacities_cp.val[j] = node.DC_Cp0(ifirst + j, P, T);
+        res.standard_partial_molar_heat_capacities_cv.val[j] = node.DC_Cp0(ifirst + j, P, T);
     }
 
+    // Cache the thermodynamic properties of the phase
+    data.thermo[iphase] = res;
+    data.cached[iphase] = true;
+
     return res;
 }
 
 auto Gems::properties(Index iphase, double T, double P, const Vector& n) -> PhaseChemicalModelResult
 {
+    // The TNode instance of the current thread
+    TNode& node = pimpl->current().node;
+
     // Update the temperature, pressure, and species amounts of the Gems instance
     set(T, P, n);
 
@@ -262,12 +548,12 @@ auto Gems::properties(Index iphase, double T, double P, const Vector& n) -> Phas
     PhaseChemicalModelResult res(nspecies);
 
     // The activity pointer from Gems
-    ACTIVITY* ap = node().pActiv()->GetActivityDataPtr();
+    ACTIVITY* ap = node.pActiv()->GetActivityDataPtr();
 
     // Set the molar volume of current phase
     res.molar_volume.val = (nspecies == 1) ?
-        node().DC_V0(ifirst, P, T) :
-        node().Ph_Volume(iphase)/node().Ph_Mole(iphase);
+        node.DC_V0(ifirst, P, T) :
+        node.Ph_Volume(iphase)/node.Ph_Mole(iphase);
 
     // Set the ln activity coefficients and ln activities of the species in current phase
     for(unsigned j = 0; j < nspecies; ++j)
@@ -295,48 +581,114 @@ auto Gems::clone() const -> std::shared_ptr<Interface>
 
 auto Gems::set(double T, double P) -> void
 {
-    node().setTemperature(T);
-    node().setPressure(P);
+    TNode& node = pimpl->current().node;
+    node.setTemperature(T);
+    node.setPressure(P);
 }
 
 auto Gems::set(double T, double P, const Vector& n) -> void
 {
-    node().setTemperature(T);
-    node().setPressure(P);
-    node().setSpeciation(n.data());
+    GemsNode& data = pimpl->current();
+    TNode& node = data.node;
+
+    // Update the standard Gibbs energies only if the temperature or pressure changed
+    update(data, T, P);
 
-    node().updateStandardGibbsEnergies();
-    node().initActivityCoefficients();
-    node().updateConcentrations();
-    node().updateActivityCoefficients();
-    node().updateChemicalPotentials();
-    node().updateActivities();
+    node.setSpeciation(n.data());
+    node.initActivityCoefficients();
+    node.updateConcentrations();
+    node.updateActivityCoefficients();
+    node.updateChemicalPotentials();
+    node.updateActivities();
 }
 
 auto Gems::setOptions(const GemsOptions& options) -> void
 {
-    pimpl->options = options;
+    pimpl->nodes->options = options;
+}
+
+auto Gems::setNumThreads(Index nthreads) -> void
+{
+    Assert(nthreads > 0,
+        "Could not set the number of threads of the Gems instance.",
+        "Expecting a positive number of threads.");
+    pimpl->nthreads = nthreads;
+}
+
+auto Gems::numThreads() const -> Index
+{
+    return pimpl->nthreads;
+}
+
+auto Gems::properties(const std::vector<double>& T, const std::vector<double>& P) -> std::vector<ThermoProperties>
+{
+    Assert(T.size() == P.size(),
+        "Could not calculate the thermodynamic properties of the Gems instance.",
+        "Expecting the same number of temperature and pressure values.");
+
+    // Allow only one batched property calculation at a time, since they share the worker threads
+    std::lock_guard<std::mutex> lock(pimpl->batch);
+
+    // The chemical system whose phases evaluate their properties with this instance
+    const ChemicalSystem& system = pimpl->chemicalSystem();
+
+    std::vector<ThermoProperties> res(T.size());
+    pimpl->parallel(T.size(), [&](Index i)
+    {
+        res[i] = system.properties(T[i], P[i]);
+    });
+
+    return res;
+}
+
+auto Gems::properties(const std::vector<double>& T, const std::vector<double>& P, const std::vector<Vector>& n) -> std::vector<ChemicalProperties>
+{
+    Assert(T.size() == P.size() && T.size() == n.size(),
+        "Could not calculate the chemical properties of the Gems instance.",
+        "Expecting the same number of temperature, pressure, and composition values.");
+
+    // Allow only one batched property calculation at a time, since they share the worker threads
+    std::lock_guard<std::mutex> lock(pimpl->batch);
+
+    // The chemical system whose phases evaluate their properties with this instance
+    const ChemicalSystem& system = pimpl->chemicalSystem();
+
+    std::vector<ChemicalProperties> res(T.size());
+    pimpl->parallel(T.size(), [&](Index i)
+    {
+        res[i] = system.properties(T[i], P[i], n[i]);
+    });
+
+    return res;
 }
 
 auto Gems::equilibrate(double T, double P, const Vector& b) -> void
 {
+    // The TNode instance of the current thread
+    GemsNode& data = pimpl->current();
+    TNode& node = data.node;
+
     // Start timing
     Time start = time();
 
     // Set temperature and pressure
-    set(T, P);
+    node.setTemperature(T);
+    node.setPressure(P);
+
+    // The equilibrium calculation overwrites the standard properties computed in the node
+    data.reset();
 
     // Set the molar amounts of the elements
     for(unsigned i = 0; i < numElements(); ++i)
-        node().pCNode()->bIC[i] = b[i];
+        node.pCNode()->bIC[i] = b[i];
 
     // Solve the equilibrium problem with gems
-    node().pCNode()->NodeStatusCH =
-        pimpl->options.warmstart ? NEED_GEM_SIA : NEED_GEM_AIA;
-    node().GEM_run(false);
+    node.pCNode()->NodeStatusCH =
+        pimpl->nodes->options.warmstart ? NEED_GEM_SIA : NEED_GEM_AIA;
+    node.GEM_run(false);
 
     // Finish timing
-    pimpl->elapsed_time = elapsed(start);
+    data.elapsed_time = elapsed(start);
 }
 
 auto Gems::converged() const -> bool
@@ -352,17 +704,20 @@ auto Gems::numIterations() const -> unsigned
 
 auto Gems::elapsedTime() const -> double
 {
-    return pimpl->elapsed_time;
+    return pimpl->current().elapsed_time;
 }
 
 auto Gems::node() -> TNode&
 {
-    return pimpl->node;
+    // The TNode instance may be changed by the caller, so its cached properties are discarded
+    GemsNode& data = pimpl->current();
+    data.reset();
+    return data.node;
 }
 
 auto Gems::node() const -> const TNode&
 {
-    return pimpl->node;
+    return pimpl->current().node;
 }
 
 } // namespace Reaktoro
@@ -509,6 +864,29 @@ auto Gems::setOptions(const GemsOptions& options) -> void
     throwGemsNotBuiltError();
 }
 
+auto Gems::setNumThreads(Index nthreads) -> void
+{
+    throwGemsNotBuiltError();
+}
+
+auto Gems::numThreads() const -> Index
+{
+    throwGemsNotBuiltError();
+    return {};
+}
+
+auto Gems::properties(const std::vector<double>& T, const std::vector<double>& P) -> std::vector<ThermoProperties>
+{
+    throwGemsNotBuiltError();
+    return {};
+}
+
+auto Gems::properties(const std::vector<double>& T, const std::vector<double>& P, const std::vector<Vector>& n) -> std::vector<ChemicalProperties>
+{
+    throwGemsNotBuiltError();
+    return {};
+}
+
 auto Gems::equilibrate(double T, double P, const Vector& b) -> void
 {
     throwGemsNotBuiltError();
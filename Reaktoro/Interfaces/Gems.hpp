@@ -17,6 +17,9 @@
 
 #pragma once
 
+// C++ includes
+#include <vector>
+
 // Reaktoro includes
 #include <Reaktoro/Interfaces/Interface.hpp>
 
@@ -25,6 +28,10 @@ class TNode;
 
 namespace Reaktoro {
 
+// Forward declarations
+class ChemicalProperties;
+class ThermoProperties;
+
 /// A type that describes the options for Gems
 struct GemsOptions
 {
@@ -32,7 +39,15 @@ struct GemsOptions
     bool warmstart = true;
 };
 
-/// A wrapper class for Gems code
+/// A wrapper class for Gems code.
+/// Every thread using a Gems instance, either directly or through a ChemicalSystem created
+/// from it, works with its own TNode instance of Gems. The thread that constructed the Gems
+/// instance uses the TNode instance initialized in the constructor. Every other thread uses a
+/// TNode instance initialized from the same specification file the first time it is needed,
+/// and reused by later threads once the thread that used it exits. The state of the Gems
+/// instance (temperature, pressure, amounts of species, and result of @ref equilibrate) is
+/// thus specific to each thread. The standard thermodynamic properties of the species are
+/// cached for the last temperature and pressure of each TNode instance.
 class Gems : public Interface
 {
 public:
@@ -105,6 +120,27 @@ public:
     /// Set the options of the Gems instance
     auto setOptions(const GemsOptions& options) -> void;
 
+    /// Set the number of threads used for the batched property calculations.
+    /// The worker threads are created in the next batched property calculation and kept
+    /// alive, together with their TNode instances, until this number changes.
+    auto setNumThreads(Index nthreads) -> void;
+
+    /// Return the number of threads used for the batched property calculations.
+    auto numThreads() const -> Index;
+
+    /// Return the thermodynamic properties of the system at many temperatures and pressures.
+    /// The calculations are distributed among the threads set with @ref setNumThreads.
+    /// @param T The temperatures (in units of K)
+    /// @param P The pressures (in units of Pa)
+    auto properties(const std::vector<double>& T, const std::vector<double>& P) -> std::vector<ThermoProperties>;
+
+    /// Return the chemical properties of the system at many states.
+    /// The calculations are distributed among the threads set with @ref setNumThreads.
+    /// @param T The temperatures (in units of K)
+    /// @param P The pressures (in units of Pa)
+    /// @param n The compositions of the species (in units of mol)
+    auto properties(const std::vector<double>& T, const std::vector<double>& P, const std::vector<Vector>& n) -> std::vector<ChemicalProperties>;
+
     /// Calculate the equilibrium state of the system
     /// @param T The temperature for the equilibrium calculation (in units of K)
     /// @param P The pressure for the equilibrium calculation (in units of Pa)
@@ -120,10 +156,12 @@ public:
     /// Return the wall time of the equilibrium calculation (in units of s)
     auto elapsedTime() const -> double;
 
-    /// Return a reference to the TNode instance of Gems
+    /// Return a reference to the TNode instance of Gems used by the current thread.
+    /// The cached standard thermodynamic properties of the TNode instance are discarded,
+    /// since the caller may change it.
     auto node() -> TNode&;
 
-    /// Return a const reference to the TNode instance of Gems
+    /// Return a const reference to the TNode instance of Gems used by the current thread
     auto node() const -> const TNode&;
 
 private:
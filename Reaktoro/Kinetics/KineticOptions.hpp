@@ -19,15 +19,57 @@
 
 // Reaktoro includes
 #include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
+#include <Reaktoro/Math/DaeSolver.hpp>
 #include <Reaktoro/Math/ODE.hpp>
 
 namespace Reaktoro {
 
+/// A struct to describe the options for the output of a chemical kinetics calculation.
+/// These options control the states of a KineticPath calculation that are sent to its
+/// ChemicalOutput and ChemicalPlot instances. By default, every accepted time step is
+/// output. The initial and final states are always output.
+/// @see KineticPath
 struct KineticOutputOptions
 {
     bool active = false;
 
     std::string format;
+
+    /// The time interval between the outputs (in units of s).
+    /// If positive, the states are output at the fixed times `t0 + k*interval`, which are
+    /// interpolated from the dense output of the ODE solver, instead of at every time step.
+    /// With KineticMethod::DAE, the time steps are shortened to end at these times instead.
+    double interval = 0.0;
+
+    /// The relative change in the amounts of the equilibrium elements and kinetic species that triggers an output.
+    /// If positive, a state is output only when one of these amounts has changed by more
+    /// than this fraction since the last output. These amounts are computed from the
+    /// species amounts only, without evaluating the chemical properties of the system.
+    double tolerance = 0.0;
+
+    /// The flag that indicates if the states at events are output.
+    /// The events are the appearance or disappearance of a phase, and the reversal of
+    /// the direction of change of a kinetic species (e.g., a mineral changing from
+    /// dissolution to precipitation as its saturation index crosses zero). They are
+    /// detected at the first time step after they occur.
+    bool events = false;
+};
+
+/// The methods for coupling the equilibrium and kinetic species in chemical kinetics calculations
+enum class KineticMethod
+{
+    /// The element amounts in the equilibrium species and the amounts of the kinetic
+    /// species are integrated as ordinary differential equations, with a complete
+    /// equilibrium calculation at every evaluation of their right-hand side function.
+    Nested,
+
+    /// The amounts of the equilibrium species and the element potentials are appended
+    /// as algebraic unknowns to the kinetic equations, with the equilibrium conditions
+    /// as algebraic equations, and the resulting index-1 differential-algebraic
+    /// equations are integrated without equilibrium calculations. The steps in which
+    /// the algebraic equations cannot be solved (e.g., when an element enters the
+    /// equilibrium partition) are performed with the nested method instead.
+    DAE,
 };
 
 /// A struct to describe the options for a chemical kinetics calculation.
@@ -37,9 +79,15 @@ struct KineticOptions
     /// The options for the equilibrium solver.
     EquilibriumOptions equilibrium;
 
-    /// The options for the ODE solver.
+    /// The method used to couple the equilibrium and kinetic species.
+    KineticMethod method = KineticMethod::Nested;
+
+    /// The options for the ODE solver used with KineticMethod::Nested.
     ODEOptions ode;
 
+    /// The options for the DAE solver used with KineticMethod::DAE.
+    DaeOptions dae;
+
     /// The options for the output of the chemical kinetics calculation
     KineticOutputOptions output;
 };
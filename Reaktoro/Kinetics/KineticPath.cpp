@@ -17,6 +17,9 @@
 
 #include "KineticPath.hpp"
 
+// C++ includes
+#include <algorithm>
+
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
 #include <Reaktoro/Common/Units.hpp>
@@ -29,8 +32,18 @@
 #include <Reaktoro/Kinetics/KineticOptions.hpp>
 #include <Reaktoro/Kinetics/KineticSolver.hpp>
 #include <Reaktoro/Kinetics/KineticState.hpp>
+#include <Reaktoro/Math/MathUtils.hpp>
 
 namespace Reaktoro {
+namespace {
+
+/// The fraction of the total amount of species below which an amount is considered negligible
+const double negligible_amount_fraction = 1e-10;
+
+/// The relative change in the amount of a kinetic species below which its direction of change is not updated
+const double direction_change_threshold = 1e-10;
+
+} // namespace
 
 struct KineticPath::Impl
 {
@@ -55,10 +68,22 @@ struct KineticPath::Impl
     /// The plots of the kinetic path calculation
     std::vector<ChemicalPlot> plots;
 
+    /// The amounts of the equilibrium elements and kinetic species at the last output
+    Vector tracked_output;
+
+    /// The amounts of the kinetic species at the previous time step
+    Vector nk_previous;
+
+    /// The directions of change (-1, 0, or +1) of the amounts of the kinetic species
+    Vector nk_directions;
+
+    /// The flags that indicate the phases present at the previous time step
+    std::vector<bool> phases_present;
+
     Impl(const ReactionSystem& reactions)
-    : reactions(reactions), system(reactions.system()), solver(reactions)
+    : reactions(reactions), system(reactions.system()), partition(system), solver(reactions)
     {
-        solver.setPartition(Partition(system));
+        solver.setPartition(partition);
     }
 
     auto setOptions(const KineticOptions& options_) -> void
@@ -70,11 +95,93 @@ struct KineticPath::Impl
         solver.setOptions(options);
     }
 
-    auto setPartition(const Partition& partition) -> void
+    auto setPartition(const Partition& partition_) -> void
     {
+        partition = partition_;
         solver.setPartition(partition);
     }
 
+    /// Return the amounts of the equilibrium elements and kinetic species in a chemical state
+    auto trackedAmounts(const ChemicalState& state) const -> Vector
+    {
+        const Vector& n = state.speciesAmounts();
+        const Matrix& Ae = partition.formulaMatrixEquilibriumPartition();
+        const Indices& ies = partition.indicesEquilibriumSpecies();
+        const Indices& iks = partition.indicesKineticSpecies();
+        Vector u(Ae.rows() + iks.size());
+        rows(u, 0, Ae.rows()) = Ae * rows(n, ies);
+        rows(u, Ae.rows(), iks.size()) = rows(n, iks);
+        return u;
+    }
+
+    /// Return the flags that indicate the phases present in a chemical state
+    auto phasesPresent(const ChemicalState& state) const -> std::vector<bool>
+    {
+        const double threshold = negligible_amount_fraction * state.speciesAmounts().sum();
+        std::vector<bool> present(system.numPhases());
+        for(Index i = 0; i < present.size(); ++i)
+            present[i] = state.phaseAmount(i) > threshold;
+        return present;
+    }
+
+    /// Initialize the quantities used to detect the events in the kinetic path
+    auto initializeEvents(const ChemicalState& state) -> void
+    {
+        nk_previous = rows(state.speciesAmounts(), partition.indicesKineticSpecies());
+        nk_directions = zeros(nk_previous.size());
+        phases_present = phasesPresent(state);
+    }
+
+    /// Return true if an event occurred in the last time step
+    auto eventOccurred(const ChemicalState& state) -> bool
+    {
+        bool event = false;
+
+        // Check if a phase appeared or disappeared
+        const std::vector<bool> present = phasesPresent(state);
+        event = present != phases_present;
+        phases_present = present;
+
+        // Check if the direction of change of the amount of a kinetic species was reversed
+        const Vector nk = rows(state.speciesAmounts(), partition.indicesKineticSpecies());
+        for(unsigned i = 0; i < nk.rows(); ++i)
+        {
+            const double delta = nk[i] - nk_previous[i];
+            if(std::abs(delta) <= direction_change_threshold * std::abs(nk_previous[i]))
+                continue;
+            const double direction = delta > 0.0 ? 1.0 : -1.0;
+            event = event || nk_directions[i] * direction < 0.0;
+            nk_directions[i] = direction;
+        }
+        nk_previous = nk;
+
+        return event;
+    }
+
+    /// Return true if the tracked amounts changed more than the output tolerance since the last output
+    auto changedSinceOutput(const ChemicalState& state) const -> bool
+    {
+        const Vector u = trackedAmounts(state);
+        const double tolerance = options.output.tolerance;
+        const double threshold = negligible_amount_fraction * state.speciesAmounts().sum();
+        const Vector scale = u.array().abs().max(tracked_output.array().abs()).max(threshold);
+        return ((u - tracked_output).array().abs() > tolerance * scale.array()).any();
+    }
+
+    /// Update the output and plots with a chemical state
+    auto update(const ChemicalState& state, double t) -> void
+    {
+        // Update the output with current state
+        if(output) output.update(state, t);
+
+        // Update the plots with current state
+        for(auto& plot : plots) plot.update(state, t);
+
+        // Store the tracked amounts at this output
+        if(options.output.tolerance > 0.0)
+            tracked_output = trackedAmounts(state);
+    }
+
     auto solve(KineticState& state, double t0, double t1, std::string units) -> void
     {
         t0 = units::convert(t0, units, "s");
@@ -83,29 +190,51 @@ struct KineticPath::Impl
 
         double t = t0;
 
+        // The options that control which states are output
+        const KineticOutputOptions& policy = options.output;
+
+        // Check if every time step is output
+        const bool every_step = policy.interval <= 0.0 && policy.tolerance <= 0.0 && !policy.events;
+
+        // The next fixed output time, if output is done at fixed times
+        Index ioutput = 1;
+        double toutput = policy.interval > 0.0 ? t0 + policy.interval : t1;
+
         // Initialize the output of the equilibrium path calculation
         if(output) output.open();
 
         // Initialize the plots of the equilibrium path calculation
         for(auto& plot : plots) plot.open();
 
+        // Update the output and plots with the initial state
+        update(state, t);
+
+        // Initialize the detection of events
+        if(policy.events) initializeEvents(state);
+
         while(t < t1)
         {
-            // Update the output with current state
-            if(output) output.update(state, t);
+            // Integrate one time step only, not going over the next fixed output time
+            solver.step(state, t, std::min(toutput, t1));
 
-            // Update the plots with current state
-            for(auto& plot : plots) plot.update(state, t);
+            // Check if the current state should be output
+            bool due = every_step || t >= t1;
 
-            // Integrate one time step only
-            solver.step(state, t, t1);
-        }
+            if(policy.interval > 0.0 && t >= toutput)
+            {
+                due = true;
+                toutput = t0 + (++ioutput) * policy.interval;
+            }
 
-        // Update the output with the final state
-        if(output) output.update(state, t1);
+            if(policy.events && eventOccurred(state))
+                due = true;
 
-        // Update the plots with the final state
-        for(auto& plot : plots) plot.update(state, t1);
+            if(policy.tolerance > 0.0 && !due && changedSinceOutput(state))
+                due = true;
+
+            // Update the output and plots with the current state
+            if(due) update(state, t);
+        }
     }
 };
 
@@ -19,11 +19,14 @@
 
 // C++ includes
 #include <functional>
+#include <limits>
 using namespace std::placeholders;
 
 // Reaktoro includes
 #include <Reaktoro/Common/ChemicalVector.hpp>
+#include <Reaktoro/Common/Constants.hpp>
 #include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Profiling.hpp>
 #include <Reaktoro/Math/Matrix.hpp>
 #include <Reaktoro/Common/StringUtils.hpp>
 #include <Reaktoro/Common/Units.hpp>
@@ -39,6 +42,9 @@ using namespace std::placeholders;
 #include <Reaktoro/Kinetics/KineticOptions.hpp>
 #include <Reaktoro/Kinetics/KineticProblem.hpp>
 #include <Reaktoro/Kinetics/KineticState.hpp>
+#include <Reaktoro/Math/Eigen/LU>
+#include <Reaktoro/Math/Eigen/SVD>
+#include <Reaktoro/Math/MathUtils.hpp>
 #include <Reaktoro/Thermodynamics/Water/WaterConstants.hpp>
 
 namespace Reaktoro {
@@ -66,6 +72,9 @@ struct KineticSolver::Impl
     /// The ODE solver instance
     ODESolver ode;
 
+    /// The DAE solver instance used with KineticMethod::DAE
+    DaeSolver dae;
+
     /// The indices of the equilibrium and kinetic species
     Indices ies, iks;
 
@@ -81,6 +90,15 @@ struct KineticSolver::Impl
     /// The formula matrix of the equilibrium species
     Matrix Ae;
 
+    /// The indices of the linearly independent rows of the formula matrix of the equilibrium species
+    Indices ili;
+
+    /// The linearly independent rows of the formula matrix of the equilibrium species
+    Matrix Ar;
+
+    /// The number of linearly independent rows of the formula matrix of the equilibrium species
+    Index Er;
+
     /// The stoichiometric matrix w.r.t. the equilibrium species
     Matrix Se;
 
@@ -111,9 +129,32 @@ struct KineticSolver::Impl
     /// The combined vector of elemental molar abundance and composition of kinetic species [be nk]
     Vector benk;
 
+    /// The unknowns [be nk x y] of the DAE formulation, with `x = ln(ne)` and `y`
+    /// the dual potentials of the linearly independent elements divided by RT
+    Vector w;
+
+    /// The parameter of the logarithmic barrier that keeps the amounts of the
+    /// equilibrium species positive in the DAE formulation
+    double epsilon;
+
+    /// The boolean flag that indicates if the DAE solver is currently used in the integration steps
+    bool dae_active = false;
+
+    /// The number of nested steps to perform before the DAE solver is restarted
+    unsigned dae_restart_delay = 1;
+
+    /// The number of nested steps remaining before the DAE solver is restarted
+    unsigned dae_restart_countdown = 0;
+
     /// The chemical properties of the system
     ChemicalProperties properties;
 
+    /// The standard Gibbs energies of the species at (T,P) divided by RT
+    ThermoVector G0;
+
+    /// The chemical potentials of the species divided by RT
+    ChemicalVector u;
+
     /// The vector with the values of the reaction rates
     ChemicalVector r;
 
@@ -171,6 +212,11 @@ struct KineticSolver::Impl
         // Initialise the formula matrix of the equilibrium partition
         Ae = partition.formulaMatrixEquilibriumPartition();
 
+        // Initialise the linearly independent rows of the formula matrix of the equilibrium partition
+        ili = linearlyIndependentRows(Ae);
+        Ar = rows(Ae, ili);
+        Er = ili.size();
+
         // Initialise the stoichiometric matrices w.r.t. the equilibrium and kinetic species
         Se = cols(reactions.stoichiometricMatrix(), ies);
         Sk = cols(reactions.stoichiometricMatrix(), iks);
@@ -289,6 +335,11 @@ struct KineticSolver::Impl
         T = state.temperature();
         P = state.pressure();
 
+        // Initialise the thermodynamic properties of the system at (T,P), which
+        // are reused in every evaluation of the ODE function below
+        properties = ChemicalProperties(system);
+        properties.update(T, P);
+
         // Extract the composition of the equilibrium and kinetic species
         const Vector& n = state.speciesAmounts();
         ne = rows(n, ies);
@@ -299,6 +350,9 @@ struct KineticSolver::Impl
         rows(benk,  0, Ee) = Ae * ne;
         rows(benk, Ee, Nk) = nk;
 
+        // Set the options of the equilibrium solver
+        equilibrium.setOptions(options.equilibrium);
+
         // Define the ODE function
         ODEFunction ode_function = [&](double t, const Vector& u, Vector& res)
         {
@@ -325,8 +379,233 @@ struct KineticSolver::Impl
         ode.setOptions(options_ode);
         ode.initialize(tstart, benk);
 
-        // Set the options of the equilibrium solver
-        equilibrium.setOptions(options.equilibrium);
+        // Initialise the DAE solver if the DAE formulation is used, which falls back
+        // to the nested formulation above whenever its algebraic equations cannot be solved
+        if(options.method == KineticMethod::DAE)
+        {
+            dae_restart_delay = 1;
+            initializeDae(state, tstart);
+        }
+    }
+
+    /// Return the logarithm of the amount of a species that solves `d*x + a = epsilon*exp(-x)`.
+    /// This is the optimality condition of an equilibrium species with fixed element potentials,
+    /// where `d` is the derivative of its chemical potential with respect to `x`.
+    auto seat(double a, double d, double x) const -> double
+    {
+        if(d <= 1e-12)
+            return a > 0.0 ? std::log(epsilon/a) : x;
+
+        // Solve s*exp(s) = (epsilon/d)*exp(a/d) with s = x + a/d in terms of t = ln(s),
+        // and recover x = ln(epsilon/(d*s)) without cancellation errors
+        const double L = std::log(epsilon/d) + a/d;
+        double t = L > 1.0 ? std::log(L) : L - 1.0;
+        for(unsigned i = 0; i < 100; ++i)
+        {
+            const double et = std::exp(t);
+            const double dt = (et + t - L)/(et + 1.0);
+            t -= dt;
+            if(std::abs(dt) < 1e-14*std::max(1.0, std::abs(t)))
+                break;
+        }
+        return std::log(epsilon/d) - t;
+    }
+
+    auto initializeDae(KineticState& state, double tstart) -> void
+    {
+        // Initialise the normalized standard Gibbs energies of the species at (T,P)
+        G0 = properties.standardPartialMolarGibbsEnergies()/(universalGasConstant*T);
+
+        // Initialise the lower bound of the equilibrium species as in the equilibrium calculations
+        epsilon = options.equilibrium.epsilon;
+
+        // Solve the equilibrium problem once to obtain initial values of the algebraic unknowns
+        be = rows(benk, 0, Ee);
+        auto result = equilibrium.solve(state, T, P, be);
+
+        // Start the DAE solver from the equilibrium state, or use nested steps if the calculation failed
+        if(result.optimum.succeeded)
+            restartDae(state, tstart);
+        else
+            deactivateDae(tstart);
+    }
+
+    auto deactivateDae(double t) -> void
+    {
+        // Perform the next steps with the nested formulation, which is restarted at `t`
+        dae_active = false;
+        dae_restart_countdown = dae_restart_delay;
+        dae_restart_delay = std::min(2*dae_restart_delay, 64u);
+        ode.initialize(t, benk);
+    }
+
+    auto restartDae(KineticState& state, double tstart) -> void
+    {
+        // The RT factor and the number of unknowns in the DAE formulation
+        const double RT = universalGasConstant*T;
+        const Index size = Ee + Nk + Ne + Er;
+
+        // The index of the first algebraic unknown and the number of algebraic unknowns
+        const Index ia = Ee + Nk;
+        const Index Na = Ne + Er;
+
+        // The amounts of the species in the equilibrium state, restored if the DAE solver cannot be started
+        const Vector n = state.speciesAmounts();
+
+        // Set the amounts of the equilibrium species from the equilibrium state, which are not smaller than `epsilon`
+        ne = rows(n, ies);
+        nk = rows(n, iks);
+        for(Index i = 0; i < Ne; ++i)
+            ne[i] = std::max(ne[i], epsilon);
+
+        // Assemble the vector w = [be nk x y]
+        w.resize(size);
+        rows(w, 0, Ee) = Ae * ne;
+        rows(w, Ee, Nk) = nk;
+        rows(w, ia, Ne) = log(ne);
+        rows(w, ia + Ne, Er) = rows(Vector(rows(state.elementDualPotentials(), iee)), ili)/RT;
+
+        Vector wdot = zeros(size);
+        Vector F(size);
+        Matrix J(size, size);
+
+        // The dual potentials of the elements whose species are all at the lower bound
+        // are not determined by the equilibrium calculation, so estimate them by
+        // least-squares from the optimality conditions of these species
+        Indices iabsent, itrace;
+        for(Index j = 0; j < Er; ++j)
+        {
+            bool absent = true;
+            for(Index i = 0; i < Ne && absent; ++i)
+                absent = Ar(j, i) == 0.0 || ne[i] <= 2*epsilon;
+            if(absent) iabsent.push_back(j);
+        }
+        for(Index i = 0; i < Ne; ++i)
+            for(Index j : iabsent)
+                if(Ar(j, i) != 0.0) { itrace.push_back(i); break; }
+        if(iabsent.size() && daeFunction(state, tstart, w, wdot, F) == 0)
+        {
+            Vector r(itrace.size());
+            for(Index k = 0; k < itrace.size(); ++k)
+                r[k] = F[ia + itrace[k]];
+            const Matrix At = tr(submatrix(Ar, iabsent, itrace));
+            const Vector dy = At.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(r);
+            for(Index k = 0; k < iabsent.size(); ++k)
+                w[ia + Ne + iabsent[k]] += dy[k];
+        }
+
+        // Correct the algebraic unknowns so that they are consistent with the algebraic
+        // equations of the DAE formulation. Each iteration first solves the optimality
+        // condition of every equilibrium species with fixed element potentials, and then
+        // performs a damped Newton step on all algebraic unknowns
+        bool converged = false;
+        for(unsigned i = 0; i < 50; ++i)
+        {
+            if(daeFunction(state, tstart, w, wdot, F)) break;
+            daeJacobian(state, tstart, w, wdot, 0.0, J);
+            for(Index k = 0; k < Ne; ++k)
+            {
+                const Index ik = ia + k;
+                const double barrier = epsilon*std::exp(-w[ik]);
+                const double d = std::max(J(ik, ik) - barrier, 0.0);
+                const double a = F[ik] + barrier - d*w[ik];
+                w[ik] = seat(a, d, w[ik]);
+            }
+            if(daeFunction(state, tstart, w, wdot, F)) break;
+            converged = rows(F, ia, Na).lpNorm<Eigen::Infinity>() < 1e-10;
+            if(converged) break;
+            daeJacobian(state, tstart, w, wdot, 0.0, J);
+            const Vector dw = Eigen::PartialPivLU<Matrix>(J.bottomRightCorner(Na, Na)).solve(-rows(F, ia, Na));
+            const double dxmax = rows(dw, 0, Ne).lpNorm<Eigen::Infinity>();
+            rows(w, ia, Na) += std::min(1.0, 10.0/dxmax) * dw;
+        }
+
+        // Use nested steps if the consistent algebraic unknowns could not be calculated
+        if(!converged)
+        {
+            state.setSpeciesAmounts(n);
+            deactivateDae(tstart);
+            return;
+        }
+
+        // Calculate the initial rates of the differential unknowns
+        daeFunction(state, tstart, w, wdot, F);
+        rows(wdot, 0, Ee + Nk) = -rows(F, 0, Ee + Nk);
+
+        // Define the DAE residual function and its Jacobian
+        DaeFunction dae_function = [&](double t, const Vector& w, const Vector& wdot, Vector& res)
+        {
+            return daeFunction(state, t, w, wdot, res);
+        };
+
+        DaeJacobian dae_jacobian = [&](double t, const Vector& w, const Vector& wdot, double alpha, Matrix& res)
+        {
+            return daeJacobian(state, t, w, wdot, alpha, res);
+        };
+
+        // Initialise the DAE problem
+        DaeProblem problem;
+        problem.setNumEquations(size);
+        problem.setFunction(dae_function);
+        problem.setJacobian(dae_jacobian);
+
+        // Exclude the algebraic unknowns from the local error test
+        DaeOptions options_dae = options.dae;
+        for(Index i = Ee + Nk; i < size; ++i)
+            options_dae.algebraic.push_back(i);
+
+        // Limit the change of the logarithms of the amounts of the equilibrium species
+        // in each Newton iteration, since they can change by orders of magnitude
+        // when an element enters the equilibrium partition
+        if(options_dae.newton_step_bounds.size() == 0)
+        {
+            options_dae.newton_step_bounds.setConstant(size, std::numeric_limits<double>::infinity());
+            rows(options_dae.newton_step_bounds, Ee + Nk, Ne).fill(5.0);
+        }
+
+        // Apply the tolerances of the equilibrium species to their amounts rather than to the
+        // logarithms of their amounts, so that the convergence of the Newton method is not held
+        // back by species in trace amounts (e.g., O2(aq) and H2(aq) in most aqueous solutions)
+        for(Index i = ia; i < ia + Ne; ++i)
+            options_dae.logarithmic.push_back(i);
+
+        // Use a loose absolute tolerance for the element potentials in the convergence test of
+        // the Newton method, since some of their combinations (e.g., the redox potential) are
+        // determined only by species in trace amounts and change much in each iteration
+        if(options_dae.abstols.size() == 0)
+        {
+            options_dae.abstols.setConstant(size, options_dae.abstol);
+            rows(options_dae.abstols, ia + Ne, Er).fill(1.0);
+        }
+
+        // Set the DAE problem and initialize the DAE solver
+        dae.setProblem(problem);
+        dae.setOptions(options_dae);
+        dae.initialize(tstart, w, wdot);
+        dae_active = true;
+    }
+
+    auto updateStateDae(KineticState& state) -> void
+    {
+        const double RT = universalGasConstant*T;
+
+        // Extract the `be`, `nk` and `ne` entries of the vector `w`
+        be = rows(w, 0, Ee);
+        nk = rows(w, Ee, Nk);
+        ne = exp(rows(w, Ee + Nk, Ne));
+
+        // Update the composition of the kinetic and equilibrium species
+        state.setSpeciesAmounts(nk, iks);
+        state.setSpeciesAmounts(ne, ies);
+
+        // Update the dual potentials of the elements and species (in units of J/mol)
+        Vector y = zeros(system.numElements());
+        for(Index j = 0; j < Er; ++j)
+            y[iee[ili[j]]] = w[Ee + Nk + Ne + j] * RT;
+        Vector z = zeros(system.numSpecies());
+        rows(z, ies) = RT*epsilon*inv(ne);
+        state.setElementDualPotentials(y);
+        state.setSpeciesDualPotentials(z);
     }
 
     auto step(KineticState& state, double& t) -> void
@@ -337,8 +616,10 @@ struct KineticSolver::Impl
 
     auto step(KineticState& state, double& t, double tfinal) -> void
     {
+        ProfileScope("KineticSolver::step");
+
         // Extract the composition vector of the equilibrium and kinetic species
-        const Vector& n = state.speciesAmounts();
+        const Vector n = state.speciesAmounts();
         ne = rows(n, ies);
         nk = rows(n, iks);
 
@@ -346,6 +627,23 @@ struct KineticSolver::Impl
         rows(benk,  0, Ee) = Ae * ne;
         rows(benk, Ee, Nk) = nk;
 
+        // Perform one DAE step integration if the DAE formulation is used, or fall back
+        // to a nested step if its algebraic equations could not be solved (e.g., when
+        // the amounts of the species of an element grow by many orders of magnitude)
+        if(options.method == KineticMethod::DAE && dae_active)
+        {
+            const double tstart = t;
+            try {
+                dae.integrate(t, w, tfinal);
+                updateStateDae(state);
+                return;
+            } catch(const std::runtime_error&) {
+                t = tstart;
+                state.setSpeciesAmounts(n);
+                deactivateDae(t);
+            }
+        }
+
         // Perform one ODE step integration
         ode.integrate(t, benk, tfinal);
 
@@ -358,13 +656,33 @@ struct KineticSolver::Impl
 
         // Update the composition of the equilibrium species
         equilibrium.solve(state, T, P, be);
+
+        // Restart the DAE solver from the new equilibrium state after the scheduled number of nested steps
+        if(options.method == KineticMethod::DAE && --dae_restart_countdown == 0)
+            restartDae(state, t);
     }
 
     auto solve(KineticState& state, double t, double dt) -> void
     {
+        ProfileScope("KineticSolver::solve");
+
         // Initialise the chemical kinetics solver
         initialize(state, t);
 
+        // Integrate the chemical kinetics DAE from `t` to `t + dt` if the DAE formulation is used
+        if(options.method == KineticMethod::DAE)
+        {
+            const double tfinal = t + dt;
+            for(unsigned i = 0; t < tfinal; ++i)
+            {
+                Assert(i < options.dae.max_num_steps,
+                    "Could not integrate the chemical kinetics equations.",
+                    "The maximum number of steps was reached.");
+                step(state, t, tfinal);
+            }
+            return;
+        }
+
         // Integrate the chemical kinetics ODE from `t` to `t + dt`
         ode.solve(t, dt, benk);
 
@@ -408,11 +726,14 @@ struct KineticSolver::Impl
             "Could not calculate the rates of the species.",
             "The equilibrium calculation failed.");
 
-        // Update the chemical properties of the system
-        properties = state.properties();
+        // Update the chemical properties of the system at the fixed (T,P)
+        properties.update(state.speciesAmounts());
 
         // Calculate the kinetic rates of the reactions
-        r = reactions.rates(properties);
+        {
+            ProfileScope("KineticSolver::rates");
+            r = reactions.rates(properties);
+        }
 
         // Calculate the right-hand side function of the ODE
         res = A * r.val;
@@ -432,6 +753,8 @@ struct KineticSolver::Impl
 
     auto jacobian(KineticState& state, double t, const Vector& u, Matrix& res) -> int
     {
+        ProfileScope("KineticSolver::jacobian");
+
         // Calculate the sensitivity of the equilibrium state
         sensitivity = equilibrium.sensitivity();
 
@@ -467,6 +790,105 @@ struct KineticSolver::Impl
 
         return 0;
     }
+
+    auto daeFunction(KineticState& state, double t, const Vector& w, const Vector& wdot, Vector& res) -> int
+    {
+        // Check for non-finite values in the vector `w`
+        for(int i = 0; i < w.rows(); ++i)
+            if(!std::isfinite(w[i]))
+                return 1; // ensure the dae solver will reduce the time step
+
+        // Extract the `be`, `nk`, `ne` and `y` entries of the vector [be nk x y]
+        be = rows(w, 0, Ee);
+        nk = rows(w, Ee, Nk);
+        ne = exp(rows(w, Ee + Nk, Ne));
+        const auto y = rows(w, Ee + Nk + Ne, Er);
+
+        // Check for overflow in the amounts of the equilibrium species
+        for(Index i = 0; i < Ne; ++i)
+            if(!std::isfinite(ne[i]))
+                return 1;
+
+        // Update the composition of the kinetic and equilibrium species in the member `state`
+        state.setSpeciesAmounts(nk, iks);
+        state.setSpeciesAmounts(ne, ies);
+
+        // Update the chemical properties of the system at the fixed (T,P)
+        properties.update(state.speciesAmounts());
+
+        // Calculate the kinetic rates of the reactions
+        {
+            ProfileScope("KineticSolver::rates");
+            r = reactions.rates(properties);
+        }
+
+        // Calculate the normalized chemical potentials of the species
+        u = G0 + properties.lnActivities();
+
+        res.resize(Ee + Nk + Ne + Er);
+
+        // Calculate the residual of the kinetic equations
+        rows(res, 0, Ee + Nk) = rows(wdot, 0, Ee + Nk) - A * r.val;
+
+        // Add the residual contribution from the source rates
+        if(source_fn)
+        {
+            q = source_fn(properties);
+            rows(res, 0, Ee + Nk) -= B * q.val;
+        }
+
+        // Calculate the residual of the optimality conditions of the equilibrium species,
+        // whose bounds are imposed with a logarithmic barrier as in the equilibrium solver
+        rows(res, Ee + Nk, Ne) = rows(u.val, ies) - tr(Ar)*y - epsilon*inv(ne);
+
+        // Calculate the residual of the mass balance of the equilibrium species
+        rows(res, Ee + Nk + Ne, Er) = Ar*ne - rows(be, ili);
+
+        return 0;
+    }
+
+    auto daeJacobian(KineticState& state, double t, const Vector& w, const Vector& wdot, double alpha, Matrix& res) -> int
+    {
+        ProfileScope("KineticSolver::jacobian");
+
+        // The offsets of the blocks of unknowns `nk`, `x` and `y` in the vector [be nk x y]
+        const Index ik = Ee;
+        const Index ix = Ee + Nk;
+        const Index iy = Ee + Nk + Ne;
+
+        res = zeros(iy + Er, iy + Er);
+
+        // Extract the columns of the kinetic rates derivatives w.r.t. the equilibrium and kinetic species
+        drdne = cols(r.ddn, ies);
+        drdnk = cols(r.ddn, iks);
+
+        // Assemble the Jacobian of the kinetic equations, with dne/dx = diag(ne)
+        res.topLeftCorner(ix, ix).diagonal().fill(alpha);
+        res.block(0, ik, ix, Nk) -= A * drdnk;
+        res.block(0, ix, ix, Ne) = -A * drdne * diag(ne);
+
+        // Add the Jacobian contribution from the source rates
+        if(source_fn)
+        {
+            dqdne = cols(q.ddn, ies);
+            dqdnk = cols(q.ddn, iks);
+            res.block(0, ik, ix, Nk) -= B * dqdnk;
+            res.block(0, ix, ix, Ne) -= B * dqdne * diag(ne);
+        }
+
+        // Assemble the Jacobian of the optimality conditions of the equilibrium species
+        res.block(ix, ik, Ne, Nk) = submatrix(u.ddn, ies, iks);
+        res.block(ix, ix, Ne, Ne) = submatrix(u.ddn, ies, ies) * diag(ne);
+        res.block(ix, ix, Ne, Ne).diagonal() += epsilon*inv(ne);
+        res.block(ix, iy, Ne, Er) = -tr(Ar);
+
+        // Assemble the Jacobian of the mass balance of the equilibrium species
+        res.block(iy, ix, Er, Ne) = Ar * diag(ne);
+        for(Index j = 0; j < Er; ++j)
+            res(iy + j, ili[j]) = -1.0;
+
+        return 0;
+    }
 };
 
 KineticSolver::KineticSolver()
@@ -17,21 +17,29 @@
 
 #include "DaeSolver.hpp"
 
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <string>
+
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Math/Eigen/LU>
 
 namespace Reaktoro {
 
 struct DaeProblem::Impl
 {
-    /// The number of ordinary differential equations
+    /// The number of differential-algebraic equations
     unsigned num_equations = 0;
 
-    /// The right-hand side function of the system of ordinary differential equations
-    DaeFunction ode_function;
+    /// The residual function of the system of differential-algebraic equations
+    DaeFunction dae_function;
 
-    /// The Jacobian of the right-hand side function of the system of ordinary differential equations
-    DaeJacobian ode_jacobian;
+    /// The Jacobian of the residual function of the system of differential-algebraic equations
+    DaeJacobian dae_jacobian;
 };
 
 struct DaeSolver::Impl
@@ -42,50 +50,320 @@ struct DaeSolver::Impl
     /// The options for the DAE integration
     DaeOptions options;
 
-    /// The auxiliary vector y
-    Vector y;
+    /// The times of the last accepted steps, with the most recent one at the back
+    std::deque<double> ts;
+
+    /// The values of the variables at the times of the last accepted steps
+    std::deque<Vector> ys;
+
+    /// The first-order derivatives of the variables at the start time
+    Vector ydot0;
+
+    /// The size of the next step
+    double h = 0.0;
+
+    /// The weights of the variables in the local error and Newton convergence tests
+    Vector weights;
+
+    /// The entries equal to one for the variables in the local error test, and zero otherwise
+    Vector errmask;
+
+    /// The auxiliary vectors y and ydot with the iterates of the Newton method
+    Vector y, ydot;
+
+    /// The auxiliary vector with the predicted values of the variables
+    Vector yp;
+
+    /// The auxiliary vector with the part of ydot that does not depend on the new values of the variables
+    Vector beta;
+
+    /// The auxiliary vectors f and faux for the function evaluation
+    Vector f, faux;
 
-    /// The auxiliary vector f for the function evaluation
-    Vector f;
+    /// The auxiliary vector with the Newton step
+    Vector dy;
+
+    /// The auxiliary vector with the inverse of the largest absolute entry in each row of the Jacobian
+    Vector rowscale;
 
     /// The auxiliary matrix J for the Jacobian evaluation
     Matrix J;
 
+    /// The LU decomposition of the Jacobian matrix
+    Eigen::PartialPivLU<Matrix> lu;
+
     /// Construct a default DaeSolver::Impl instance
     Impl()
     {}
 
-    ~Impl()
-    {
-    }
-
     /// Initializes the DAE solver
-    auto initialize(double tstart, const Vector& y) -> void
+    auto initialize(double tstart, const Vector& y0, const Vector& ydot0_) -> void
     {
-        // Check if the ordinary differential problem has been initialized
+        // Check if the differential-algebraic problem has been initialized
         Assert(problem.initialized(),
             "Cannot proceed with DaeSolver::initialize to initialize the solver.",
             "The provided DaeProblem instance was not properly initialized.");
 
         // Check if the dimension of 'y' matches the number of equations
-        Assert(y.size() == problem.numEquations(),
+        Assert(y0.size() == problem.numEquations(),
             "Cannot proceed with DaeSolver::initialize to initialize the solver.",
             "The dimension of the vector parameter `y` does not match the number of equations.");
+
+        // Check if the dimension of 'ydot' matches the number of equations
+        Assert(ydot0_.size() == problem.numEquations(),
+            "Cannot proceed with DaeSolver::initialize to initialize the solver.",
+            "The dimension of the vector parameter `ydot` does not match the number of equations.");
+
+        // Check if the maximum order of the BDF method is supported
+        Assert(options.max_order == 1 || options.max_order == 2,
+            "Cannot proceed with DaeSolver::initialize to initialize the solver.",
+            "The maximum order of the BDF method must be 1 or 2.");
+
+        // Initialise the history of the integration with the initial state
+        ts.assign(1, tstart);
+        ys.assign(1, y0);
+        ydot0 = ydot0_;
+
+        // Initialise the mask of the variables in the local error test
+        errmask = ones(y0.size());
+        for(Index i : options.algebraic)
+            errmask[i] = 0.0;
+
+        // Initialise the size of the first step, which is estimated from the
+        // initial derivatives if not given so that the first predicted
+        // change of the variables is a small fraction of the error tolerance
+        updateWeights(y0);
+        const double norm = wrms(ydot0, errmask);
+        h = options.initial_step;
+        if(h <= 0.0)
+            h = (norm > 0.0) ? 0.01/norm : 1e-6 * std::max(1.0, std::abs(tstart));
+        if(options.max_step > 0.0)
+            h = std::min(h, options.max_step);
     }
 
-    /// Integrate the DAE performing a single step.
-    auto integrate(double& t, Vector& y) -> void
+    /// Update the weights of the variables in the local error and Newton convergence tests
+    auto updateWeights(const Vector& yref) -> void
+    {
+        const Index n = yref.size();
+        weights.resize(n);
+        for(Index i = 0; i < n; ++i)
+        {
+            const double abstol = options.abstols.size() ? options.abstols[i] : options.abstol;
+            weights[i] = 1.0/(options.reltol * std::abs(yref[i]) + abstol);
+        }
+        for(Index i : options.logarithmic)
+        {
+            const double abstol = options.abstols.size() ? options.abstols[i] : options.abstol;
+            weights[i] = 1.0/(options.reltol + abstol * std::exp(-yref[i]));
+        }
+    }
+
+    /// Return the weighted root-mean-square norm of a vector, considering only the entries with unit mask
+    auto wrms(const Vector& v, const Vector& mask) const -> double
     {
+        const double count = mask.sum();
+        if(count == 0.0) return 0.0;
+        return std::sqrt((v.cwiseProduct(weights).cwiseProduct(mask)).squaredNorm()/count);
+    }
+
+    /// Evaluate the Jacobian `J = dF/dy + alpha*dF/dydot` at the current Newton iterate
+    auto jacobian(double t, double alpha) -> int
+    {
+        // Use the Jacobian function of the problem if available
+        if(problem.jacobian())
+            return problem.jacobian(t, y, ydot, alpha, J);
+
+        // Otherwise, approximate the Jacobian with forward finite differences
+        const Index n = y.size();
+        const double sqrteps = std::sqrt(std::numeric_limits<double>::epsilon());
+        J.resize(n, n);
+        for(Index j = 0; j < n; ++j)
+        {
+            const double yj = y[j];
+            const double ydotj = ydot[j];
+            const double delta = sqrteps * std::max(std::abs(yj), 1.0/weights[j]);
+            y[j] += delta;
+            ydot[j] += alpha * delta;
+            const int status = problem.function(t, y, ydot, faux);
+            y[j] = yj;
+            ydot[j] = ydotj;
+            if(status) return status;
+            J.col(j) = (faux - f)/delta;
+        }
+        return 0;
+    }
+
+    /// Solve the nonlinear equations `F(t, y, alpha*y + beta) = 0` with Newton's method starting from the predicted values
+    auto newton(double t, double alpha) -> bool
+    {
+        const Vector all = ones(yp.size());
+        y = yp;
+        for(unsigned m = 0; m < options.max_num_newton_iterations; ++m)
+        {
+            ydot = alpha*y + beta;
+            if(problem.function(t, y, ydot, f))
+                return false;
+            if(jacobian(t, alpha))
+                return false;
+            rowscale = J.cwiseAbs().rowwise().maxCoeff();
+            for(unsigned i = 0; i < rowscale.size(); ++i)
+                rowscale[i] = rowscale[i] > 0.0 ? 1.0/rowscale[i] : 1.0;
+            lu.compute(rowscale.asDiagonal() * J);
+            dy = lu.solve(-rowscale.cwiseProduct(f));
+            if(!dy.allFinite())
+                return false;
+            double scale = 1.0;
+            for(unsigned i = 0; i < options.newton_step_bounds.size(); ++i)
+                if(std::abs(dy[i]) > options.newton_step_bounds[i])
+                    scale = std::min(scale, options.newton_step_bounds[i]/std::abs(dy[i]));
+            y += scale*dy;
+            if(scale == 1.0 && wrms(dy, all) <= options.newton_tolerance)
+                return true;
+        }
+        return false;
     }
 
     /// Integrate the DAE performing a single step not going over a given time.
-    auto integrate(double& t, Vector& y, double tfinal) -> void
+    auto integrate(double& t, Vector& yout, double tfinal) -> void
     {
+        // Check if the solver has been initialized
+        Assert(!ts.empty(),
+            "Cannot proceed with DaeSolver::integrate to integrate the equations.",
+            "The solver has not been initialized with method DaeSolver::initialize.");
+
+        // Return immediately if the final time has already been reached
+        if(ts.back() >= tfinal)
+        {
+            t = ts.back();
+            yout = ys.back();
+            return;
+        }
+
+        unsigned failures = 0;
+
+        while(true)
+        {
+            // The history of the integration available for the BDF formula and the predictor
+            const Index size = ts.size();
+            const double tn = ts[size - 1];
+            const Vector& yn = ys[size - 1];
+
+            // The order of the BDF formula, which is limited by the number of previous steps
+            const unsigned k = std::min<unsigned>(options.max_order, std::max<Index>(size - 1, 1));
+
+            // The size of this step, which is limited so that tfinal is not passed and,
+            // for the second order formula, that the step ratio keeps it zero-stable
+            double hstep = h;
+            if(k == 2)
+                hstep = std::min(hstep, 2.0*(tn - ts[size - 2]));
+            if(options.max_step > 0.0)
+                hstep = std::min(hstep, options.max_step);
+            const bool clipped = tn + hstep >= tfinal;
+            if(clipped)
+                hstep = tfinal - tn;
+
+            const double tnew = clipped ? tfinal : tn + hstep;
+
+            // The coefficients of the BDF formula ydot = alpha*y + beta
+            double alpha = 0.0;
+            if(k == 1)
+            {
+                alpha = 1.0/hstep;
+                beta = -yn/hstep;
+            }
+            else
+            {
+                const double omega = hstep/(tn - ts[size - 2]);
+                alpha = (1 + 2*omega)/((1 + omega)*hstep);
+                beta = (-(1 + omega)*yn + omega*omega/(1 + omega)*ys[size - 2])/hstep;
+            }
+
+            // The predicted values of the variables and the ratio between the local error
+            // and the difference of the corrected and predicted values for constant steps
+            double C = 0.0;
+            if(size == 1)
+            {
+                yp = yn + hstep*ydot0;
+                C = 1.0/2.0;
+            }
+            else
+            {
+                // Extrapolate the polynomial that interpolates the last k + 1 steps
+                yp = zeros(yn.size());
+                for(Index i = size - k - 1; i < size; ++i)
+                {
+                    double li = 1.0;
+                    for(Index j = size - k - 1; j < size; ++j)
+                        if(j != i) li *= (tnew - ts[j])/(ts[i] - ts[j]);
+                    yp += li*ys[i];
+                }
+                C = (k == 1) ? 1.0/3.0 : 2.0/11.0;
+            }
+
+            // Solve the nonlinear equations of the BDF formula
+            updateWeights(yn);
+            const bool converged = newton(tnew, alpha);
+
+            // The normalized estimate of the local error
+            const double err = converged ? C*wrms(y - yp, errmask) : 0.0;
+
+            // Accept the step if the Newton method converged and the local error is small enough
+            if(converged && err <= 1.0)
+            {
+                ts.push_back(tnew);
+                ys.push_back(y);
+                while(ts.size() > options.max_order + 1)
+                {
+                    ts.pop_front();
+                    ys.pop_front();
+                }
+
+                const double factor = std::min(std::max(0.9*std::pow(std::max(err, 1e-10), -1.0/(k + 1)), 0.2), 2.0);
+                h = clipped ? std::max(h, hstep*factor) : hstep*factor;
+
+                t = tnew;
+                yout = y;
+                return;
+            }
+
+            // Otherwise, reduce the step size and, after repeated failures, the order of the BDF formula
+            ++failures;
+            if(converged)
+                h = hstep * std::min(std::max(0.9*std::pow(err, -1.0/(k + 1)), 0.1), 0.9);
+            else h = 0.25*hstep;
+
+            if(failures >= 2 && size > 2)
+            {
+                ts.erase(ts.begin(), ts.end() - 2);
+                ys.erase(ys.begin(), ys.end() - 2);
+            }
+
+            Assert(failures < options.max_num_failures && h > options.min_step && tn + h > tn,
+                "Could not integrate the differential-algebraic equations at t = " + std::to_string(tn) + ".",
+                "The Newton method or the local error test failed " + std::to_string(failures) + " "
+                "consecutive times or the step size became too small.");
+        }
+    }
+
+    /// Integrate the DAE performing a single step.
+    auto integrate(double& t, Vector& y) -> void
+    {
+        integrate(t, y, std::numeric_limits<double>::infinity());
     }
 
     /// Solve the DAE equations from a given start time to a final one.
     auto solve(double& t, double dt, Vector& y) -> void
     {
+        initialize(t, y, zeros(y.size()));
+
+        const double tfinal = t + dt;
+        for(unsigned i = 0; t < tfinal; ++i)
+        {
+            Assert(i < options.max_num_steps,
+                "Could not integrate the differential-algebraic equations up to t = " + std::to_string(tfinal) + ".",
+                "The maximum number of steps was reached.");
+            integrate(t, y, tfinal);
+        }
     }
 };
 
@@ -113,12 +391,12 @@ auto DaeProblem::setNumEquations(unsigned num) -> void
 
 auto DaeProblem::setFunction(const DaeFunction& f) -> void
 {
-    pimpl->ode_function = f;
+    pimpl->dae_function = f;
 }
 
 auto DaeProblem::setJacobian(const DaeJacobian& J) -> void
 {
-    pimpl->ode_jacobian = J;
+    pimpl->dae_jacobian = J;
 }
 
 auto DaeProblem::initialized() const -> bool
@@ -133,12 +411,12 @@ auto DaeProblem::numEquations() const -> unsigned
 
 auto DaeProblem::function() const -> const DaeFunction&
 {
-    return pimpl->ode_function;
+    return pimpl->dae_function;
 }
 
 auto DaeProblem::jacobian() const -> const DaeJacobian&
 {
-    return pimpl->ode_jacobian;
+    return pimpl->dae_jacobian;
 }
 
 auto DaeProblem::function(double t, const Vector& y, const Vector& ydot, Vector& f) const -> int
@@ -146,9 +424,9 @@ auto DaeProblem::function(double t, const Vector& y, const Vector& ydot, Vector&
     return function()(t, y, ydot, f);
 }
 
-auto DaeProblem::jacobian(double t, const Vector& y, const Vector& ydot, Matrix& J) const -> int
+auto DaeProblem::jacobian(double t, const Vector& y, const Vector& ydot, double alpha, Matrix& J) const -> int
 {
-    return jacobian()(t, y, ydot, J);
+    return jacobian()(t, y, ydot, alpha, J);
 }
 
 DaeSolver::DaeSolver()
@@ -180,7 +458,12 @@ auto DaeSolver::setProblem(const DaeProblem& problem) -> void
 
 auto DaeSolver::initialize(double tstart, const Vector& y) -> void
 {
-    pimpl->initialize(tstart, y);
+    pimpl->initialize(tstart, y, zeros(y.size()));
+}
+
+auto DaeSolver::initialize(double tstart, const Vector& y, const Vector& ydot) -> void
+{
+    pimpl->initialize(tstart, y, ydot);
 }
 
 auto DaeSolver::integrate(double& t, Vector& y) -> void
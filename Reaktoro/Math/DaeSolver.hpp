@@ -22,20 +22,70 @@
 #include <memory>
 
 // Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
 #include <Reaktoro/Math/Matrix.hpp>
 
 namespace Reaktoro {
 
-/// The function signature of the right-hand side function of a system of ordinary differential equations.
+/// The function signature of the residual function `F(t, u, udot)` of a system of differential-algebraic equations.
 using DaeFunction = std::function<int(double t, const Vector& u, const Vector& udot, Vector& F)>;
 
-/// The function signature of the Jacobian of the right-hand side function of a system of ordinary differential equations.
-using DaeJacobian = std::function<int(double t, const Vector& u, const Vector& udot, Matrix& J)>;
+/// The function signature of the Jacobian `J = dF/du + alpha*dF/dudot` of the residual function of a system of differential-algebraic equations.
+using DaeJacobian = std::function<int(double t, const Vector& u, const Vector& udot, double alpha, Matrix& J)>;
 
 /// A struct that defines the options for the DaeSolver.
 /// @see DaeSolver, DaeProblem
 struct DaeOptions
 {
+    /// The maximum order for the BDF integration scheme.
+    /// The order of the BDF method can be 1 or 2.
+    unsigned max_order = 2;
+
+    /// The initial step size to be used in the integration.
+    /// An estimation is made if its value is zero.
+    double initial_step = 0.0;
+
+    /// The lower bound on the magnitude of the step size.
+    double min_step = 0.0;
+
+    /// The upper bound on the magnitude of the step size.
+    /// No upper bound is used if its value is zero.
+    double max_step = 0.0;
+
+    /// The scalar relative error tolerance.
+    double reltol = 1e-4;
+
+    /// The scalar absolute error tolerance.
+    double abstol = 1.0e-6;
+
+    /// The vector of absolute error tolerances for each component.
+    Vector abstols;
+
+    /// The indices of the algebraic variables, which are excluded from the local error test.
+    Indices algebraic;
+
+    /// The indices of the variables that are logarithms of positive quantities.
+    /// The tolerances of these variables apply to the quantities instead, so that
+    /// a change `dy` of a logarithm is weighted by `reltol + abstol*exp(-y)`.
+    Indices logarithmic;
+
+    /// The maximum allowed number of steps before reaching the final time in method DaeSolver::solve.
+    unsigned max_num_steps = 500;
+
+    /// The maximum number of Newton iterations in each step.
+    unsigned max_num_newton_iterations = 10;
+
+    /// The tolerance of the Newton iterations, relative to the one of the local error test.
+    double newton_tolerance = 0.1;
+
+    /// The bounds on the absolute change of each variable in a Newton iteration.
+    /// The Newton steps are shortened so that these bounds are not exceeded,
+    /// which is useful for variables such as logarithms of amounts.
+    /// No bounds are imposed if empty.
+    Vector newton_step_bounds;
+
+    /// The maximum number of error test failures or Newton convergence failures in each step.
+    unsigned max_num_failures = 10;
 };
 
 /// A class that defines a system of differential-algebraic equations (DAE) problem.
@@ -58,10 +108,11 @@ public:
     /// Set the number of ordinary differential equations
     auto setNumEquations(unsigned num) -> void;
 
-    /// Set the right-hand side function of the system of ordinary differential equations
+    /// Set the residual function of the system of differential-algebraic equations
     auto setFunction(const DaeFunction& f) -> void;
 
-    /// Set the Jacobian of the right-hand side function of the system of ordinary differential equations
+    /// Set the Jacobian of the residual function of the system of differential-algebraic equations.
+    /// A finite difference approximation of the Jacobian is used if this method is not called.
     auto setJacobian(const DaeJacobian& J) -> void;
 
     /// Return true if the problem has bee initialized.
@@ -70,13 +121,13 @@ public:
     /// Return the number of ordinary differential equations
     auto numEquations() const -> unsigned;
 
-    /// Return the right-hand side function of the system of ordinary differential equations
+    /// Return the residual function of the system of differential-algebraic equations
     auto function() const -> const DaeFunction&;
 
-    /// Return the Jacobian of the right-hand side function of the system of ordinary differential equations
+    /// Return the Jacobian of the residual function of the system of differential-algebraic equations
     auto jacobian() const -> const DaeJacobian&;
 
-    /// Evaluate the right-hand side function of the system of ordinary differential equations.
+    /// Evaluate the residual function of the system of differential-algebraic equations.
     /// @param t The independent progress variable.
     /// @param y The values of the y variables.
     /// @param ydot The values of the first-order derivatives of the y variables.
@@ -84,13 +135,14 @@ public:
     /// @return Return 0 if successful, any other number otherwise.
     auto function(double t, const Vector& y, const Vector& ydot, Vector& f) const -> int;
 
-    /// Evaluate the Jacobian of the right-hand side function of the system of ordinary differential equations.
+    /// Evaluate the Jacobian `J = dF/dy + alpha*dF/dydot` of the residual function of the system of differential-algebraic equations.
     /// @param t The independent progress variable.
     /// @param y The values of the y variables.
     /// @param ydot The values of the first-order derivatives of the y variables.
+    /// @param alpha The derivative of `ydot` with respect to `y` in the integration formula.
     /// @param[out] J The result of the Jacobian evaluation.
     /// @return Return 0 if successful, any other number otherwise.
-    auto jacobian(double t, const Vector& y, const Vector& ydot, Matrix& J) const -> int;
+    auto jacobian(double t, const Vector& y, const Vector& ydot, double alpha, Matrix& J) const -> int;
 
 private:
     struct Impl;
@@ -99,6 +151,10 @@ private:
 };
 
 /// A class for solving differential-algebraic equations (DAE).
+/// The residual equations `F(t, y, ydot) = 0` are integrated with a variable step
+/// backward differentiation formula (BDF) of order 1 or 2, with the local error
+/// estimated from the difference between the predicted and the corrected values.
+/// The algebraic equations must be of index 1 and the initial values consistent with them.
 /// @see DaeProblem, DaeOptions
 class DaeSolver
 {
@@ -115,32 +171,38 @@ public:
     /// Assign a DaeSolver instance to this instance
     auto operator=(DaeSolver other) -> DaeSolver&;
 
-    /// Set the options for the ODE solver.
+    /// Set the options for the DAE solver.
     /// @see DaeOptions
     auto setOptions(const DaeOptions& options) -> void;
 
-    /// Set the ODE problem.
+    /// Set the DAE problem.
     /// @see DaeProblem
     auto setProblem(const DaeProblem& problem) -> void;
 
-    /// Initializes the ODE solver.
+    /// Initializes the DAE solver.
     /// This method should be invoked whenever the user intends to make a call to `DaeSolver::integrate`.
     /// @param tstart The start time of the integration.
     /// @param y The initial values of the variables
     auto initialize(double tstart, const Vector& y) -> void;
 
-    /// Integrate the ODE performing a single step.
+    /// Initializes the DAE solver with the initial first-order derivatives of the variables.
+    /// @param tstart The start time of the integration.
+    /// @param y The initial values of the variables
+    /// @param ydot The initial values of the first-order derivatives of the variables
+    auto initialize(double tstart, const Vector& y, const Vector& ydot) -> void;
+
+    /// Integrate the DAE performing a single step.
     /// @param[in,out] t The current time of the integration as input, the new current time as output
     /// @param[in,out] y The current variables as input, the new current variables as output
     auto integrate(double& t, Vector& y) -> void;
 
-    /// Integrate the ODE performing a single step not going over a given time.
+    /// Integrate the DAE performing a single step not going over a given time.
     /// @param[in,out] t The current time of the integration as input, the new current time as output
     /// @param[in,out] y The current variables as input, the new current variables as output
     /// @param tfinal The final time that the integration must satisfy
     auto integrate(double& t, Vector& y, double tfinal) -> void;
 
-    /// Solve the ODE equations from a given start time to a final one.
+    /// Solve the DAE equations from a given start time to a final one.
     /// @param[in,out] t The current time of the integration as input, the new current time as output
     /// @param dt The value of the time step
     /// @param[in,out] y The current variables as input, the new current variables as output
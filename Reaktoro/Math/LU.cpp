@@ -112,7 +112,7 @@ auto LU::compute(const Matrix& A, const Vector& W) -> void
     U = U * Q.inverse() * diag(inv(W)) * Q;
 }
 
-auto LU::solve(const Matrix& B) -> Matrix
+auto LU::solve(const Matrix& B) const -> Matrix
 {
     const Index n = U.cols();
     const Index k = B.cols();
@@ -133,11 +133,11 @@ auto LU::solve(const Matrix& B) -> Matrix
     return X;
 }
 
-auto LU::trsolve(const Matrix& B) -> Matrix
+auto LU::trsolve(const Matrix& B) const -> Matrix
 {
     const Index m = L.rows();
     const Index k = B.cols();
-    Matrix X(m, k);
+    Matrix X = zeros(m, k);
 
     auto trsolve_column = [&](Index icol)
     {
@@ -45,10 +45,10 @@ struct LU
     auto compute(const Matrix& A, const Vector& W) -> void;
 
     /// Solve the linear system `AX = B` using the calculated LU decomposition.
-    auto solve(const Matrix& b) -> Matrix;
+    auto solve(const Matrix& b) const -> Matrix;
 
     /// Solve the linear system `tr(A)X = B` using the calculated LU decomposition.
-    auto trsolve(const Matrix& B) -> Matrix;
+    auto trsolve(const Matrix& B) const -> Matrix;
 
     /// The last decomposed matrix A
     Matrix A_last;
@@ -386,6 +386,30 @@ using Vector = Eigen::VectorXd;
 /// Define an alias to the matrix type of the Eigen library
 using Matrix = Eigen::MatrixXd;
 
+/// Define an alias to a vector type with size known at compile time
+/// @tparam Rows The number of rows of the vector
+template<int Rows>
+using VectorFixed = Eigen::Matrix<double, Rows, 1>;
+
+/// Define an alias to a matrix type with size known at compile time
+/// @tparam Rows The number of rows of the matrix
+/// @tparam Cols The number of columns of the matrix
+template<int Rows, int Cols>
+using MatrixFixed = Eigen::Matrix<double, Rows, Cols>;
+
+/// Define an alias to a vector type whose storage is bounded at compile time.
+/// The entries are stored inline (no heap allocation), but the vector can be
+/// resized at runtime to any number of rows not greater than `MaxRows`.
+/// @tparam MaxRows The maximum number of rows of the vector
+template<int MaxRows>
+using VectorMax = Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor, MaxRows, 1>;
+
+/// Define an alias to a matrix type whose storage is bounded at compile time.
+/// @tparam MaxRows The maximum number of rows of the matrix
+/// @tparam MaxCols The maximum number of columns of the matrix
+template<int MaxRows, int MaxCols>
+using MatrixMax = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MaxRows, MaxCols>;
+
 /// Define an alias to a permutation matrix type of the Eigen library
 using PermutationMatrix = Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic>;
 
@@ -219,8 +219,14 @@ struct ODESolver::Impl
         // Set the user-defined data to cvode_mem
         CheckIntegration(CVodeSetUserData(cvode_mem, &data));
 
-        // Solve the ode problem from `tstart` to `tfinal`
-        CheckIntegration(CVode(cvode_mem, tfinal, cvode_y, &t, CV_ONE_STEP));
+        // The internal time of CVODE, which is ahead of `t` if the previous step was interpolated
+        double tcurrent;
+        CheckIntegration(CVodeGetCurrentTime(cvode_mem, &tcurrent));
+
+        // Solve the ode problem from `tstart` to `tfinal`, unless the last step already went over it
+        if(tcurrent <= tfinal) {
+            CheckIntegration(CVode(cvode_mem, tfinal, cvode_y, &t, CV_ONE_STEP));
+        } else t = tcurrent;
 
         // Check if the current time is now greater than the final time
         if(t > tfinal)
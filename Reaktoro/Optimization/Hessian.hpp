@@ -46,6 +46,12 @@ struct Hessian
 
     /// The Hessian matrix represented as a diagonal matrix
     Vector diagonal;
+
+    /// The optional indices of the diagonal blocks of the variables when `dense` is block-diagonal.
+    /// The entry `(i, j)` of the dense Hessian matrix is assumed zero if `blocks[i] != blocks[j]`,
+    /// which permits the blocks to be decomposed independently of each other (e.g., one block
+    /// per phase in chemical equilibrium problems). If empty, no structure is assumed.
+    Indices blocks;
 };
 
 /// Return the multiplication of a Hessian matrix and a vector.
@@ -17,6 +17,9 @@
 
 #include "KktSolver.hpp"
 
+// C++ includes
+#include <algorithm>
+
 // Eigen includes
 #include <Reaktoro/Math/Eigen/LU>
 #include <Reaktoro/Math/Eigen/Cholesky>
@@ -24,6 +27,7 @@ using namespace Eigen;
 
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Profiling.hpp>
 #include <Reaktoro/Common/SetUtils.hpp>
 #include <Reaktoro/Common/TimeUtils.hpp>
 #include <Reaktoro/Math/MathUtils.hpp>
@@ -110,6 +114,59 @@ struct KktSolverRangespaceDiagonal : KktSolverBase
     virtual auto solve(const KktVector& rhs, KktSolution& sol) -> void;
 };
 
+struct KktSolverRangespaceBlockDiagonal : KktSolverBase
+{
+    /// The vectors x and z
+    Vector x, z;
+
+    /// The coefficient matrix `A` of the KKT equation augmented with one row of ones per eliminated block
+    Matrix Ahat;
+
+    /// The indices of the variables in each diagonal block of the Hessian matrix
+    std::vector<Indices> iblocks;
+
+    /// The flags that indicate which diagonal blocks are eliminated in the rangespace approach
+    std::vector<bool> pivot;
+
+    /// The indices of the variables in the blocks that are not eliminated
+    Indices inonpivot;
+
+    /// The diagonal blocks of the matrix `G = H + inv(X)*Z + gamma^2*I`
+    std::vector<Matrix> G_blocks;
+
+    /// The LU decompositions of the regularized diagonal blocks `G(k) + rho(k)*1*tr(1)`
+    std::vector<PartialPivLU<Matrix>> lu_blocks;
+
+    /// The squared regularization parameter delta of the KKT equation
+    double delta2;
+
+    /// The matrix `inv(G1)*tr(Ahat1)` of the eliminated blocks (zero rows for the other variables)
+    Matrix invG1A1t;
+
+    /// Auxiliary matrices for the assembly of the diagonal blocks
+    Matrix Gk, Atk;
+
+    /// The reduced KKT equation of the non-eliminated variables and the dual variables
+    Matrix kkt_lhs;
+    Vector kkt_rhs, kkt_sol;
+    PartialPivLU<Matrix> lu;
+
+    /// Auxiliary vectors for the solution of the KKT equation
+    Vector r, invG1r1, rblock, resx, resy, ddx, ddy;
+
+    /// Decompose any necessary matrix before the KKT calculation.
+    /// Note that this method should be called before `solve`,
+    /// once the matrices `H` and `A` have been initialized.
+    virtual auto decompose(const KktMatrix& lhs) -> void;
+
+    /// Solve the KKT problem using a rangespace approach on the diagonal blocks of the Hessian matrix.
+    /// Note that this method requires `decompose` to be called a priori.
+    virtual auto solve(const KktVector& rhs, KktSolution& sol) -> void;
+
+    /// Solve the equations `G*dx - tr(A)*dy = rx` and `A*dx + delta^2*dy = ry` with the decomposed blocks.
+    auto solveDecomposed(const Vector& rx, const Vector& ry, Vector& dx, Vector& dy) -> void;
+};
+
 struct KktSolverNullspace : KktSolverBase
 {
     /// The pointer to the left-hand side KKT matrix
@@ -368,6 +425,181 @@ auto KktSolverRangespaceDiagonal::solve(const KktVector& rhs, KktSolution& sol)
     dz.noalias() = (c - Z % dx)/X;
 }
 
+auto KktSolverRangespaceBlockDiagonal::decompose(const KktMatrix& lhs) -> void
+{
+    // Check if the Hessian matrix is dense with block-diagonal structure
+    Assert(lhs.H.mode == Hessian::Dense && lhs.H.blocks.size() == Index(lhs.x.size()),
+        "Cannot solve the KKT equation using the block-diagonal rangespace algorithm.",
+        "The Hessian matrix must be in Dense mode with the indices of its diagonal blocks.");
+
+    // Update x and z
+    x = lhs.x;
+    z = lhs.z;
+
+    // Auxiliary references to the KKT matrix components
+    const auto& H = lhs.H.dense;
+    const auto& A = lhs.A;
+    const auto& blocks = lhs.H.blocks;
+    const auto& gamma = lhs.gamma;
+    const auto& delta = lhs.delta;
+
+    const unsigned n = A.cols();
+    const unsigned m = A.rows();
+
+    // Group the variables by the index of their diagonal block
+    const Index num_blocks = blocks.size() ? *std::max_element(blocks.begin(), blocks.end()) + 1 : 0;
+    iblocks.assign(num_blocks, Indices());
+    for(unsigned i = 0; i < n; ++i)
+        iblocks[blocks[i]].push_back(i);
+
+    // The Hessian block of a phase is nearly singular along the composition of the phase
+    // (e.g., diag(1/n) - 1*tr(1)/nt for an ideal phase), so that `G = H + inv(X)*Z + gamma^2*I`
+    // cannot be reliably inverted near convergence. Each block is thus regularized as
+    // `G(k) + rho(k)*1*tr(1)` with `rho(k) = 1/sum(x(k))`, which removes this singularity. The
+    // regularization is compensated exactly by the new unknown `t(k) = rho(k)*tr(1)*dx(k)`,
+    // which extends `A` with one row of ones over the variables of the block and the bottom-right
+    // corner of the reduced KKT matrix with the entry `-1/rho(k)`. Blocks whose regularized
+    // matrix cannot be decomposed are kept unregularized in the reduced KKT equation.
+    G_blocks.resize(num_blocks);
+    lu_blocks.resize(num_blocks);
+    pivot.assign(num_blocks, false);
+    inonpivot.clear();
+    Vector invrho(num_blocks);
+    Index num_pivot = 0;
+    for(Index k = 0; k < num_blocks; ++k)
+    {
+        const Indices& ib = iblocks[k];
+        if(ib.empty()) continue;
+
+        const double xsum = rows(x, ib).sum();
+        invrho[k] = xsum > 0.0 ? xsum : 1.0;
+
+        G_blocks[k] = submatrix(H, ib, ib);
+        G_blocks[k].diagonal() += rows(z, ib)/rows(x, ib);
+        G_blocks[k].diagonal() += gamma*gamma*ones(ib.size());
+
+        Gk = G_blocks[k];
+        Gk.array() += 1.0/invrho[k];
+        lu_blocks[k].compute(Gk);
+
+        const auto pivots = lu_blocks[k].matrixLU().diagonal();
+        pivot[k] = pivots.allFinite() && pivots.cwiseAbs().minCoeff() > 0.0;
+
+        if(pivot[k]) ++num_pivot;
+        else inonpivot.insert(inonpivot.end(), ib.begin(), ib.end());
+    }
+
+    // Assemble the augmented matrix `Ahat = [A; tr(W)]`, where `W` has one column of ones per eliminated block
+    const unsigned mhat = m + num_pivot;
+    delta2 = delta*delta;
+    Ahat = zeros(mhat, n);
+    Ahat.topRows(m) = A;
+    Vector deltahat = delta2*ones(mhat);
+    for(Index k = 0, irow = m; k < num_blocks; ++k)
+    {
+        if(!pivot[k]) continue;
+        for(Index i : iblocks[k])
+            Ahat(irow, i) = 1.0;
+        deltahat[irow++] = -invrho[k];
+    }
+
+    // Compute `inv(G1)*tr(Ahat1)` block by block for the eliminated blocks
+    invG1A1t = zeros(n, mhat);
+    for(Index k = 0; k < num_blocks; ++k)
+    {
+        if(!pivot[k]) continue;
+        Atk = tr(cols(Ahat, iblocks[k]));
+        rows(invG1A1t, iblocks[k]) = Matrix(lu_blocks[k].solve(Atk));
+    }
+
+    const unsigned n2 = inonpivot.size();
+    const unsigned t  = n2 + mhat;
+
+    // Assemble the reduced KKT matrix [G2 -tr(Ahat2); Ahat2 Ahat1*inv(G1)*tr(Ahat1) + diag(deltahat)]
+    const Matrix A2 = cols(Ahat, inonpivot);
+    kkt_lhs.resize(t, t);
+    kkt_lhs.topLeftCorner(n2, n2) = submatrix(H, inonpivot, inonpivot);
+    for(unsigned i = 0; i < n2; ++i)
+        for(unsigned j = 0; j < n2; ++j)
+            if(blocks[inonpivot[i]] != blocks[inonpivot[j]])
+                kkt_lhs(i, j) = 0.0;
+    kkt_lhs.topLeftCorner(n2, n2).diagonal() += rows(z, inonpivot)/rows(x, inonpivot);
+    kkt_lhs.topLeftCorner(n2, n2).diagonal() += gamma*gamma*ones(n2);
+    kkt_lhs.topRightCorner(n2, mhat).noalias() = -tr(A2);
+    kkt_lhs.bottomLeftCorner(mhat, n2).noalias() = A2;
+    kkt_lhs.bottomRightCorner(mhat, mhat).noalias() = Ahat * invG1A1t;
+    kkt_lhs.bottomRightCorner(mhat, mhat).diagonal() += deltahat;
+
+    lu.compute(kkt_lhs);
+}
+
+auto KktSolverRangespaceBlockDiagonal::solve(const KktVector& rhs, KktSolution& sol) -> void
+{
+    // Auxiliary references
+    const auto& rx = rhs.rx;
+    const auto& ry = rhs.ry;
+    const auto& rz = rhs.rz;
+    auto& dx = sol.dx;
+    auto& dy = sol.dy;
+    auto& dz = sol.dz;
+
+    const unsigned m = ry.rows();
+    const auto A = Ahat.topRows(m);
+
+    // Solve the KKT equation with right-hand side `r = rx + inv(X)*rz`
+    r.noalias() = rx + rz/x;
+    solveDecomposed(r, ry, dx, dy);
+
+    // Perform one step of iterative refinement with the unregularized blocks, since the
+    // compensation of the regularization of a block involves cancellation of its large entries
+    resx.noalias() = r + tr(A)*dy;
+    for(Index k = 0; k < iblocks.size(); ++k)
+    {
+        if(iblocks[k].empty()) continue;
+        rblock = rows(dx, iblocks[k]);
+        rows(resx, iblocks[k]) = Vector(rows(resx, iblocks[k])) - G_blocks[k]*rblock;
+    }
+    resy.noalias() = ry - A*dx - delta2*dy;
+    solveDecomposed(resx, resy, ddx, ddy);
+    dx += ddx;
+    dy += ddy;
+
+    dz.noalias() = (rz - z % dx)/x;
+}
+
+auto KktSolverRangespaceBlockDiagonal::solveDecomposed(const Vector& rx, const Vector& ry, Vector& dx, Vector& dy) -> void
+{
+    const unsigned n    = rx.rows();
+    const unsigned m    = ry.rows();
+    const unsigned mhat = Ahat.rows();
+    const unsigned n2   = inonpivot.size();
+
+    // Compute `inv(G1)*r1` block by block for the eliminated blocks
+    invG1r1 = zeros(n);
+    for(Index k = 0; k < iblocks.size(); ++k)
+    {
+        if(!pivot[k]) continue;
+        rblock = rows(rx, iblocks[k]);
+        rows(invG1r1, iblocks[k]) = Vector(lu_blocks[k].solve(rblock));
+    }
+
+    // Solve the reduced KKT equation for `dx2`, `dy` and the regularization unknowns `t`
+    kkt_rhs.resize(n2 + mhat);
+    kkt_rhs.segment(0, n2) = rows(rx, inonpivot);
+    kkt_rhs.segment(n2, mhat) = -Ahat*invG1r1;
+    kkt_rhs.segment(n2, m) += ry;
+
+    kkt_sol = lu.solve(kkt_rhs);
+
+    if(!kkt_sol.allFinite())
+        kkt_sol = kkt_lhs.fullPivLu().solve(kkt_rhs);
+
+    // Recover `dx` from `dx1 = inv(G1)*(r1 + tr(Ahat1)*[dy; t])` and `dx2`
+    dy = kkt_sol.segment(n2, m);
+    dx.noalias() = invG1r1 + invG1A1t*kkt_sol.segment(n2, mhat);
+    rows(dx, inonpivot) = kkt_sol.segment(0, n2);
+}
+
 auto KktSolverNullspace::initialize(const Matrix& newA) -> void
 {
     // Check if `newA` was used last time to avoid repeated operations
@@ -488,6 +720,7 @@ struct KktSolver::Impl
     KktSolverNullspace kkt_nullspace;
     KktSolverRangespaceDiagonal kkt_rangespace_diagonal;
     KktSolverRangespaceInverse kkt_rangespace_inverse;
+    KktSolverRangespaceBlockDiagonal kkt_rangespace_block_diagonal;
     KktSolverBase* base;
 
     auto decompose(const KktMatrix& lhs) -> void;
@@ -500,7 +733,7 @@ auto KktSolver::Impl::decompose(const KktMatrix& lhs) -> void
     if(options.method == KktMethod::Automatic)
     {
         if(lhs.H.mode == Hessian::Dense)
-            base = &kkt_partial_lu;
+            base = lhs.H.blocks.empty() ? static_cast<KktSolverBase*>(&kkt_partial_lu) : &kkt_rangespace_block_diagonal;
 
         if(lhs.H.mode == Hessian::Diagonal)
             base = &kkt_rangespace_diagonal;
@@ -520,6 +753,9 @@ auto KktSolver::Impl::decompose(const KktMatrix& lhs) -> void
 
     if(options.method == KktMethod::Rangespace)
     {
+        if(lhs.H.mode == Hessian::Dense && lhs.H.blocks.size())
+            base = &kkt_rangespace_block_diagonal;
+
         if(lhs.H.mode == Hessian::Diagonal)
             base = &kkt_rangespace_diagonal;
 
@@ -527,6 +763,8 @@ auto KktSolver::Impl::decompose(const KktMatrix& lhs) -> void
             base = &kkt_rangespace_inverse;
     }
 
+    ProfileScope("KktSolver::decompose");
+
     Time begin = time();
 
     base->decompose(lhs);
@@ -537,6 +775,8 @@ auto KktSolver::Impl::decompose(const KktMatrix& lhs) -> void
 
 auto KktSolver::Impl::solve(const KktVector& rhs, KktSolution& sol) -> void
 {
+    ProfileScope("KktSolver::solve");
+
     Time begin = time();
 
     base->solve(rhs, sol);
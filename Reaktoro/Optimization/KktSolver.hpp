@@ -57,13 +57,14 @@ enum class KktMethod
 
     /// Use a rangespace method to solve the KKT equation.
     /// This method is advisable when the Hessian matrix can be easily
-    /// inverted such as a quasi-Newton approximation or a diagonal matrix.
+    /// inverted such as a quasi-Newton approximation, a diagonal matrix,
+    /// or a dense matrix with block-diagonal structure (see Hessian::blocks).
     Rangespace,
 
     /// Use a method that fits better to the type of KKT equation.
     /// This option will ensure that a rangespace method is used when
-    /// the Hessian matrix is diagonal or its inverse is available.
-    /// It will use a `PartialPivLU` method for dense KKT equations.
+    /// the Hessian matrix is diagonal, block-diagonal, or its inverse is available.
+    /// It will use a `PartialPivLU` method for other dense KKT equations.
     Automatic,
 };
 
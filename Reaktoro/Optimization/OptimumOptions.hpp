@@ -144,6 +144,29 @@ struct OptimumParamsRefiner
     bool use_lma_setup = true;
 };
 
+/// The pricing rules for the selection of the entering variable in the simplex algorithm.
+enum class SimplexPricing
+{
+    /// Select the nonbasic variable with the most negative reduced cost.
+    Dantzig,
+
+    /// Select the nonbasic variable with the most negative reduced cost scaled by its Devex reference weight.
+    Devex,
+};
+
+struct OptimumParamsSimplex
+{
+    /// The pricing rule for the selection of the entering variable.
+    SimplexPricing pricing = SimplexPricing::Devex;
+
+    /// The number of product-form updates of the basis factorization before it is computed from scratch.
+    unsigned refactorization = 50;
+
+    /// The flag that indicates if the optimal basis of the previous calculation should be used as
+    /// starting basis, skipping the Phase I calculation whenever it is feasible for the new problem.
+    bool warmstart = true;
+};
+
 /// A type that describes the options for the output of a optimisation calculation
 struct OptimumOutputOptions : OutputterOptions
 {
@@ -227,6 +250,9 @@ struct OptimumOptions
     /// The parameters for the Refiner algorithm
     OptimumParamsRefiner refiner;
 
+    /// The parameters for the Simplex algorithm
+    OptimumParamsSimplex simplex;
+
     /// The regularization options for the optimisation calculation
     OptimumParamsRegularization regularization;
 
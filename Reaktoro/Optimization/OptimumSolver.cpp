@@ -48,6 +48,9 @@ struct OptimumSolver::Impl
     /// The pointer to the optimization solver
     OptimumSolverBase* solver = nullptr;
 
+    /// The optimization method of the current solver
+    OptimumMethod method;
+
     /// The IpFeasible solver for approximation calculation
     OptimumSolverIpFeasible ipfeasible;
 
@@ -79,10 +82,15 @@ struct OptimumSolver::Impl
     }
 
     // Set the optimization method for the solver
-    auto setMethod(OptimumMethod method) -> void
+    auto setMethod(OptimumMethod method_) -> void
     {
+        // Keep the current solver, and any state it carries between calculations, if the method is unchanged
+        if(solver != nullptr && method_ == method) return;
+
         if(solver != nullptr) delete solver;
 
+        method = method_;
+
         switch(method)
         {
         case OptimumMethod::ActNewton:
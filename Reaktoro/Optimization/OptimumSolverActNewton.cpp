@@ -297,6 +297,8 @@ auto OptimumSolverActNewton::Impl::solve(const OptimumProblem& problem, OptimumS
         {
         case Hessian::Dense:
             HF.dense = submatrix(f.hessian.dense, F, F);
+            if(f.hessian.blocks.size())
+                HF.blocks = extract(f.hessian.blocks, F);
             break;
         case Hessian::Diagonal:
             HF.diagonal = rows(f.hessian.diagonal, F); break;
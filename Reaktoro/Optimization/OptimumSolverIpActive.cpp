@@ -209,6 +209,8 @@ auto OptimumSolverIpActive::Impl::solve(const OptimumProblem& problem, OptimumSt
                 f_stable.hessian.diagonal = rows(f.hessian.diagonal, istable_variables);
             if(f.hessian.inverse.size())
                 f_stable.hessian.inverse = submatrix(f.hessian.inverse, istable_variables, istable_variables);
+            if(f.hessian.blocks.size())
+                f_stable.hessian.blocks = extract(f.hessian.blocks, istable_variables);
 
             return f_stable;
         };
@@ -20,6 +20,7 @@
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
 #include <Reaktoro/Common/Outputter.hpp>
+#include <Reaktoro/Common/Profiling.hpp>
 #include <Reaktoro/Common/TimeUtils.hpp>
 #include <Reaktoro/Math/MathUtils.hpp>
 #include <Reaktoro/Optimization/KktSolver.hpp>
@@ -54,6 +55,8 @@ struct OptimumSolverIpNewton::Impl
         // Start timing the calculation
         Time begin = time();
 
+        ProfileScope("OptimumSolverIpNewton::solve");
+
         // The result of the calculation
         OptimumResult result;
 
@@ -209,7 +212,11 @@ struct OptimumSolverIpNewton::Impl
                     f.hessian.diagonal = zeros(n);
                 }
             }
-            else f = problem.objective(x);
+            else
+            {
+                ProfileScope("OptimumSolverIpNewton::objective");
+                f = problem.objective(x);
+            }
         };
 
         // The function that initialize the state of some variables
@@ -289,6 +296,9 @@ struct OptimumSolverIpNewton::Impl
             // Repeat until f(xtrial) is finite
             while(!isfinite(f) && ++tentatives < 10)
             {
+                // Count the backtracking steps in the profiler
+                ProfileCount("OptimumSolverIpNewton::backtrack", 1);
+
                 // Calculate a new trial iterate using a smaller step length
                 xtrial = x + alpha * sol.dx;
 
@@ -342,6 +352,9 @@ struct OptimumSolverIpNewton::Impl
                 if(isfinite(f))
                     break;
 
+                // Count the backtracking steps in the profiler
+                ProfileCount("OptimumSolverIpNewton::backtrack", 1);
+
                 // Decrease alpha in a hope that a shorter step results f(xtrial) finite
                 alpha *= 0.01;
             }
@@ -401,6 +414,9 @@ struct OptimumSolverIpNewton::Impl
         // Output a final header
         outputter.outputHeader();
 
+        // Count the Newton iterations in the profiler
+        ProfileCount("OptimumSolverIpNewton::iterations", iterations);
+
         // Finish timing the calculation
         result.time = elapsed(begin);
 
@@ -83,6 +83,11 @@ struct OptimumSolverSimplex::Impl
 {
     Indices ibasic, ilower, iupper;
 
+    /// The flag that indicates if the partition `ibasic`, `ilower`, `iupper` is the optimal basis of the last calculation
+    bool optimal = false;
+
+    auto warmstart(const OptimumProblem& problem, OptimumState& state) -> bool;
+
     auto feasible(const OptimumProblem& problem, OptimumState& state, const OptimumOptions& options) -> OptimumResult;
 
     auto simplex(const OptimumProblem& problem, OptimumState& state, const OptimumOptions& options) -> OptimumResult;
@@ -220,32 +225,117 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
     // Define auxiliary references to general options
     const auto maxiters = options.max_iterations;
 
+    // Define auxiliary references to the simplex options
+    const auto& params = options.simplex;
+    const bool devex = params.pricing == SimplexPricing::Devex;
+
     std::sort(ibasic.begin(), ibasic.end());
 
     Vector xb = rows(state.x, ibasic);
 
+    // The LU factorization of the basic matrix at the last refactorization and the
+    // eta vectors of the product-form updates of the basis performed since then
+    Eigen::PartialPivLU<Matrix> lu;
+    Indices eta_indices;
+    std::vector<Vector> eta_vectors;
+
+    // The Devex reference weights of the variables
+    Vector weights = ones(n);
+
+    // Compute the LU factorization of the current basic matrix and discard the eta vectors
+    auto refactorize = [&]()
+    {
+        lu.compute(cols(A, ibasic));
+        eta_indices.clear();
+        eta_vectors.clear();
+    };
+
+    // Solve the linear system `B*x = v`, where `B` is the current basic matrix
+    auto ftran = [&](const Vector& v) -> Vector
+    {
+        Vector x = lu.solve(v);
+        for(unsigned k = 0; k < eta_indices.size(); ++k)
+        {
+            const Index p = eta_indices[k];
+            const Vector& eta = eta_vectors[k];
+            const double xp = x[p]/eta[p];
+            x -= xp * eta;
+            x[p] = xp;
+        }
+        return x;
+    };
+
+    // Solve the linear system `tr(B)*x = v`, where `B` is the current basic matrix
+    auto btran = [&](Vector v) -> Vector
+    {
+        for(unsigned k = eta_indices.size(); k > 0; --k)
+        {
+            const Index p = eta_indices[k - 1];
+            const Vector& eta = eta_vectors[k - 1];
+            v[p] = (v[p] - dot(eta, v) + eta[p]*v[p])/eta[p];
+        }
+        return solveTranspose(lu, v);
+    };
+
+    // Update the Devex reference weights and the basis factorization when the q-th variable replaces the
+    // basic variable at the local position `plocal`, where `t` is the corresponding column of `inv(B)*A`
+    auto update = [&](Index q, Index plocal, const Vector& t)
+    {
+        if(devex)
+        {
+            const Index p = ibasic[plocal];
+            const double tq = t[plocal];
+            Vector e = zeros(m); e[plocal] = 1.0;
+            const Vector alpha = tr(A) * btran(e);
+            for(Index j : ilower) weights[j] = std::max(weights[j], std::pow(alpha[j]/tq, 2) * weights[q]);
+            for(Index j : iupper) weights[j] = std::max(weights[j], std::pow(alpha[j]/tq, 2) * weights[q]);
+            weights[p] = std::max(weights[q]/(tq*tq), 1.0);
+        }
+
+        eta_indices.push_back(plocal);
+        eta_vectors.push_back(t);
+    };
+
+    refactorize();
+
     for(iterations = 1; iterations <= maxiters; ++iterations)
     {
         const unsigned nL = ilower.size();
         const unsigned nU = iupper.size();
 
-        Matrix AB = cols(A, ibasic);
-        Matrix AL = cols(A, ilower);
-        Matrix AU = cols(A, iupper);
+        // Compute the basis factorization from scratch after a number of product-form updates
+        if(eta_indices.size() >= params.refactorization)
+            refactorize();
 
         Vector cB = rows(c, ibasic);
-        Vector cL = rows(c, ilower);
-        Vector cU = rows(c, iupper);
 
-        Eigen::PartialPivLU<Matrix> lu(AB);
+        y = btran(cB);
 
-        y = solveTranspose(lu, cB);
+        // The reduced costs of all variables
+        const Vector d = c - tr(A) * y;
 
-        Vector zL =  cL - AL.transpose() * y;
-        Vector zU = -cU + AU.transpose() * y;
+        Vector zL =  rows(d, ilower);
+        Vector zU = -rows(d, iupper);
 
-        const Index qLower = findMostNegative(zL); // the index of the first negative entry in zL
-        const Index qUpper = findMostNegative(zU); // the index of the first negative entry in zU
+        Index qLower = nL; // the local index of the lower bound variable to enter the basic set
+        Index qUpper = nU; // the local index of the upper bound variable to enter the basic set
+
+        if(devex)
+        {
+            // Select the variable with the largest ratio of squared negative reduced cost and reference weight
+            double best = 0.0;
+            for(Index k = 0; k < nL; ++k)
+                if(zL[k] < 0.0 && zL[k]*zL[k]/weights[ilower[k]] > best)
+                    { best = zL[k]*zL[k]/weights[ilower[k]]; qLower = k; }
+            for(Index k = 0; k < nU; ++k)
+                if(zU[k] < 0.0 && zU[k]*zU[k]/weights[iupper[k]] > best)
+                    { best = zU[k]*zU[k]/weights[iupper[k]]; qUpper = k; qLower = nL; }
+        }
+        else
+        {
+            qLower = findMostNegative(zL); // the index of the most negative entry in zL
+            qUpper = findMostNegative(zU); // the index of the most negative entry in zU
+        }
 
         // Check if all dual variables zL and zU are positive
         if(qLower == nL && qUpper == nU)
@@ -268,7 +358,7 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
             const Index qlocal = qLower;
 
             // Compute the step vector `t`
-            Vector t = lu.solve(A.col(q));
+            Vector t = ftran(A.col(q));
 
             // Compute the step length `lambda`
             double lambda = upper[q] - lower[q];
@@ -325,10 +415,12 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
             case 0:
                 erase(qlocal, ilower);      // L' = L - {q}
                 iupper.push_back(q);        // U' = U + {q}
+                xb -= lambda * t;           // step to the new vertex
                 x[q] = upper[q];            // set the q-th variable to its upper bound
                 break;
 
             case 1:
+                update(q, plocal, t);       // update the basis factorization
                 ilower[qlocal] = p;         // L' = L - {q} + {p}
                 ibasic[plocal] = q;         // B' = B + {q} - {p}
                 xb -= lambda * t;           // step to the new vertex
@@ -337,6 +429,7 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
                 break;
 
             case 2:
+                update(q, plocal, t);       // update the basis factorization
                 erase(qlocal, ilower);      // L' = L - {q}
                 iupper.push_back(p);        // U' = U + {p}
                 ibasic[plocal] = q;         // B' = B + {q} - {p}
@@ -357,7 +450,7 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
             const Index qlocal = qUpper;
 
             // Compute the step vector `t`
-            Vector t = lu.solve(A.col(q));
+            Vector t = ftran(A.col(q));
 
             // Compute the step length `lambda`
             double lambda = upper[q] - lower[q];
@@ -414,10 +507,12 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
             case 0:
                 erase(qlocal, iupper); // U' = U - {q}
                 ilower.push_back(q);   // L' = L + {q}
+                xb += lambda * t;      // step to the new vertex
                 x[q] = lower[q];       // set the q-th variable to its lower bound
                 break;
 
             case 1:
+                update(q, plocal, t);       // update the basis factorization
                 iupper[qlocal] = p;         // U' = U - {q} + {p}
                 ibasic[plocal] = q;         // B' = B + {q} - {p}
                 xb += lambda * t;           // step to the new vertex
@@ -426,6 +521,7 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
                 break;
 
             case 2:
+                update(q, plocal, t);       // update the basis factorization
                 erase(qlocal, iupper);      // U' = U - {q}
                 ilower.push_back(p);        // L' = L + {p}
                 ibasic[plocal] = q;         // B' = B + {q} - {p}
@@ -452,12 +548,71 @@ auto OptimumSolverSimplex::Impl::simplex(const OptimumProblem& problem, OptimumS
 
 auto OptimumSolverSimplex::Impl::solve(const OptimumProblem& problem, OptimumState& state, const OptimumOptions& options) -> OptimumResult
 {
-    // Solve the regularized optimization problem
-    auto result = feasible(problem, state, options);
+    OptimumResult result;
+
+    // Start from the optimal basis of the last calculation if it is feasible, otherwise solve the Phase I problem first
+    if(!(options.simplex.warmstart && warmstart(problem, state)))
+        result = feasible(problem, state, options);
+
     result += simplex(problem, state, options);
+
+    // Mark the current partition as an optimal basis for subsequent calculations
+    optimal = result.succeeded;
+
     return result;
 }
 
+auto OptimumSolverSimplex::Impl::warmstart(const OptimumProblem& problem, OptimumState& state) -> bool
+{
+    // The number of variables (n) and equality constraints (m) in the problem
+    const Index n = problem.c.rows();
+    const Index m = problem.A.rows();
+
+    // Define some auxiliary references
+    const auto& A = problem.A;
+    const auto& b = problem.b;
+    const auto& lower = problem.l;
+    const auto& upper = problem.u;
+
+    // Check if the last basis is compatible with the dimensions of the problem
+    if(!optimal || ibasic.size() != m || ibasic.size() + ilower.size() + iupper.size() != n)
+        return false;
+
+    for(Index i : ibasic) if(i >= n) return false;
+    for(Index i : ilower) if(i >= n || !std::isfinite(lower[i])) return false;
+    for(Index i : iupper) if(i >= n || !std::isfinite(upper[i])) return false;
+
+    // Set the nonbasic variables on their bounds
+    Vector x = zeros(n);
+    rows(x, ilower) = rows(lower, ilower);
+    rows(x, iupper) = rows(upper, iupper);
+
+    // Compute the basic variables that satisfy the equality constraints
+    const Matrix AB = cols(A, ibasic);
+    const Eigen::PartialPivLU<Matrix> lu(AB);
+    const Vector r = b - A * x;
+    Vector xb = lu.solve(r);
+
+    // Check if the basic matrix is nonsingular and the basic variables are within their bounds
+    const double tol = 1e-14 * (1.0 + norminf(b));
+    if(!xb.allFinite() || norminf(Vector(AB * xb - r)) > 1e-10 * (1.0 + norminf(r)))
+        return false;
+
+    for(Index k = 0; k < m; ++k)
+    {
+        const Index i = ibasic[k];
+        if(xb[k] < lower[i] - tol || xb[k] > upper[i] + tol)
+            return false;
+        xb[k] = std::max(lower[i], std::min(xb[k], upper[i]));
+    }
+
+    rows(x, ibasic) = xb;
+
+    state.x = x;
+
+    return true;
+}
+
 OptimumSolverSimplex::OptimumSolverSimplex()
 : pimpl(new Impl())
 {}
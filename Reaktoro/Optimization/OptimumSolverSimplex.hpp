@@ -32,6 +32,11 @@ struct OptimumResult;
 struct OptimumState;
 
 /// The class that implements the simplex algorithm for linear programming problems.
+/// This is a revised simplex method with bounded variables, in which the LU factorization
+/// of the basic matrix is updated in product form after every basis change and recomputed
+/// periodically. The optimal basis of a calculation is kept and used as the starting basis
+/// of the next one whenever it is feasible for the new problem.
+/// @see OptimumParamsSimplex
 class OptimumSolverSimplex : public OptimumSolverBase
 {
 public:
@@ -17,6 +17,10 @@
 
 #include "Regularizer.hpp"
 
+// C++ includes
+#include <deque>
+#include <mutex>
+
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
 #include <Reaktoro/Common/Index.hpp>
@@ -29,33 +33,41 @@
 #include <Reaktoro/Optimization/OptimumState.hpp>
 
 namespace Reaktoro {
+namespace {
 
-struct Regularizer::Impl
+/// The maximum number of distinct preprocessed constraints kept for sharing among Regularizer instances
+const std::size_t max_shared_constraints = 32;
+
+/// A type that describes the preprocessing of the linear equality constraints of an optimum problem.
+/// The preprocessing depends only on the coefficient matrix `A` and on the set of trivial constraints.
+/// Thus, it is computed once for all problems with the same `A` and the same trivial constraints
+/// (e.g., all equilibrium problems with the same partition of a chemical system), and then shared
+/// among Regularizer instances, possibly in different threads. It is never modified after creation.
+struct RegularizerConstraints
 {
-    /// The parameters for the regularization
-    RegularizerOptions params;
+    /// The original coefficient matrix `A`
+    Matrix A;
 
-    /// The evaluation of the original objective function.
-    ObjectiveResult f;
+    /// The indices of the equality constraints whose participating variables are fixed at the lower bound
+    Indices itrivial_constraints;
 
-    //=============================================================================================
-    // Data related to trivial and linearly dependent constraints.
-    // Note that these members do not need to be recomputed with matrix A does not change.
-    //=============================================================================================
     /// The indices of the variables fixed at the lower bound
     Indices itrivial_variables;
 
-    /// The indices of the equality constraints whose participating variables are fixed at the lower bound
-    Indices itrivial_constraints;
+    /// The indices of the non-trivial constraints
+    Indices inontrivial_constraints;
 
     /// The indices of the non-trivial variables
     Indices inontrivial_variables;
 
-    /// The indices of the non-trivial constraints
-    Indices inontrivial_constraints;
+    /// The coefficient matrix `A` without trivial constraints and linearly dependent rows.
+    Matrix A_star;
 
-    /// The values of the trivial variables
-    Vector xtrivial;
+    /// The full-pivoting LU decomposition of `A` without trivial constraints and variables.
+    LU lu_star;
+
+    /// The flag that indicates if all non-trivial constraints are linearly independent
+    bool all_li;
 
     /// The indices of the linearly independent constraints
     Indices ili_constraints;
@@ -63,19 +75,120 @@ struct Regularizer::Impl
     /// The permutation matrix used to order linearly independent rows.
     PermutationMatrix P_li;
 
-    /// The flag that indicates if all non-trivial constraints are linearly independent
-    bool all_li;
-
     /// The number of non-trivial, linearly independent rows.
     Index m_li;
+};
 
-    /// The coefficient matrix `A` without trivial constraints and linearly dependent rows.
-    /// If new `A` in `update` equals `A_last`, then there is no need to update `A_star`.
-    Matrix A_star;
+/// Return the preprocessing of the linear equality constraints with given coefficient matrix and trivial constraints.
+auto createRegularizerConstraints(const Matrix& A, const Indices& itrivial) -> std::shared_ptr<const RegularizerConstraints>
+{
+    std::shared_ptr<RegularizerConstraints> constraints(new RegularizerConstraints());
+
+    // The number of rows and cols in the original coefficient matrix
+    const Index m = A.rows();
+    const Index n = A.cols();
+
+    constraints->A = A;
+    constraints->itrivial_constraints = itrivial;
+
+    // Skip the rest if there are no trivial constraints
+    if(itrivial.size())
+    {
+        // Determine the original trivial variables that are fixed at their lower bounds
+        for(Index i = 0; i < n; ++i)
+            for(Index j = 0; j < m; ++j)
+                if(A(j, i) != 0.0 && contained(j, itrivial))
+                    { constraints->itrivial_variables.push_back(i); break; }
+
+        // Update  the indices of the non-trivial original constraints
+        constraints->inontrivial_constraints = difference(range(m), itrivial);
+
+        // Update the indices of the non-trivial original variables
+        constraints->inontrivial_variables = difference(range(n), constraints->itrivial_variables);
+
+        // Initialize the matrix `A_star` by removing trivial constraints and variables
+        constraints->A_star = submatrix(A, constraints->inontrivial_constraints, constraints->inontrivial_variables);
+    }
+    else
+    {
+        // Initialize the matrix `A_star` as the original matrix A
+        constraints->A_star = A;
+    }
+
+    // The number of rows and cols in the coefficient matrix A*,
+    // i.e., the original A matrix with removed trivial constraints and variables
+    const Index mstar = constraints->A_star.rows();
+    const Index nstar = constraints->A_star.cols();
+
+    // Compute the LU decomposition of A*
+    constraints->lu_star.compute(constraints->A_star);
+
+    // Auxiliary references to LU components
+    const auto& P = constraints->lu_star.P;
+    const auto& rank = constraints->lu_star.rank;
+
+    // Check if all constraints are linearly independent
+    constraints->all_li = rank == mstar;
+
+    // Skip the rest if all non-trivial constraints are linearly independent
+    if(constraints->all_li)
+        return constraints;
+
+    // Initialize the indices of the linearly independent constraints
+    constraints->ili_constraints = Indices(P.indices().data(), P.indices().data() + rank);
+
+    // Update the permutation matrix and the number of linearly independent constraints
+    constraints->P_li = P;
+    constraints->m_li = rank;
+
+    // Permute the rows of A and remove the linearly dependent ones
+    constraints->A_star = constraints->P_li * constraints->A_star;
+    constraints->A_star.conservativeResize(constraints->m_li, nstar);
+
+    return constraints;
+}
+
+/// Return the shared preprocessing of the linear equality constraints with given coefficient matrix and trivial constraints.
+/// The preprocessing is created only if no Regularizer instance, in any thread, has requested it before.
+auto sharedRegularizerConstraints(const Matrix& A, const Indices& itrivial) -> std::shared_ptr<const RegularizerConstraints>
+{
+    static std::mutex mutex;
+    static std::deque<std::shared_ptr<const RegularizerConstraints>> shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for(const auto& constraints : shared)
+        if(constraints->A.rows() == A.rows() && constraints->A.cols() == A.cols() &&
+            constraints->A == A && constraints->itrivial_constraints == itrivial)
+                return constraints;
 
-    /// The right-hand side vector `b` without trivial constraints and linearly dependent rows.
-    /// If new `A` in `update` equals `A_last`, then there is no need to update `b_star`.
-    Matrix b_star;
+    shared.push_back(createRegularizerConstraints(A, itrivial));
+
+    if(shared.size() > max_shared_constraints)
+        shared.pop_front();
+
+    return shared.back();
+}
+
+} // namespace
+
+struct Regularizer::Impl
+{
+    /// The parameters for the regularization
+    RegularizerOptions params;
+
+    /// The evaluation of the original objective function.
+    ObjectiveResult f;
+
+    //=============================================================================================
+    // Data related to trivial and linearly dependent constraints.
+    // Note that these members do not need to be recomputed with matrix A does not change.
+    //=============================================================================================
+    /// The preprocessing of the constraints of the last regularized problem, shared with other instances
+    std::shared_ptr<const RegularizerConstraints> constraints;
+
+    /// The values of the trivial variables
+    Vector xtrivial;
 
     //=============================================================================================
     // Data related to echelonization of the constraints (helps with round-off errors).
@@ -109,25 +222,22 @@ struct Regularizer::Impl
     /// The indices of basic/independent variables that compose the others in the last call.
     Indices ibasic_variables_last;
 
-    /// The full-pivoting LU decomposition of the coefficient matrices `A*` and `A(echelon)`.
-    LU lu_star, lu_echelon;
+    /// The full-pivoting LU decomposition of the coefficient matrix `A(echelon)`.
+    LU lu_echelon;
 
     /// Determine the trivial constraints and trivial variables.
     /// Trivial constraints are all those which fix the values of
     /// some variables (trivial variables) to the bounds.
-    /// This method should be called after `determineIfSameConstraints`.
+    /// The linearly dependent constraints are also determined here,
+    /// unless they were determined before for the same constraints.
     auto determineTrivialConstraints(const OptimumProblem& problem) -> void;
 
     /// Determine the values of the trivial variables.
     /// This method should be called after `determineTrivialConstraints`.
     auto determineTrivialVariables(const OptimumProblem& problem) -> void;
 
-    /// Determine the linearly dependent constraints.
-    /// This method should be called only after `determineTrivialConstraints`.
-    auto determineLinearlyDependentConstraints(const OptimumProblem& problem) -> void;
-
     /// Assemble the constraints in cannonical form to help in the prevention of round-off errors.
-    /// This method should be called only after `determineLinearlyDependentConstraints`.
+    /// This method should be called only after `determineTrivialConstraints`.
     auto assembleEchelonConstraints(const OptimumState& state) -> void;
 
     /// Remove all trivial constraints from the optimum problem.
@@ -175,15 +285,8 @@ auto Regularizer::Impl::determineTrivialConstraints(const OptimumProblem& proble
     const Vector& b = problem.b;
     const Vector& l = problem.l;
 
-    // The number of rows and cols in the original coefficient matrix
+    // The number of rows in the original coefficient matrix
     const Index m = A.rows();
-    const Index n = A.cols();
-
-    // Clear previous states of trivial and non-trivial constraints and variables
-    itrivial_constraints.clear();
-    itrivial_variables.clear();
-    inontrivial_constraints.clear();
-    inontrivial_variables.clear();
 
     // Return true if the i-th constraint forces the variables to be fixed on the lower bounds
     auto istrivial = [&](Index irow)
@@ -193,71 +296,27 @@ auto Regularizer::Impl::determineTrivialConstraints(const OptimumProblem& proble
     };
 
     // Determine the original equality constraints that fix variables on the lower bound
+    Indices itrivial;
     for(Index i = 0; i < m; ++i)
         if(istrivial(i))
-            itrivial_constraints.push_back(i);
+            itrivial.push_back(i);
 
-    // Skip the rest if there are no trivial constraints
-    if(itrivial_constraints.size())
-    {
-        // Determine the original trivial variables that are fixed at their lower bounds
-        for(Index i = 0; i < n; ++i)
-            for(Index j = 0; j < m; ++j)
-                if(A(j, i) != 0.0 && contained(j, itrivial_constraints))
-                    { itrivial_variables.push_back(i); break; }
+    // Skip the rest if neither `A` nor the trivial constraints changed since the last call,
+    // which is the common case of many calculations with the same partition of a chemical system
+    if(constraints && constraints->A.rows() == A.rows() && constraints->A.cols() == A.cols() &&
+        constraints->A == A && constraints->itrivial_constraints == itrivial)
+            return;
 
-        // Update  the indices of the non-trivial original constraints
-        inontrivial_constraints = difference(range(m), itrivial_constraints);
-
-        // Update the indices of the non-trivial original variables
-        inontrivial_variables = difference(range(n), itrivial_variables);
+    // Use the preprocessed constraints shared by all Regularizer instances with the same constraints
+    constraints = sharedRegularizerConstraints(A, itrivial);
 
-        // Initialize the matrix `A_star` by removing trivial constraints and variables
-        A_star = submatrix(A, inontrivial_constraints, inontrivial_variables);
-    }
-    else
-    {
-        // Initialize the matrix `A_star` as the original matrix A
-        A_star = A;
-    }
+    // Discard the last set of basic variables, since these were determined for another `A_star`
+    ibasic_variables_last.clear();
 }
 
 auto Regularizer::Impl::determineTrivialVariables(const OptimumProblem& problem) -> void
 {
-    xtrivial = rows(problem.l, itrivial_variables);
-}
-
-auto Regularizer::Impl::determineLinearlyDependentConstraints(const OptimumProblem& problem) -> void
-{
-    // The number of rows and cols in the coefficient matrix A*,
-    // i.e., the original A matrix with removed trivial constraints and variables
-    const Index m = A_star.rows();
-    const Index n = A_star.cols();
-
-    // Compute the LU decomposition of A*
-    lu_star.compute(A_star);
-
-    // Auxiliary references to LU components
-    const auto& P = lu_star.P;
-    const auto& rank = lu_star.rank;
-
-    // Check if all constraints are linearly independent
-    all_li = rank == m;
-
-    // Skip the rest if all non-trivial constraints are linearly independent
-    if(all_li)
-        return;
-
-    // Initialize the indices of the linearly independent constraints
-    ili_constraints = Indices(P.indices().data(), P.indices().data() + rank);
-
-    // Update the permutation matrix and the number of linearly independent constraints
-    P_li = lu_star.P;
-    m_li = lu_star.rank;
-
-    // Permute the rows of A and remove the linearly dependent ones
-    A_star = P_li * A_star;
-    A_star.conservativeResize(m_li, n);
+    xtrivial = rows(problem.l, constraints->itrivial_variables);
 }
 
 auto Regularizer::Impl::assembleEchelonConstraints(const OptimumState& state) -> void
@@ -273,13 +332,13 @@ auto Regularizer::Impl::assembleEchelonConstraints(const OptimumState& state) ->
         if(!std::isfinite(W[i])) W[i] = 1.0;
 
     // Remove all components in W corresponding to trivial variables
-    if(itrivial_constraints.size())
-        W = rows(W, inontrivial_variables);
+    if(constraints->itrivial_constraints.size())
+        W = rows(W, constraints->inontrivial_variables);
 
     // Compute the LU decomposition of matrix A_star with column-sorting weights.
     // Columsn corresponding to variables with higher weights are moved to the beginning of the matrix.
     // This gives preference for those variables to become linearly independent basis
-    lu_echelon.compute(A_star, W);
+    lu_echelon.compute(constraints->A_star, W);
 
     // Auxiliary references to LU components
     const auto& P = lu_echelon.P;
@@ -317,7 +376,7 @@ auto Regularizer::Impl::assembleEchelonConstraints(const OptimumState& state) ->
         P_echelon = P;
 
         // Compute the equality constraint regularization
-        A_echelon = P_echelon * A_star;
+        A_echelon = P_echelon * constraints->A_star;
         A_echelon = R * A_echelon;
 
         // Check if the regularizer matrix is composed of rationals.
@@ -335,7 +394,7 @@ auto Regularizer::Impl::removeTrivialConstraints(
     OptimumProblem& problem, OptimumState& state, OptimumOptions& options) -> void
 {
     // Skip the rest if there is no trivial constraint
-    if(itrivial_constraints.empty())
+    if(constraints->itrivial_constraints.empty())
         return;
 
     // The auxiliary vector used in the lambda functions below.
@@ -344,22 +403,22 @@ auto Regularizer::Impl::removeTrivialConstraints(
     Vector x = problem.l;
 
     // Set the number of primal variables as the number of non-trivial variables
-    problem.n = inontrivial_variables.size();
+    problem.n = constraints->inontrivial_variables.size();
 
     // Remove trivial components from problem.b
-    problem.b = rows(problem.b, inontrivial_constraints);
+    problem.b = rows(problem.b, constraints->inontrivial_constraints);
 
     // Remove trivial components from problem.c
     if(problem.c.rows())
-        problem.c = rows(problem.c, inontrivial_variables);
+        problem.c = rows(problem.c, constraints->inontrivial_variables);
 
     // Remove trivial components from problem.l
     if(problem.l.rows())
-        problem.l = rows(problem.l, inontrivial_variables);
+        problem.l = rows(problem.l, constraints->inontrivial_variables);
 
     // Remove trivial components from problem.u
     if(problem.u.rows())
-        problem.u = rows(problem.u, inontrivial_variables);
+        problem.u = rows(problem.u, constraints->inontrivial_variables);
 
     // Remove trivial components from problem.objective
     if(problem.objective)
@@ -373,36 +432,38 @@ auto Regularizer::Impl::removeTrivialConstraints(
         // Update the objective function
         problem.objective = [=](const Vector& X) mutable
         {
-            rows(x, inontrivial_variables) = X;
+            rows(x, constraints->inontrivial_variables) = X;
 
             f = original_objective(x);
 
             res.val = f.val;
-            res.grad = rows(f.grad, inontrivial_variables);
+            res.grad = rows(f.grad, constraints->inontrivial_variables);
             res.hessian.mode = f.hessian.mode;
 
             if(f.hessian.dense.size())
-                res.hessian.dense = submatrix(f.hessian.dense, inontrivial_variables, inontrivial_variables);
+                res.hessian.dense = submatrix(f.hessian.dense, constraints->inontrivial_variables, constraints->inontrivial_variables);
             if(f.hessian.diagonal.size())
-                res.hessian.diagonal = rows(f.hessian.diagonal, inontrivial_variables);
+                res.hessian.diagonal = rows(f.hessian.diagonal, constraints->inontrivial_variables);
             if(f.hessian.inverse.size())
-                res.hessian.inverse = submatrix(f.hessian.inverse, inontrivial_variables, inontrivial_variables);
+                res.hessian.inverse = submatrix(f.hessian.inverse, constraints->inontrivial_variables, constraints->inontrivial_variables);
+            if(f.hessian.blocks.size())
+                res.hessian.blocks = extract(f.hessian.blocks, constraints->inontrivial_variables);
 
             return res;
         };
     }
 
     // Remove trivial components corresponding to trivial variables and trivial constraints
-    state.x = rows(state.x, inontrivial_variables);
-    state.y = rows(state.y, inontrivial_constraints);
-    state.z = rows(state.z, inontrivial_variables);
+    state.x = rows(state.x, constraints->inontrivial_variables);
+    state.y = rows(state.y, constraints->inontrivial_constraints);
+    state.z = rows(state.z, constraints->inontrivial_variables);
 
     // Update the names of the constraints and variables accordingly
     if(options.output.active)
     {
-        options.output.xnames = extract(options.output.xnames, inontrivial_variables);
-        options.output.ynames = extract(options.output.ynames, inontrivial_constraints);
-        options.output.znames = extract(options.output.znames, inontrivial_variables);
+        options.output.xnames = extract(options.output.xnames, constraints->inontrivial_variables);
+        options.output.ynames = extract(options.output.ynames, constraints->inontrivial_constraints);
+        options.output.znames = extract(options.output.znames, constraints->inontrivial_variables);
     }
 }
 
@@ -410,20 +471,20 @@ auto Regularizer::Impl::removeLinearlyDependentConstraints(
     OptimumProblem& problem, OptimumState& state, OptimumOptions& options) -> void
 {
     // Skip the rest if A* has all rows linearly independent
-    if(all_li)
+    if(constraints->all_li)
         return;
 
     // Remove the components in b corresponding to linearly dependent constraints
-    problem.b = P_li * problem.b;
-    problem.b.conservativeResize(m_li);
+    problem.b = constraints->P_li * problem.b;
+    problem.b.conservativeResize(constraints->m_li);
 
     // Remove the components in y corresponding to linearly dependent constraints
-    state.y = P_li * state.y;
-    state.y.conservativeResize(m_li);
+    state.y = constraints->P_li * state.y;
+    state.y.conservativeResize(constraints->m_li);
 
     // Update the names of the dual components y
     if(options.output.active)
-        options.output.ynames = extract(options.output.ynames, ili_constraints);
+        options.output.ynames = extract(options.output.ynames, constraints->ili_constraints);
 }
 
 auto Regularizer::Impl::echelonizeConstraints(
@@ -448,7 +509,7 @@ auto Regularizer::Impl::echelonizeConstraints(
 
 auto Regularizer::Impl::updateConstraints(OptimumProblem& problem) -> void
 {
-    problem.A = params.echelonize && A_echelon.size() ? A_echelon : A_star;
+    problem.A = params.echelonize && A_echelon.size() ? A_echelon : constraints->A_star;
 }
 
 auto Regularizer::Impl::fixInfeasibleConstraints(OptimumProblem& problem) -> void
@@ -473,7 +534,6 @@ auto Regularizer::Impl::regularize(OptimumProblem& problem, OptimumState& state,
 {
     determineTrivialConstraints(problem);
     determineTrivialVariables(problem);
-    determineLinearlyDependentConstraints(problem);
     assembleEchelonConstraints(state);
 
     removeTrivialConstraints(problem, state, options);
@@ -486,17 +546,17 @@ auto Regularizer::Impl::regularize(OptimumProblem& problem, OptimumState& state,
 auto Regularizer::Impl::regularize(Vector& dgdp, Vector& dbdp) -> void
 {
     // Remove derivative components corresponding to trivial constraints
-    if(itrivial_constraints.size())
+    if(constraints->itrivial_constraints.size())
     {
-        dbdp = rows(dbdp, inontrivial_constraints);
-        dgdp = rows(dgdp, inontrivial_variables);
+        dbdp = rows(dbdp, constraints->inontrivial_constraints);
+        dgdp = rows(dgdp, constraints->inontrivial_variables);
     }
 
     // If there are linearly dependent constraints, remove corresponding components
-    if(!all_li)
+    if(!constraints->all_li)
     {
-        dbdp = P_li * dbdp;
-        dbdp.conservativeResize(m_li);
+        dbdp = constraints->P_li * dbdp;
+        dbdp.conservativeResize(constraints->m_li);
     }
 
     // Perform echelonization of the right-hand side vector if needed
@@ -510,16 +570,16 @@ auto Regularizer::Impl::regularize(Vector& dgdp, Vector& dbdp) -> void
 auto Regularizer::Impl::recover(OptimumState& state) -> void
 {
     // Calculate dual variables y w.r.t. original equality constraints
-    state.y = lu_star.trsolve(state.f.grad - state.z);
+    state.y = constraints->lu_star.trsolve(state.f.grad - state.z);
 
     // Check if there was any trivial variables and update state accordingly
-    if(itrivial_variables.size())
+    if(constraints->itrivial_variables.size())
     {
         // Define some auxiliary size variables
-        const Index nn = inontrivial_variables.size();
-        const Index nt = itrivial_variables.size();
-        const Index mn = inontrivial_constraints.size();
-        const Index mt = itrivial_constraints.size();
+        const Index nn = constraints->inontrivial_variables.size();
+        const Index nt = constraints->itrivial_variables.size();
+        const Index mn = constraints->inontrivial_constraints.size();
+        const Index mt = constraints->itrivial_constraints.size();
         const Index n = nn + nt;
         const Index m = mn + mt;
 
@@ -532,28 +592,28 @@ auto Regularizer::Impl::recover(OptimumState& state) -> void
         state.z.conservativeResize(n);
 
         // Set the components corresponding to non-trivial variables and constraints
-        rows(state.x, inontrivial_variables)   = state.x.segment(0, nn).eval();
-        rows(state.y, inontrivial_constraints) = state.y.segment(0, mn).eval();
-        rows(state.z, inontrivial_variables)   = state.z.segment(0, nn).eval();
+        rows(state.x, constraints->inontrivial_variables)   = state.x.segment(0, nn).eval();
+        rows(state.y, constraints->inontrivial_constraints) = state.y.segment(0, mn).eval();
+        rows(state.z, constraints->inontrivial_variables)   = state.z.segment(0, nn).eval();
 
         // Set the components corresponding to trivial variables and constraints
-        rows(state.x, itrivial_variables)   = xtrivial;
-        rows(state.y, itrivial_constraints).fill(0.0);
-        rows(state.z, itrivial_variables).fill(0.0);
+        rows(state.x, constraints->itrivial_variables)   = xtrivial;
+        rows(state.y, constraints->itrivial_constraints).fill(0.0);
+        rows(state.z, constraints->itrivial_variables).fill(0.0);
     }
 }
 
 auto Regularizer::Impl::recover(Vector& dxdp) -> void
 {
     // Set the components corresponding to trivial and non-trivial variables
-    if(itrivial_constraints.size())
+    if(constraints->itrivial_constraints.size())
     {
-        const Index nn = inontrivial_variables.size();
-        const Index nt = itrivial_variables.size();
+        const Index nn = constraints->inontrivial_variables.size();
+        const Index nt = constraints->itrivial_variables.size();
         const Index n = nn + nt;
         dxdp.conservativeResize(n);
-        rows(dxdp, inontrivial_variables) = dxdp.segment(0, nn).eval();
-        rows(dxdp, itrivial_variables).fill(0.0);
+        rows(dxdp, constraints->inontrivial_variables) = dxdp.segment(0, nn).eval();
+        rows(dxdp, constraints->itrivial_variables).fill(0.0);
     }
 }
 
@@ -25,6 +25,7 @@
 #include <Reaktoro/Math.hpp>
 #include <Reaktoro/Optimization.hpp>
 #include <Reaktoro/Thermodynamics.hpp>
+#include <Reaktoro/Transport.hpp>
 #include <Reaktoro/Utils.hpp>
 
 /// The namespace containing all components of the Reaktoro library.
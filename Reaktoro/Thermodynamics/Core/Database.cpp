@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -54,6 +55,19 @@ using AqueousSpeciesMap = std::map<std::string, AqueousSpecies>;
 using GaseousSpeciesMap = std::map<std::string, GaseousSpecies>;
 using MineralSpeciesMap = std::map<std::string, MineralSpecies>;
 
+/// A species indexed in the database whose thermodynamic data has not been parsed yet
+struct SpeciesEntry
+{
+    /// The species with its name, formula and elements already parsed
+    Species species;
+
+    /// The xml node of the species in the database document
+    xml_node node;
+};
+
+/// Auxiliary type for a map of indexed species
+using SpeciesEntryMap = std::map<std::string, SpeciesEntry>;
+
 auto errorNonExistentSpecies(std::string type, std::string name) -> void
 {
     Exception exception;
@@ -362,16 +376,57 @@ auto collectSpecies(const std::map<std::string, SpeciesType>& map, const Species
     return std::vector<SpeciesType>(species.begin(), species.end());
 }
 
-template<typename SpeciesType>
-auto speciesWithElements(const std::vector<std::string>& elements, const std::map<std::string, SpeciesType>& map) -> std::vector<SpeciesType>
+/// Return true if a species has all its chemical elements in a list of elements (ignoring charge Z)
+auto containsOnlyElements(const Species& species, const std::vector<std::string>& elements) -> bool
 {
+    for(const auto& pair : species.elements())
+        if(pair.first.name() != "Z" && !contained(pair.first.name(), elements))
+            return false;
+    return true;
+}
+
+/// Return a species in the database, parsing its thermodynamic data on the first request.
+/// A null pointer is returned if the species is neither parsed nor indexed.
+template<typename SpeciesType, typename ParseFunction>
+auto materializeSpecies(std::string name, const SpeciesEntryMap& index, std::map<std::string, SpeciesType>& map, const ParseFunction& parse) -> const SpeciesType*
+{
+    auto iter = map.find(name);
+    if(iter != map.end())
+        return &iter->second;
+
+    auto entry = index.find(name);
+    if(entry == index.end())
+        return nullptr;
+
+    return &map.emplace(name, parse(entry->second)).first->second;
+}
+
+/// Return all species in the database, parsing the thermodynamic data of those not yet requested.
+template<typename SpeciesType, typename ParseFunction>
+auto materializeAllSpecies(const SpeciesEntryMap& index, std::map<std::string, SpeciesType>& map, const ParseFunction& parse) -> std::vector<SpeciesType>
+{
+    for(const auto& entry : index)
+        materializeSpecies(entry.first, index, map, parse);
+
+    std::vector<SpeciesType> species;
+    species.reserve(map.size());
+    for(const auto& pair : map)
+        species.push_back(pair.second);
+    return species;
+}
+
+/// Return the species with all their elements in a list of elements.
+/// Only the indexed species whose elements match are parsed into full species instances.
+template<typename SpeciesType, typename ParseFunction>
+auto speciesWithElements(const std::vector<std::string>& elements, const SpeciesEntryMap& index, std::map<std::string, SpeciesType>& map, const ParseFunction& parse) -> std::vector<SpeciesType>
+{
+    for(const auto& entry : index)
+        if(containsOnlyElements(entry.second.species, elements))
+            materializeSpecies(entry.first, index, map, parse);
+
     auto f = [&](const SpeciesType& species)
     {
-        // Check if the given species has all chemical elements in the list of elements (ignore charge Z)
-        for(auto pair : species.elements())
-            if(pair.first.name() != "Z" && !contained(pair.first.name(), elements))
-                return false;
-        return true;
+        return containsOnlyElements(species, elements);
     };
 
     return collectSpecies(map, f);
@@ -381,25 +436,41 @@ auto speciesWithElements(const std::vector<std::string>& elements, const std::ma
 
 struct Database::Impl
 {
+    /// The xml document of the database, kept alive for the lazy parsing of species
+    std::shared_ptr<xml_document> doc;
+
     /// The set of all elements in the database
     ElementMap element_map;
 
-    /// The set of all aqueous species in the database
+    /// The set of aqueous species in the database that have been requested or added
     AqueousSpeciesMap aqueous_species_map;
 
-    /// The set of all gaseous species in the database
+    /// The set of gaseous species in the database that have been requested or added
     GaseousSpeciesMap gaseous_species_map;
 
-    /// The set of all mineral species in the database
+    /// The set of mineral species in the database that have been requested or added
     MineralSpeciesMap mineral_species_map;
 
+    /// The index of all aqueous species in the database document
+    SpeciesEntryMap aqueous_species_index;
+
+    /// The index of all gaseous species in the database document
+    SpeciesEntryMap gaseous_species_index;
+
+    /// The index of all mineral species in the database document
+    SpeciesEntryMap mineral_species_index;
+
+    /// The mutex that guards the lazy parsing of species
+    std::mutex mutex;
+
     Impl()
     {}
 
     Impl(std::string filename)
+    : doc(new xml_document())
     {
-        // Create the XML document
-        xml_document doc;
+        // Alias to the XML document
+        xml_document& doc = *this->doc;
 
         // Load the xml database file
         auto result = doc.load_file(filename.c_str());
@@ -440,96 +511,116 @@ struct Database::Impl
 
     auto addElement(const Element& element) -> void
     {
+        std::lock_guard<std::mutex> lock(mutex);
         element_map.insert({element.name(), element});
     }
 
     auto addAqueousSpecies(const AqueousSpecies& species) -> void
     {
-        aqueous_species_map.insert({species.name(), species});
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!aqueous_species_index.count(species.name()))
+            aqueous_species_map.insert({species.name(), species});
     }
 
     auto addGaseousSpecies(const GaseousSpecies& species) -> void
     {
-        gaseous_species_map.insert({species.name(), species});
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!gaseous_species_index.count(species.name()))
+            gaseous_species_map.insert({species.name(), species});
     }
 
     auto addMineralSpecies(const MineralSpecies& species) -> void
     {
-        mineral_species_map.insert({species.name(), species});
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!mineral_species_index.count(species.name()))
+            mineral_species_map.insert({species.name(), species});
     }
 
     auto elements() -> std::vector<Element>
     {
+        std::lock_guard<std::mutex> lock(mutex);
         return collectValues(element_map);
     }
 
     auto aqueousSpecies() -> std::vector<AqueousSpecies>
     {
-        return collectValues(aqueous_species_map);
+        std::lock_guard<std::mutex> lock(mutex);
+        return materializeAllSpecies(aqueous_species_index, aqueous_species_map, parseAqueousSpecies);
     }
 
-    auto aqueousSpecies(std::string name) const -> const AqueousSpecies&
+    auto aqueousSpecies(std::string name) -> const AqueousSpecies&
     {
-        if(aqueous_species_map.count(name) == 0)
+        std::lock_guard<std::mutex> lock(mutex);
+        auto species = materializeSpecies(name, aqueous_species_index, aqueous_species_map, parseAqueousSpecies);
+        if(!species)
             errorNonExistentSpecies("aqueous", name);
-
-        return aqueous_species_map.find(name)->second;
+        return *species;
     }
 
     auto gaseousSpecies() -> std::vector<GaseousSpecies>
     {
-        return collectValues(gaseous_species_map);
+        std::lock_guard<std::mutex> lock(mutex);
+        return materializeAllSpecies(gaseous_species_index, gaseous_species_map, parseGaseousSpecies);
     }
 
-    auto gaseousSpecies(std::string name) const -> const GaseousSpecies&
+    auto gaseousSpecies(std::string name) -> const GaseousSpecies&
     {
-        if(gaseous_species_map.count(name) == 0)
+        std::lock_guard<std::mutex> lock(mutex);
+        auto species = materializeSpecies(name, gaseous_species_index, gaseous_species_map, parseGaseousSpecies);
+        if(!species)
             errorNonExistentSpecies("gaseous", name);
-
-        return gaseous_species_map.find(name)->second;
+        return *species;
     }
 
     auto mineralSpecies() -> std::vector<MineralSpecies>
     {
-        return collectValues(mineral_species_map);
+        std::lock_guard<std::mutex> lock(mutex);
+        return materializeAllSpecies(mineral_species_index, mineral_species_map, parseMineralSpecies);
     }
 
-    auto mineralSpecies(std::string name) const -> const MineralSpecies&
+    auto mineralSpecies(std::string name) -> const MineralSpecies&
     {
-        if(mineral_species_map.count(name) == 0)
+        std::lock_guard<std::mutex> lock(mutex);
+        auto species = materializeSpecies(name, mineral_species_index, mineral_species_map, parseMineralSpecies);
+        if(!species)
             errorNonExistentSpecies("mineral", name);
-
-        return mineral_species_map.find(name)->second;
+        return *species;
     }
 
-    auto containsAqueousSpecies(std::string species) const -> bool
+    auto containsAqueousSpecies(std::string species) -> bool
     {
-        return aqueous_species_map.count(species) != 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        return aqueous_species_index.count(species) || aqueous_species_map.count(species);
     }
 
-    auto containsGaseousSpecies(std::string species) const -> bool
+    auto containsGaseousSpecies(std::string species) -> bool
     {
-        return gaseous_species_map.count(species) != 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        return gaseous_species_index.count(species) || gaseous_species_map.count(species);
     }
 
-    auto containsMineralSpecies(std::string species) const -> bool
+    auto containsMineralSpecies(std::string species) -> bool
     {
-        return mineral_species_map.count(species) != 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        return mineral_species_index.count(species) || mineral_species_map.count(species);
     }
 
-    auto aqueousSpeciesWithElements(const std::vector<std::string>& elements) const -> std::vector<AqueousSpecies>
+    auto aqueousSpeciesWithElements(const std::vector<std::string>& elements) -> std::vector<AqueousSpecies>
     {
-        return speciesWithElements(elements, aqueous_species_map);
+        std::lock_guard<std::mutex> lock(mutex);
+        return speciesWithElements(elements, aqueous_species_index, aqueous_species_map, parseAqueousSpecies);
     }
 
-    auto gaseousSpeciesWithElements(const std::vector<std::string>& elements) const -> std::vector<GaseousSpecies>
+    auto gaseousSpeciesWithElements(const std::vector<std::string>& elements) -> std::vector<GaseousSpecies>
     {
-        return speciesWithElements(elements, gaseous_species_map);
+        std::lock_guard<std::mutex> lock(mutex);
+        return speciesWithElements(elements, gaseous_species_index, gaseous_species_map, parseGaseousSpecies);
     }
 
-    auto mineralSpeciesWithElements(const std::vector<std::string>& elements) const -> std::vector<MineralSpecies>
+    auto mineralSpeciesWithElements(const std::vector<std::string>& elements) -> std::vector<MineralSpecies>
     {
-        return speciesWithElements(elements, mineral_species_map);
+        std::lock_guard<std::mutex> lock(mutex);
+        return speciesWithElements(elements, mineral_species_index, mineral_species_map, parseMineralSpecies);
     }
 
     auto parse(const xml_document& doc, std::string databasename) -> void
@@ -548,30 +639,23 @@ struct Database::Impl
         element_map["Z"] = Element();
         element_map["Z"].setName("Z");
 
-        // Read all species in the database
+        // Index all species in the database, deferring the parsing of their thermodynamic data
         for(xml_node node : database.children("Species"))
         {
             std::string type = node.child("Type").text().get();
             std::string name = node.child("Name").text().get();
 
-            if(type == "Aqueous")
+            if(type == "Aqueous" || type == "Gaseous" || type == "Mineral")
             {
-                AqueousSpecies species = parseAqueousSpecies(node);
-                if(valid(species))
-                    aqueous_species_map[species.name()] = species;
-            }
-            else if(type == "Gaseous")
-            {
-                GaseousSpecies species = parseGaseousSpecies(node);
-                if(valid(species))
-                    gaseous_species_map[species.name()] = species;
-            }
-
-            else if(type == "Mineral")
-            {
-                MineralSpecies species = parseMineralSpecies(node);
-                if(valid(species))
-                    mineral_species_map[species.name()] = species;
+                SpeciesEntry entry = {parseSpecies(node), node};
+                if(!valid(entry))
+                    continue;
+                if(type == "Aqueous")
+                    aqueous_species_index[name] = entry;
+                else if(type == "Gaseous")
+                    gaseous_species_index[name] = entry;
+                else
+                    mineral_species_index[name] = entry;
             }
             else RuntimeError("Could not parse the species `" +
                 name + "` with type `" + type + "` in the database `" +
@@ -624,10 +708,13 @@ struct Database::Impl
         return species;
     }
 
-    auto parseAqueousSpecies(const xml_node& node) -> AqueousSpecies
+    static auto parseAqueousSpecies(const SpeciesEntry& entry) -> AqueousSpecies
     {
+        // The xml node of the aqueous species
+        const xml_node& node = entry.node;
+
         // The aqueous species instance
-        AqueousSpecies species = parseSpecies(node);
+        AqueousSpecies species = entry.species;
 
         // Set the elemental charge of the species
         species.setCharge(node.child("Charge").text().as_double());
@@ -641,10 +728,13 @@ struct Database::Impl
         return species;
     }
 
-    auto parseGaseousSpecies(const xml_node& node) -> GaseousSpecies
+    static auto parseGaseousSpecies(const SpeciesEntry& entry) -> GaseousSpecies
     {
+        // The xml node of the gaseous species
+        const xml_node& node = entry.node;
+
         // The gaseous species instance
-        GaseousSpecies species = parseSpecies(node);
+        GaseousSpecies species = entry.species;
 
         // Set the critical temperature of the gaseous species (in units of K)
         if(!node.child("CriticalTemperature").empty())
@@ -664,10 +754,13 @@ struct Database::Impl
         return species;
     }
 
-    auto parseMineralSpecies(const xml_node& node) -> MineralSpecies
+    static auto parseMineralSpecies(const SpeciesEntry& entry) -> MineralSpecies
     {
+        // The xml node of the mineral species
+        const xml_node& node = entry.node;
+
         // The mineral species instance
-        MineralSpecies species = parseSpecies(node);
+        MineralSpecies species = entry.species;
 
         // Parse the thermodynamic data of the mineral species
         species.setThermoData(parseMineralSpeciesThermoData(node.child("Thermo")));
@@ -675,10 +768,13 @@ struct Database::Impl
         return species;
     }
 
-    /// Return true if a species instance has correct and complete data
-    template<typename SpeciesType>
-    auto valid(const SpeciesType& species) const -> bool
+    /// Return true if an indexed species has correct and complete data
+    auto valid(const SpeciesEntry& entry) const -> bool
     {
+        // The species and its HKF node in the database document
+        const Species& species = entry.species;
+        const xml_node hkf = entry.node.child("Thermo").child("HKF");
+
         // Skip validation if even species with missing data should be considered
         if(!global::options.database.exclude_species_with_missing_data)
             return true;
@@ -694,10 +790,9 @@ struct Database::Impl
             return false;
 
         // Check if HKF parameters exist, but they are incomplete
-        const auto& hkf = species.thermoData().hkf;
-        if(!hkf.empty() && !std::isfinite(hkf.get().Gf))
+        if(!hkf.empty() && !std::isfinite(as_double(hkf, "Gf")))
             return false;
-        if(!hkf.empty() && !std::isfinite(hkf.get().Hf))
+        if(!hkf.empty() && !std::isfinite(as_double(hkf, "Hf")))
             return false;
 
         return true;
@@ -70,7 +70,10 @@ public:
     /// If `filename` does not point to a valid database file or the
     /// database file is not found, then a default built-in database
     /// with the same name will be tried. If no default built-in database
-    /// exist with given name, an exception will be thrown.
+    /// exist with given name, an exception will be thrown. The species
+    /// in the database are only indexed by name and elements during
+    /// construction, and their thermodynamic data is parsed on the
+    /// first request of each species.
     /// @param filename The name of the database file
     explicit Database(std::string filename);
 
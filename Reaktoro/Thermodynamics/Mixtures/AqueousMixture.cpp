@@ -23,6 +23,7 @@
 // Reaktoro includes
 #include <Reaktoro/Common/NamingUtils.hpp>
 #include <Reaktoro/Common/InterpolationUtils.hpp>
+#include <Reaktoro/Common/OptimizationUtils.hpp>
 #include <Reaktoro/Common/SetUtils.hpp>
 #include <Reaktoro/Thermodynamics/Water/WaterConstants.hpp>
 #include <Reaktoro/Thermodynamics/Water/WaterElectroState.hpp>
@@ -73,11 +74,16 @@ AqueousMixture::AqueousMixture(const std::vector<AqueousSpecies>& species)
     // Initialize the dissociation matrix of the neutral species w.r.t. the charged species
     initializeDissociationMatrix(species);
 
+    // Initialize the weights of the molalities in the ionic strengths
+    initializeIonicStrengthWeights();
+
     // Initialize the density function for water
-    rho = rho_default = internal::defaultWaterDensityFunction();
+    rho_default = internal::defaultWaterDensityFunction();
+    setWaterDensity(rho_default);
 
     // Initialize the dielectric constant function for water
-    epsilon = epsilon_default = internal::defaultWaterDielectricConstantFunction();
+    epsilon_default = internal::defaultWaterDielectricConstantFunction();
+    setWaterDielectricConstant(epsilon_default);
 }
 
 AqueousMixture::~AqueousMixture()
@@ -85,18 +91,21 @@ AqueousMixture::~AqueousMixture()
 
 auto AqueousMixture::setWaterDensity(const ThermoScalarFunction& rho) -> void
 {
-    this->rho = rho;
+    // The density of water is cached for the last (T, P) because the mixture state is evaluated
+    // at every iteration of a chemical calculation, whereas temperature and pressure seldom change
+    this->rho = memoizeLast(rho);
 }
 
 auto AqueousMixture::setWaterDielectricConstant(const ThermoScalarFunction& epsilon) -> void
 {
-    this->epsilon = epsilon;
+    // The dielectric constant of water is also cached for the last (T, P)
+    this->epsilon = memoizeLast(epsilon);
 }
 
 auto AqueousMixture::setInterpolationPoints(const std::vector<double>& temperatures, const std::vector<double>& pressures) -> void
 {
-    rho = interpolate(temperatures, pressures, rho_default);
-    epsilon = interpolate(temperatures, pressures, epsilon_default);
+    setWaterDensity(interpolate(temperatures, pressures, rho_default));
+    setWaterDielectricConstant(interpolate(temperatures, pressures, epsilon_default));
 }
 
 auto AqueousMixture::numNeutralSpecies() const -> unsigned
@@ -210,12 +219,12 @@ auto AqueousMixture::chargesAnions() const -> Vector
     return rows(chargesSpecies(), indicesAnions());
 }
 
-auto AqueousMixture::molalities(const Vector& n) const -> ChemicalVector
+auto AqueousMixture::molalities(const Vector& n) const -> ChemicalVectorStructured
 {
     const unsigned num_species = numSpecies();
 
     // The molalities of the species and their partial derivatives
-    ChemicalVector m(num_species);
+    ChemicalVectorStructured m(num_species);
 
     // The molar amount of water
     const double nw = n[idx_water];
@@ -226,12 +235,12 @@ auto AqueousMixture::molalities(const Vector& n) const -> ChemicalVector
 
     const double kgH2O = nw * waterMolarMass;
 
+    // The derivatives have the structure diag(1/kgH2O) - (m/nw)*e(w)^T, with
+    // e(w) the unit vector of water
     m.val = n/kgH2O;
-    for(unsigned i = 0; i < num_species; ++i)
-    {
-        m.ddn(i, i) = 1.0/kgH2O;
-        m.ddn(i, idx_water) -= m.val[i]/nw;
-    }
+    m.d.fill(1.0/kgH2O);
+    m.u = -m.val/nw;
+    m.v[idx_water] = 1.0;
 
     return m;
 }
@@ -267,9 +276,8 @@ auto AqueousMixture::effectiveIonicStrength(const ChemicalVector& m) const -> Ch
     const Vector z = chargesSpecies();
 
     ChemicalScalar Ie(num_species);
-    Ie.val = 0.5 * sum(z % z % m.val);
-    for(unsigned i = 0; i < num_species; ++i)
-        Ie.ddn[i] = 0.5 * sum(z % z % m.ddn.col(i));
+    Ie.val = 0.5 * dot(z % z, m.val);
+    Ie.ddn.noalias() = 0.5 * tr(m.ddn) * (z % z);
 
     return Ie;
 }
@@ -280,9 +288,8 @@ auto AqueousMixture::stoichiometricIonicStrength(const ChemicalVector& ms) const
     const Vector zc = chargesChargedSpecies();
 
     ChemicalScalar Is(num_species);
-    Is.val = 0.5 * sum(zc % zc % ms.val);
-    for(unsigned i = 0; i < num_species; ++i)
-        Is.ddn[i] = 0.5 * sum(zc % zc % ms.ddn.col(i));
+    Is.val = 0.5 * dot(zc % zc, ms.val);
+    Is.ddn.noalias() = 0.5 * tr(ms.ddn) * (zc % zc);
 
     return Is;
 }
@@ -292,13 +299,51 @@ auto AqueousMixture::state(double T, double P, const Vector& n) const -> Aqueous
     AqueousMixtureState res;
     res.T = T;
     res.P = P;
-    res.x = molarFractions(n);
+    res.x = ChemicalVector(molarFractions(n));
     res.rho = rho(T, P);
     res.epsilon = epsilon(T, P);
-    res.m  = molalities(n);
-    res.ms = stoichiometricMolalities(res.m);
-    res.Ie = effectiveIonicStrength(res.m);
-    res.Is = stoichiometricIonicStrength(res.ms);
+
+    // The molalities are kept in structured form until they are stored in the
+    // state, which is where the activity models read their dense derivatives
+    const ChemicalVectorStructured m = molalities(n);
+    res.m = ChemicalVector(m);
+
+    const unsigned num_species = numSpecies();
+    const unsigned num_charged = numChargedSpecies();
+    const unsigned num_neutral = numNeutralSpecies();
+
+    res.ms = ChemicalVector(num_charged, num_species);
+    res.Ie = ChemicalScalar(num_species);
+    res.Is = ChemicalScalar(num_species);
+
+    // The molar amount of water
+    const double nw = n[idx_water];
+
+    // Check if the molar amount of water is zero
+    if(nw == 0.0)
+        return res;
+
+    // The molalities have derivatives diag(1/kgH2O) - (m/nw)*e(w)^T, so the
+    // stoichiometric molalities and the ionic strengths, all linear in m, have
+    // derivatives that can be assembled from this structure without any dense products
+
+    // The stoichiometric molalities of the charged species
+    const Vector mc = rows(m.val, idx_charged_species);
+    const Vector mn = rows(m.val, idx_neutral_species);
+    res.ms.val = mc + tr(dissociation_matrix) * mn;
+    for(unsigned i = 0; i < num_charged; ++i)
+    {
+        const Index ic = idx_charged_species[i];
+        res.ms.ddn(i, ic) = m.d[ic];
+        for(unsigned j = 0; j < num_neutral; ++j)
+            res.ms.ddn(i, idx_neutral_species[j]) += dissociation_matrix(j, i) * m.d[idx_neutral_species[j]];
+        res.ms.ddn(i, idx_water) -= res.ms.val[i]/nw;
+    }
+
+    // The effective and stoichiometric ionic strengths as weighted sums of molalities
+    res.Ie = dot(0.5 * effective_ionic_strength_weights, m);
+    res.Is = dot(0.5 * stoichiometric_ionic_strength_weights, m);
+
     return res;
 }
 
@@ -344,4 +389,19 @@ auto AqueousMixture::initializeDissociationMatrix(const std::vector<AqueousSpeci
             dissociation_matrix(i, j) = stoichiometry(i, j);
 }
 
+auto AqueousMixture::initializeIonicStrengthWeights() -> void
+{
+    const Vector z = chargesSpecies();
+    const Vector zc = chargesChargedSpecies();
+
+    // The effective ionic strength weights every molality with its squared charge
+    effective_ionic_strength_weights = z % z;
+
+    // The stoichiometric ionic strength weights the molality of every ion with its
+    // squared charge, and that of every complex with the squared charges of its ions
+    stoichiometric_ionic_strength_weights = zeros(numSpecies());
+    rows(stoichiometric_ionic_strength_weights, idx_charged_species) = zc % zc;
+    rows(stoichiometric_ionic_strength_weights, idx_neutral_species) = Vector(dissociation_matrix * (zc % zc));
+}
+
 } // namespace Reaktoro
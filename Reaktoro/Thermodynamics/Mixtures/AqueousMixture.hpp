@@ -164,8 +164,8 @@ public:
 
     /// Calculate the molalities of the aqueous species and its molar derivatives.
     /// @param n The molar abundance of species (in units of mol)
-    /// @return The molalities and their partial derivatives
-    auto molalities(const Vector& n) const -> ChemicalVector;
+    /// @return The molalities and their partial derivatives in diagonal plus rank-one form
+    auto molalities(const Vector& n) const -> ChemicalVectorStructured;
 
     /// Calculate the stoichiometric molalities of the ions and its molar derivatives.
     /// @param m The molalities of the aqueous species and their partial derivatives
@@ -183,6 +183,8 @@ public:
     auto stoichiometricIonicStrength(const ChemicalVector& ms) const -> ChemicalScalar;
 
     /// Calculate the state of the aqueous mixture.
+    /// The density and dielectric constant of water are cached for the last temperature and pressure,
+    /// so that only the composition-dependent quantities are recomputed if these do not change.
     /// @param T The temperature (in units of K)
     /// @param P The pressure (in units of Pa)
     /// @param n The molar amounts of the species in the mixture (in units of mol)
@@ -207,10 +209,16 @@ private:
     /// The matrix that represents the dissociation of the aqueous complexes into ions
     Matrix dissociation_matrix;
 
-    /// The density function for water
+    /// The weights of the molalities in the effective ionic strength (squared charges of the species)
+    Vector effective_ionic_strength_weights;
+
+    /// The weights of the molalities in the stoichiometric ionic strength
+    Vector stoichiometric_ionic_strength_weights;
+
+    /// The density function for water (cached for the last temperature and pressure) and its default
     ThermoScalarFunction rho, rho_default;
 
-    /// The dielectric constant function for water
+    /// The dielectric constant function for water (cached for the last temperature and pressure) and its default
     ThermoScalarFunction epsilon, epsilon_default;
 
     /// Initialize the index related data of the species.
@@ -218,6 +226,9 @@ private:
 
     /// Initialize the dissociation matrix of the neutral species w.r.t. the charged species.
     void initializeDissociationMatrix(const std::vector<AqueousSpecies>& species);
+
+    /// Initialize the weights of the molalities in the effective and stoichiometric ionic strengths.
+    auto initializeIonicStrengthWeights() -> void;
 };
 
 } // namespace Reaktoro
@@ -35,7 +35,7 @@ auto GaseousMixture::state(double T, double P, const Vector& n) const -> Gaseous
     GaseousMixtureState res;
     res.T = T;
     res.P = P;
-    res.x = molarFractions(n);
+    res.x = ChemicalVector(molarFractions(n));
     return res;
 }
 
@@ -25,6 +25,7 @@
 #include <Reaktoro/Common/Index.hpp>
 #include <Reaktoro/Common/ChemicalScalar.hpp>
 #include <Reaktoro/Common/ChemicalVector.hpp>
+#include <Reaktoro/Common/ChemicalVectorStructured.hpp>
 #include <Reaktoro/Common/ScalarTypes.hpp>
 #include <Reaktoro/Common/SetUtils.hpp>
 #include <Reaktoro/Common/ThermoScalar.hpp>
@@ -103,8 +104,8 @@ public:
 
     /// Calculates the molar fractions of the species and their partial derivatives
     /// @param n The molar abundance of the species (in units of mol)
-    /// @return The molar fractions and their partial derivatives
-    auto molarFractions(const Vector& n) const -> ChemicalVector;
+    /// @return The molar fractions and their partial derivatives in diagonal plus rank-one form
+    auto molarFractions(const Vector& n) const -> ChemicalVectorStructured;
 
     /// Calculate the state of the mixture.
     /// @param T The temperature (in units of K)
@@ -195,25 +196,9 @@ auto GeneralMixture<SpeciesType>::chargesSpecies() const -> Vector
 }
 
 template<class SpeciesType>
-auto GeneralMixture<SpeciesType>::molarFractions(const Vector& n) const -> ChemicalVector
+auto GeneralMixture<SpeciesType>::molarFractions(const Vector& n) const -> ChemicalVectorStructured
 {
-    const unsigned nspecies = numSpecies();
-    if(nspecies == 1)
-    {
-        ChemicalVector x(1);
-        x.val[0] = 1.0;
-        return x;
-    }
-    ChemicalVector x(nspecies);
-    const double nt = n.sum();
-    if(nt == 0.0) return x;
-    x.val = n/nt;
-    for(unsigned i = 0; i < nspecies; ++i)
-    {
-        x.ddn.row(i).fill(-x.val[i]/nt);
-        x.ddn(i, i) += 1.0/nt;
-    }
-    return x;
+    return Reaktoro::molarFractions(n);
 }
 
 template<class SpeciesType>
@@ -222,7 +207,7 @@ auto GeneralMixture<SpeciesType>::state(double T, double P, const Vector& n) con
     MixtureState res;
     res.T = T;
     res.P = P;
-    res.x = molarFractions(n);
+    res.x = ChemicalVector(molarFractions(n));
     return res;
 }
 
@@ -39,7 +39,7 @@ auto MineralMixture::state(double T, double P, const Vector& n) const -> Mineral
     MineralMixtureState res;
     res.T = T;
     res.P = P;
-    res.x = molarFractions(n);
+    res.x = ChemicalVector(molarFractions(n));
     return res;
 }
 
@@ -18,6 +18,7 @@
 #include "AqueousChemicalModelDebyeHuckel.hpp"
 
 // C++ includes
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -61,35 +62,65 @@ auto aqueousChemicalModelDebyeHuckel(const AqueousMixture& mixture, const DebyeH
     // The electrical charges of the charged species only
     const Vector charges = mixture.chargesChargedSpecies();
 
+    // The squared electrical charges of the charged species
+    const Vector z2 = charges.array().square();
+
     // The Debye-Huckel parameters a and b of the charged species
-    std::vector<double> aions, bions;
+    Vector aions(num_charged_species), bions(num_charged_species);
 
     // The Debye-Huckel parameter b of the neutral species
-    std::vector<double> bneutral;
+    Vector bneutral(num_neutral_species);
 
     // Collect the Debye-Huckel parameters a and b of the charged species
-    for(Index i : icharged_species)
+    for(Index i = 0; i < num_charged_species; ++i)
     {
-        const AqueousSpecies& species = mixture.species(i);
-        aions.push_back(params.aion(species.name()));
-        bions.push_back(params.bion(species.name()));
+        const AqueousSpecies& species = mixture.species(icharged_species[i]);
+        aions[i] = params.aion(species.name());
+        bions[i] = params.bion(species.name());
     }
 
     // Collect the Debye-Huckel parameter b of the neutral species
-    for(Index i : ineutral_species)
+    for(Index i = 0; i < num_neutral_species; ++i)
     {
-        const AqueousSpecies& species = mixture.species(i);
-        bneutral.push_back(params.bneutral(species.name()));
+        const AqueousSpecies& species = mixture.species(ineutral_species[i]);
+        bneutral[i] = params.bneutral(species.name());
     }
 
     // The result of the activity model
     PhaseChemicalModelResult res(num_species);
 
     // Auxiliary variables
-    ChemicalScalar xw, ln_xw, I2, sqrtI, mSigma, sigma(num_species), sigmacoeff, Lambda;
-    ChemicalVector ln_m;
+    ChemicalScalar xw, ln_xw, mSigma, W;
     ThermoScalar A, B, sqrt_rho, T_epsilon, sqrt_T_epsilon;
 
+    // The molalities of the charged species
+    Vector mi(num_charged_species);
+
+    // The parameters u = a*B*sqrt(I) and Lambda = 1 + u of the charged species
+    Vector u(num_charged_species), Lambda(num_charged_species);
+
+    // The sigma parameters of the charged species and their derivatives with respect to u
+    Vector sigma(num_charged_species), sigma_u(num_charged_species);
+
+    // The ln activity coefficients of the charged species and their partial derivatives with respect to A, B, and I
+    Vector lng(num_charged_species), lng_A(num_charged_species), lng_B(num_charged_species), lng_I(num_charged_species);
+
+    // The contributions of the charged species to the ln activity of water (excluding the term mi*ln(gi)) and their partial derivatives with respect to A, B, and I
+    Vector hw(num_charged_species), hw_A(num_charged_species), hw_B(num_charged_species), hw_I(num_charged_species);
+
+    // The ln activity coefficients of the charged species scattered over all species (zero for the other species)
+    Vector ln_g_ions = zeros(num_species);
+
+    // The partial derivatives of the ln activity coefficients of all species with respect to A, B, and I (zero for water)
+    Vector ln_g_A = zeros(num_species), ln_g_B = zeros(num_species), ln_g_I = zeros(num_species);
+
+    // The reciprocal of the molalities of all species
+    Vector inv_m(num_species);
+
+    // Set the partial derivatives of the ln activity coefficients of the neutral species with respect to I
+    for(Index i = 0; i < num_neutral_species; ++i)
+        ln_g_I[ineutral_species[i]] = ln10 * bneutral[i];
+
     // Define the intermediate chemical model function of the aqueous mixture
     auto model = [=](const AqueousMixtureState& state) mutable
     {
@@ -107,70 +138,95 @@ auto aqueousChemicalModelDebyeHuckel(const AqueousMixture& mixture, const DebyeH
         auto& ln_c = res.ln_activity_constants;
 
         // Update auxiliary variables
-		ln_m = log(m);
-		xw = x[iwater];
-		ln_xw = log(xw);
-		mSigma = nwo * (1 - xw)/xw;
-		I2 = I*I;
-		sqrtI = sqrt(I);
-		sqrt_rho = sqrt(rho);
-		T_epsilon = T * epsilon;
-		sqrt_T_epsilon = sqrt(T_epsilon);
-		A = 1.824829238e+6 * sqrt_rho/(T_epsilon*sqrt_T_epsilon);
-		B = 50.29158649 * sqrt_rho/sqrt_T_epsilon;
-		sigmacoeff = (2.0/3.0)*A*I*sqrtI;
-
-        // Set the first contribution to the activity of water
-        ln_a[iwater] = mSigma;
-
-        // Loop over all charged species in the mixture
+        xw = x[iwater];
+        ln_xw = log(xw);
+        mSigma = nwo * (1 - xw)/xw;
+        sqrt_rho = sqrt(rho);
+        T_epsilon = T * epsilon;
+        sqrt_T_epsilon = sqrt(T_epsilon);
+        A = 1.824829238e+6 * sqrt_rho/(T_epsilon*sqrt_T_epsilon);
+        B = 50.29158649 * sqrt_rho/sqrt_T_epsilon;
+
+        // The ionic strength and its square root
+        const double Ival = I.val;
+        const double sqrtI = std::sqrt(Ival);
+
+        // The values of the Debye-Huckel parameters A and B
+        const double Aval = A.val;
+        const double Bval = B.val;
+
+        // Gather the molalities of the charged species
+        for(Index i = 0; i < num_charged_species; ++i)
+            mi[i] = m.val[icharged_species[i]];
+
+        // Compute the Lambda and sigma parameters of all charged species. The
+        // derivatives of the ln activity coefficients of the ions and of their
+        // contributions to the activity of water are computed with respect to
+        // A, B, and I only, since these are the only quantities they depend on.
+        // The derivatives with respect to T, P, and n follow from the chain rule.
+        u = (Bval*sqrtI) * aions;
+        Lambda = 1.0 + u.array();
+        sigma = (u.array() != 0.0).select(3.0*(u.array()*(u.array() - 2.0) + 2.0*Lambda.array().log())/u.array().cube(), 2.0);
+        sigma_u = (u.array() != 0.0).select((6.0/Lambda.array() - 3.0*sigma.array())/u.array(), 0.0);
+
+        // Compute the ln activity coefficients of the charged species and their partial derivatives
+        lng   = ln10 * (-Aval*sqrtI*z2.array()/Lambda.array() + Ival*bions.array());
+        lng_A = -ln10 * sqrtI * z2.array()/Lambda.array();
+        lng_B = ln10 * Aval*Ival * z2.array()*aions.array()/Lambda.array().square();
+        lng_I = ln10 * (-0.5*Aval/sqrtI * z2.array()/Lambda.array().square() + bions.array());
+
+        // Compute the contributions of the charged species to the ln activity of water and their partial derivatives
+        hw   = ln10 * ((2.0/3.0)*Aval*Ival*sqrtI*sigma.array() - Ival*Ival*bions.array()/z2.array());
+        hw_A = ln10 * (2.0/3.0)*Ival*sqrtI * sigma.array();
+        hw_B = ln10 * (2.0/3.0)*Aval*Ival*Ival * sigma_u.array()*aions.array();
+        hw_I = ln10 * (Aval*sqrtI*sigma.array() + (1.0/3.0)*Aval*Ival*Bval*sigma_u.array()*aions.array() - 2.0*Ival*bions.array()/z2.array());
+
+        // Scatter the contributions of the charged species over all species
         for(Index i = 0; i < num_charged_species; ++i)
         {
-            // The index of the current charged species
             const Index ispecies = icharged_species[i];
-
-            // The molality of the charged species and its molar derivatives
-            const auto mi = m[ispecies];
-
-            // The electrical charge of the charged species
-            const auto z = charges[i];
-
-            // Update the Lambda parameter of the Debye-Huckel activity coefficient model
-            Lambda = 1.0 + aions[i]*B*sqrtI;
-
-			// Update the sigma parameter of the current ion
-            if(aions[i] != 0.0) sigma = 3.0*pow(Lambda - 1, -3) * ((Lambda - 1)*(Lambda - 3) + 2*log(Lambda));
-            else                sigma = 2.0;
-
-            // Calculate the ln activity coefficient of the current charged species
-            ln_g[ispecies] = ln10 * (-A*z*z*sqrtI/Lambda + bions[i]*I);
-
-            // Calculate the ln activity of the current charged species
-            ln_a[ispecies] = ln_g[ispecies] + ln_m[ispecies];
-
-            // Calculate the contribution of current ion to the ln activity of water
-			ln_a[iwater] += mi*ln_g[ispecies] + sigmacoeff*sigma*ln10 - I2*bions[i]/(z*z)*ln10;
+            ln_g_ions[ispecies] = lng[i];
+            ln_g_A[ispecies] = lng_A[i];
+            ln_g_B[ispecies] = lng_B[i];
+            ln_g_I[ispecies] = lng_I[i];
         }
 
-        // Finalize the computation of the activity of water (in mole fraction scale)
-        ln_a[iwater] *= -1.0/nwo;
+        // Set the ln activity coefficients of the solutes, whose mole
+        // derivatives are all proportional to the mole derivatives of I
+        ln_g.val = ln_g_ions;
+        for(Index i : ineutral_species)
+            ln_g.val[i] = ln_g_I[i] * Ival;
+        ln_g.ddT = ln_g_A*A.ddT + ln_g_B*B.ddT + ln_g_I*I.ddT;
+        ln_g.ddP = ln_g_A*A.ddP + ln_g_B*B.ddP + ln_g_I*I.ddP;
+        ln_g.ddn.noalias() = ln_g_I * tr(I.ddn);
+
+        // Set the ln activities of the solutes (molality scale)
+        inv_m = m.val.cwiseInverse();
+        ln_a.val = ln_g.val + log(m.val);
+        ln_a.ddT = ln_g.ddT + diag(inv_m) * m.ddT;
+        ln_a.ddP = ln_g.ddP + diag(inv_m) * m.ddP;
+        for(Index j = 0; j < num_species; ++j)
+            ln_a.ddn.col(j) = ln_g.ddn.col(j) + inv_m.cwiseProduct(m.ddn.col(j));
+
+        // The partial derivatives of the sum of the contributions of the ions to the activity of water
+        const double W_A = mi.dot(lng_A) + hw_A.sum();
+        const double W_B = mi.dot(lng_B) + hw_B.sum();
+        const double W_I = mi.dot(lng_I) + hw_I.sum();
+
+        // Calculate the contributions of all ions to the activity of water
+        W = mSigma;
+        W.val += mi.dot(lng) + hw.sum();
+        W.ddT += W_A*A.ddT + W_B*B.ddT + W_I*I.ddT + ln_g_ions.dot(m.ddT);
+        W.ddP += W_A*A.ddP + W_B*B.ddP + W_I*I.ddP + ln_g_ions.dot(m.ddP);
+        W.ddn += W_I * I.ddn;
+        W.ddn.noalias() += tr(m.ddn) * ln_g_ions;
+
+        // Set the activity of water (in mole fraction scale)
+        ln_a[iwater] = -W/nwo;
 
         // Set the activity coefficient of water (mole fraction scale)
         ln_g[iwater] = ln_a[iwater] - ln_xw;
 
-        // Loop over all neutral species in the mixture
-        for(Index i = 0; i < num_neutral_species; ++i)
-        {
-            // The index of the current neutral species
-            const Index ispecies = ineutral_species[i];
-
-            // Calculate the ln activity coefficient of the current neutral species
-            ln_g[ispecies] = ln10 * bneutral[i] * I;
-
-            // Calculate the ln activity coefficient of the current neutral species
-            ln_a[ispecies] = ln_g[ispecies] + ln_m[ispecies];
-        }
-
         // Set the ln activity constants of aqueous species to ln(55.508472)
         ln_c = std::log(nwo);
 
@@ -300,12 +300,6 @@ auto aqueousChemicalModelHKF(const AqueousMixture& mixture) -> PhaseChemicalMode
     // The index of the water species
     const Index iwater = mixture.indexWater();
 
-    // The effective electrostatic radii of the charged species
-    std::vector<double> effective_radii;
-
-    // The electrical charges of the charged species only
-    std::vector<double> charges;
-
     // The Born coefficient of the ion H+
     const double omegaH = 0.5387e+05;
 
@@ -315,118 +309,201 @@ auto aqueousChemicalModelHKF(const AqueousMixture& mixture) -> PhaseChemicalMode
     // The molar mass of water
     const double Mw = waterMolarMass;
 
-    // Collect the effective radii of the ions
-    for(Index idx_ion : icharged_species)
+    // The squared electrical charges of the charged species
+    Vector z2(num_charged_species);
+
+    // The Debye-Huckel ion size parameters of the charged species
+    Vector aions(num_charged_species);
+
+    // The absolute and conventional Born coefficients of the charged species
+    Vector omega_abs(num_charged_species), omega(num_charged_species);
+
+    // The charge corrections -0.19*(|z| - 1) of the short-range interaction parameters of the charged species
+    Vector zcorr(num_charged_species);
+
+    // Collect the parameters of the ions
+    for(unsigned i = 0; i < num_charged_species; ++i)
     {
-        const AqueousSpecies& species = mixture.species(idx_ion);
-        effective_radii.push_back(effectiveIonicRadius(species));
-        charges.push_back(species.charge());
+        const AqueousSpecies& species = mixture.species(icharged_species[i]);
+
+        // The electrical charge of the charged species
+        const double z = species.charge();
+
+        // The effective radius of the charged species
+        const double eff_radius = effectiveIonicRadius(species);
+
+        z2[i] = z*z;
+        omega_abs[i] = eta*z2[i]/eff_radius;
+        omega[i] = omega_abs[i] - z*omegaH;
+        zcorr[i] = -0.19*(std::abs(z) - 1.0);
+
+        // The Debye-Huckel ion size parameter of the current ion as computed by Reed (1982) and also in TOUGHREACT
+        aions[i] = (z < 0) ?
+            2.0*(eff_radius + 1.91*std::abs(z))/(std::abs(z) + 1.0) :
+            2.0*(eff_radius + 1.81*std::abs(z))/(std::abs(z) + 1.0);
     }
 
-    // Define the intermediate chemical model function of the aqueous mixture
-    auto model = [=](const AqueousMixtureState& state)
+    // The parameters of the HKF model that depend only on temperature and pressure
+    struct Block
     {
-        // Auxiliary references to state variables
-        const auto& T = state.T;
-        const auto& P = state.P;
-        const auto& I = state.Ie;
-        const auto& x = state.x;
-        const auto& m = state.m;
+        // The Debye-Huckel parameters A and B
+        double A = 0.0, B = 0.0;
 
-        // The square root of the ionic strength
-        const auto sqrtI = sqrt(I);
+        // The coefficients of the ionic strength in the activity coefficients and in the osmotic coefficient of the charged species
+        Vector cions, dions;
+    };
 
-        // The molar fraction of the water species and its molar derivatives
-        const auto xw = x[iwater];
+    // Define the temperature-pressure stage of the chemical model
+    auto prepare = [=](double T, double P) -> Block
+    {
+        const double bNaCl = solventParamNaCl(T, P);
+        const double bNapClm = shortRangeInteractionParamNaCl(T, P);
+
+        Block block;
+        block.A = debyeHuckelParamA(T, P);
+        block.B = debyeHuckelParamB(T, P);
+        block.cions = (omega_abs * bNaCl).array() + bNapClm + zcorr.array();
+        block.dions = -0.5*((omega * bNaCl).array() + bNapClm + zcorr.array());
+        return block;
+    };
 
-        // The ln and log10 of water molar fraction
-        const auto ln_xw = log(xw);
-        const auto log10_xw = log10(xw);
+    // The result of the equation of state
+    PhaseChemicalModelResult res(num_species);
 
-        // The alpha parameter
-        const ChemicalScalar alpha = xw/(1.0 - xw) * log10_xw;
+    // Auxiliary variables
+    ChemicalScalar xw, ln_xw, alpha, phi;
 
-        // The parameters for the HKF model
-        const double A = debyeHuckelParamA(T.val, P.val);
-        const double B = debyeHuckelParamB(T.val, P.val);
-        const double bNaCl = solventParamNaCl(T.val, P.val);
-        const double bNapClm = shortRangeInteractionParamNaCl(T.val, P.val);
+    // The molalities of the charged species
+    Vector mi(num_charged_species);
 
-        // The osmotic coefficient of the aqueous phase
-        ChemicalScalar phi(num_species);
+    // The parameters u = a*B*sqrt(I) and Lambda = 1 + u of the charged species
+    Vector u(num_charged_species), Lambda(num_charged_species);
 
-        // The result of the equation of state
-        PhaseChemicalModelResult res(num_species);
+    // The sigma parameters of the charged species and their derivatives with respect to u
+    Vector sigma(num_charged_species), sigma_u(num_charged_species);
 
-        // Set the activity coefficients of the neutral species to
-        // water molar fraction to convert it to molality scale
-        res.ln_activity_coefficients = 0.0;
-//        res.ln_activity_coefficients = ln_xw;
+    // The log10 activity coefficients of the charged species (excluding the term log10(xw)) and their derivatives with respect to I
+    Vector log10g(num_charged_species), log10g_I(num_charged_species);
 
-        // Loop over all charged species in the mixture
-        for(unsigned i = 0; i < num_charged_species; ++i)
-        {
-            // The index of the charged species in the mixture
-            const Index ispecies = icharged_species[i];
+    // The psi contributions of the charged species (excluding the term alpha) and their derivatives with respect to I
+    Vector psi(num_charged_species), psi_I(num_charged_species);
 
-            // The molality of the charged species and its molar derivatives
-            const auto mi = m[ispecies];
+    // The contributions of the charged species scattered over all species (zero for the other species)
+    Vector ln_g_ions = zeros(num_species), ln_g_I = zeros(num_species), ln_g_xw = zeros(num_species), psi_ions = zeros(num_species);
 
-            // Check if the molality of the charged species is zero
-            if(mi.val == 0.0)
-                continue;
+    // The reciprocal of the molalities of all species
+    Vector inv_m(num_species);
 
-            // The electrical charge of the charged species
-            const double z = charges[i];
-            const double z2 = z*z;
+    // Define the intermediate chemical model function of the aqueous mixture
+    auto model = [=](const Block& block, const AqueousMixtureState& state) mutable
+    {
+        // Auxiliary references to state variables
+        const auto& I = state.Ie;
+        const auto& x = state.x;
+        const auto& m = state.m;
 
-            // The effective radius of the charged species
-            const double eff_radius = effective_radii[i];
+        // Auxiliary references
+        auto& ln_g = res.ln_activity_coefficients;
+        auto& ln_a = res.ln_activities;
 
-            // The Born coefficient of the current charged species
-            const double omega = eta*z2/eff_radius - z*omegaH;
+        // The molar fraction of the water species and its molar derivatives
+        xw = x[iwater];
 
-            // The absolute Born coefficient of the current charged species
-            const double omega_abs = eta*z2/eff_radius;
+        // The ln of water molar fraction
+        ln_xw = log(xw);
 
-            // The Debye-Huckel ion size parameter of the current ion as computed by Reed (1982) and also in TOUGHREACT
-            const double a = (z < 0) ?
-                2.0*(eff_radius + 1.91*std::abs(z))/(std::abs(z) + 1.0) :
-                2.0*(eff_radius + 1.81*std::abs(z))/(std::abs(z) + 1.0);
+        // The alpha parameter
+        alpha = xw/(1.0 - xw) * ln_xw/ln10;
 
-            // The \Lamba parameter of the HKF activity coefficient model and its molar derivatives
-            const ChemicalScalar lambda = 1.0 + a*B*sqrtI;
+        // Auxiliary references to the parameters of the HKF model at the current temperature and pressure
+        const double A = block.A;
+        const double B = block.B;
+        const Vector& cions = block.cions;
+        const Vector& dions = block.dions;
 
-            // The log10 of the activity coefficient of the charged species (in molar fraction scale) and its molar derivatives
-            // This is the equation (298) in Helgeson et a. (1981) paper, page 230.
-            const ChemicalScalar log10_gi = -(A*z2*sqrtI)/lambda + log10_xw + (omega_abs * bNaCl + bNapClm - 0.19*(std::abs(z) - 1.0)) * I;
+        // The ionic strength and its square root
+        const double Ival = I.val;
+        const double sqrtI = std::sqrt(Ival);
 
-            // Set the activity coefficient of the current charged species
-            res.ln_activity_coefficients[ispecies] = log10_gi * ln10;
+        // Gather the molalities of the charged species
+        for(unsigned i = 0; i < num_charged_species; ++i)
+            mi[i] = m.val[icharged_species[i]];
+
+        // Compute the Lambda and sigma parameters of all charged species. The
+        // activity coefficients of the ions depend on the species amounts only
+        // through I and xw, so their derivatives are computed with respect to
+        // I and then combined with the derivatives of I using the chain rule.
+        u = (B*sqrtI) * aions;
+        Lambda = 1.0 + u.array();
+        sigma = (u.array() != 0.0).select(3.0/u.array().cube() * (Lambda.array() - 1.0/Lambda.array() - 2.0*Lambda.array().log()), 1.0);
+        sigma_u = (u.array() != 0.0).select((3.0/Lambda.array().square() - 3.0*sigma.array())/u.array(), 0.0);
+
+        // The log10 of the activity coefficient of the charged species (in molar fraction scale) and its derivative with respect to I.
+        // This is the equation (298) in Helgeson et a. (1981) paper, page 230.
+        log10g = -A*sqrtI*z2.array()/Lambda.array() + Ival*cions.array();
+        log10g_I = -0.5*A/sqrtI*z2.array()/Lambda.array().square() + cions.array();
+
+        // The psi contributions of the charged species and their derivatives with respect to I
+        psi = (A*sqrtI/3.0)*z2.array()*sigma.array() + Ival*dions.array();
+        psi_I = (A/6.0)*z2.array()*(sigma.array()/sqrtI + B*aions.array()*sigma_u.array()) + dions.array();
+
+        // The sums of the molalities and of the derivatives of the psi contributions weighted by the molalities of the charged species
+        double sum_m = 0.0, sum_m_psi_I = 0.0;
+
+        // Scatter the contributions of the charged species over all species, skipping
+        // those with zero molality. These are not multiplied by a zero mask, since the
+        // derivatives with respect to I are infinite when the ionic strength is zero.
+        for(unsigned i = 0; i < num_charged_species; ++i)
+        {
+            const Index ispecies = icharged_species[i];
 
-            // Check if the molar fraction of water is one
-            if(xw != 1.0)
+            if(mi[i] == 0.0)
             {
-                // The sigma parameter of the current ion and its molar derivatives
-                const auto sigma = 3.0/pow(a*B*sqrtI, 3) * (lambda - 1.0/lambda - 2.0*log(lambda));
+                ln_g_ions[ispecies] = ln_g_I[ispecies] = ln_g_xw[ispecies] = psi_ions[ispecies] = 0.0;
+                continue;
+            }
 
-                // The psi contribution of the current ion and its molar derivatives
-                const auto psi = A*z2*sqrtI*sigma/3.0 + alpha - 0.5*(omega*bNaCl + bNapClm - 0.19*(std::abs(z) - 1.0)) * I;
+            ln_g_ions[ispecies] = ln10 * log10g[i];
+            ln_g_I[ispecies] = ln10 * log10g_I[i];
+            ln_g_xw[ispecies] = 1.0;
+            psi_ions[ispecies] = psi[i] + alpha.val;
 
-                // Update the osmotic coefficient with the contribution of the current charged species
-                phi += mi * psi;
-            }
+            sum_m += mi[i];
+            sum_m_psi_I += mi[i] * psi_I[i];
         }
 
+        // Set the activity coefficients of the charged species, whose mole
+        // derivatives are linear combinations of those of I and ln(xw)
+        ln_g.val = ln_g_ions + ln_xw.val * ln_g_xw;
+        ln_g.ddT = ln_g_I*I.ddT + ln_xw.ddT * ln_g_xw;
+        ln_g.ddP = ln_g_I*I.ddP + ln_xw.ddP * ln_g_xw;
+        ln_g.ddn.noalias() = ln_g_I * tr(I.ddn);
+        ln_g.ddn.noalias() += ln_g_xw * tr(ln_xw.ddn);
+
         // Set the activities of the solutes (molality scale)
-        res.ln_activities = res.ln_activity_coefficients + log(m);
+        inv_m = m.val.cwiseInverse();
+        ln_a.val = ln_g.val + log(m.val);
+        ln_a.ddT = ln_g.ddT + diag(inv_m) * m.ddT;
+        ln_a.ddP = ln_g.ddP + diag(inv_m) * m.ddP;
+        for(Index j = 0; j < num_species; ++j)
+            ln_a.ddn.col(j) = ln_g.ddn.col(j) + inv_m.cwiseProduct(m.ddn.col(j));
 
         // Set the activity of water (in molar fraction scale)
-        if(xw != 1.0) res.ln_activities[iwater] = ln10 * Mw * phi;
-                 else res.ln_activities[iwater] = ln_xw;
+        if(xw != 1.0)
+        {
+            // Calculate the osmotic coefficient of the aqueous phase
+            phi.val = psi_ions.dot(m.val);
+            phi.ddT = psi_ions.dot(m.ddT) + sum_m_psi_I*I.ddT + sum_m*alpha.ddT;
+            phi.ddP = psi_ions.dot(m.ddP) + sum_m_psi_I*I.ddP + sum_m*alpha.ddP;
+            phi.ddn.noalias() = tr(m.ddn) * psi_ions;
+            phi.ddn += sum_m_psi_I*I.ddn + sum_m*alpha.ddn;
+
+            ln_a[iwater] = ln10 * Mw * phi;
+        }
+        else ln_a[iwater] = ln_xw;
 
         // Set the activity coefficient of water (molar fraction scale)
-        res.ln_activity_coefficients[iwater] = res.ln_activities[iwater] - ln_xw;
+        ln_g[iwater] = ln_a[iwater] - ln_xw;
 
         // Set the activity constants of aqueous species to ln(55.508472)
         res.ln_activity_constants = std::log(55.508472);
@@ -437,15 +514,18 @@ auto aqueousChemicalModelHKF(const AqueousMixture& mixture) -> PhaseChemicalMode
         return res;
     };
 
-    // Define the chemical model function of the aqueous mixture
-    PhaseChemicalModel f = [=](double T, double P, const Vector& n)
+    // Define the composition stage of the chemical model
+    auto evaluate = [=](const Block& block, double T, double P, const Vector& n) mutable
     {
         // Calculate the state of the mixture
         const AqueousMixtureState state = mixture.state(T, P, n);
 
-        return model(state);
+        return model(block, state);
     };
 
+    // Define the chemical model function of the aqueous mixture
+    PhaseChemicalModel f = makePhaseChemicalModel(prepare, evaluate);
+
     return f;
 }
 
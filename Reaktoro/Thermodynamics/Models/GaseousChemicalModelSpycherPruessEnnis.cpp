@@ -96,20 +96,24 @@ auto gaseousChemicalModelSpycherPruessEnnis(const GaseousMixture& mixture) -> Ph
     // The number of species in the mixture
     const unsigned nspecies = mixture.numSpecies();
 
-    // The ln of H2O(g) and CO2(g) molar fractions
-    ChemicalScalar ln_xH2O(nspecies);
-    ChemicalScalar ln_xCO2(nspecies);
+    // The quantities of the model that depend only on temperature and pressure
+    struct Block
+    {
+        ThermoScalar ln_Pb;
+        ThermoScalar v;
+        ThermoScalar ln_phiH2O;
+        ThermoScalar ln_phiCO2;
+    };
 
-    // Define the intermediate chemical model function
-    auto model = [=](const GaseousMixtureState state) mutable
+    // Define the temperature-pressure stage of the chemical model
+    auto prepare = [=](double Tval, double Pval) -> Block
     {
-        // Auxiliary references to state variables
-        const auto& T = state.T;
-        const auto& P = state.P;
+        // The temperature and pressure as thermodynamic scalars
+        const Temperature T(Tval);
+        const Pressure P(Pval);
 
         // Calculate the pressure in bar
         const auto Pb = convertPascalToBar(P);
-        const auto ln_Pb = log(Pb);
 
         // Auxiliary variables
         const auto T05 = sqrt(T);
@@ -119,8 +123,10 @@ auto gaseousChemicalModelSpycherPruessEnnis(const GaseousMixture& mixture) -> Ph
         const auto amix = aCO2(T);
         const auto bmix = bCO2;
 
+        Block block;
+
         // Calculate the molar volume of the CO2-rich phase (in units of cm3/mol)
-        const ThermoScalar v = volumeCO2(T, Pb, T05);
+        const ThermoScalar v = block.v = volumeCO2(T, Pb, T05);
 
         // Auxiliary values for the fugacity coefficients
         const auto aux1 = log(v/(v - bmix));
@@ -129,50 +135,52 @@ auto gaseousChemicalModelSpycherPruessEnnis(const GaseousMixture& mixture) -> Ph
         const auto aux4 = log(Pb*v/(R*T));
 
         // Calculate the fugacity coefficients of H2O(g) and CO2(g) (in natural log scale)
-        const auto ln_phiH2O = aux1 + bH2O/(v - bmix) - aH2OCO2*aux2 +
+        block.ln_phiH2O = aux1 + bH2O/(v - bmix) - aH2OCO2*aux2 +
             bH2O*aux3*(log((v + bH2O)/v) - bmix/(v + bmix)) - aux4;
 
-        const auto ln_phiCO2 = aux1 + bCO2/(v - bmix) - amix*aux2 +
+        block.ln_phiCO2 = aux1 + bCO2/(v - bmix) - amix*aux2 +
             bCO2*aux3*(log((v + bCO2)/v) - bmix/(v + bmix)) - aux4;
 
+        // Calculate the ln of pressure in bar
+        block.ln_Pb = log(Pb);
+
+        return block;
+    };
+
+    // Define the composition stage of the chemical model
+    auto evaluate = [=](const Block& block, double T, double P, const Vector& n)
+    {
+        // Calculate state of the mixture
+        const GaseousMixtureState state = mixture.state(T, P, n);
+
         // The ln molar fractions of all gaseous species
         const ChemicalVector ln_x = log(state.x);
 
-        // The molar fractions of the gaseous species H2O(g) and CO2(g) and their molar derivatives
-        if(iH2O < nspecies) ln_xH2O = ln_x[iH2O];
-        if(iCO2 < nspecies) ln_xCO2 = ln_x[iCO2];
-
         // Calculate the chemical properties of the phase
         PhaseChemicalModelResult res(nspecies);
 
         // Set the molar volume of the phase (in units of m3/mol)
-        res.molar_volume = convertCubicCentimeterToCubicMeter(v);
+        res.molar_volume = convertCubicCentimeterToCubicMeter(block.v);
 
         // Set the ln activities of the gaseous species to ideal values
-        res.ln_activities = ln_x + ln_Pb;
+        res.ln_activities = ln_x + block.ln_Pb;
 
         // Set the ln activity coefficients of H2O(g) and CO2(g)
-        res.ln_activity_coefficients[iH2O] = ln_phiH2O;
-        res.ln_activity_coefficients[iCO2] = ln_phiCO2;
+        res.ln_activity_coefficients[iH2O] = block.ln_phiH2O;
+        res.ln_activity_coefficients[iCO2] = block.ln_phiCO2;
 
         // Correct the ln activities of H2O(g) and CO2(g)
-        res.ln_activities[iH2O] += ln_phiH2O;
-        res.ln_activities[iCO2] += ln_phiCO2;
+        res.ln_activities[iH2O] += block.ln_phiH2O;
+        res.ln_activities[iCO2] += block.ln_phiCO2;
 
         // Set the ln activity constants of gases
-        res.ln_activity_constants = ln_Pb;
+        res.ln_activity_constants = block.ln_Pb;
 
         return res;
     };
 
     // Define the chemical model function of the gaseous phase
-    PhaseChemicalModel f = [=](double T, double P, const Vector& n) mutable
-    {
-        // Calculate state of the mixture
-        const GaseousMixtureState state = mixture.state(T, P, n);
-
-        return model(state);
-    };
+    PhaseChemicalModel f = makePhaseChemicalModel(prepare, evaluate);
 
     return f;
 }
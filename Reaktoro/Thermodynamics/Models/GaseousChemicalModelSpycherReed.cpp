@@ -234,9 +234,50 @@ auto gaseousChemicalModelSpycherReed(const GaseousMixture& mixture) -> PhaseChem
     // The universal gas constant of the phase (in units of J/(mol*K))
     const double R = universalGasConstant;
 
+    // The coefficients of the virial equation of state, which depend only on temperature
+    struct Block
+    {
+        ThermoScalar B[3][3], BT[3][3], BTT[3][3];
+        ThermoScalar C[3][3][3], CT[3][3][3], CTT[3][3][3];
+    };
+
+    // Define the temperature-pressure stage of the chemical model
+    auto prepare = [=](double Tval, double Pval) -> Block
+    {
+        const Temperature T(Tval);
+
+        Block block;
+
+        // Calculate the Bij, BijT, BijTT coefficients
+        for(int i = 0; i < 3; ++i) for(int k = 0; k < 3; ++k)
+        {
+            block.B[i][k] = computeB(T, i, k);
+            block.BT[i][k] = computeBT(T, i, k);
+            block.BTT[i][k] = computeBTT(T, i, k);
+        }
+
+        // Calculate the Cijk, CijkT, CijkTT coefficients
+        for(int i = 0; i < 3; ++i) for(int k = 0; k < 3; ++k) for(int l = 0; l < 3; ++l)
+        {
+            block.C[i][k][l] = computeC(T, i, k, l);
+            block.CT[i][k][l] = computeCT(T, i, k, l);
+            block.CTT[i][k][l] = computeCTT(T, i, k, l);
+        }
+
+        return block;
+    };
+
     // Define the intermediate chemical model function of the gaseous phase
-    auto model = [=](const GaseousMixtureState state)
+    auto model = [=](const Block& block, const GaseousMixtureState state)
     {
+        // Auxiliary references to the temperature dependent coefficients
+        const auto& B = block.B;
+        const auto& BT = block.BT;
+        const auto& BTT = block.BTT;
+        const auto& C = block.C;
+        const auto& CT = block.CT;
+        const auto& CTT = block.CTT;
+
         // Auxiliary references to state variables
         const auto& T = state.T;
         const auto& P = state.P;
@@ -257,24 +298,6 @@ auto gaseousChemicalModelSpycherReed(const GaseousMixture& mixture) -> PhaseChem
         if(iCO2 < nspecies) y[1] = x[iCO2]; else y[1] = zero;
         if(iCH4 < nspecies) y[2] = x[iCH4]; else y[2] = zero;
 
-        // Calculate the Bij, BijT, BijTT coefficients
-        ThermoScalar B[3][3], BT[3][3], BTT[3][3];
-        for(int i = 0; i < 3; ++i) for(int k = 0; k < 3; ++k)
-        {
-            B[i][k] = computeB(T, i, k);
-            BT[i][k] = computeBT(T, i, k);
-            BTT[i][k] = computeBTT(T, i, k);
-        }
-
-        // Calculate the Cijk, CijkT, CijkTT coefficients
-        ThermoScalar C[3][3][3], CT[3][3][3], CTT[3][3][3];
-        for(int i = 0; i < 3; ++i) for(int k = 0; k < 3; ++k) for(int l = 0; l < 3; ++l)
-        {
-            C[i][k][l] = computeC(T, i, k, l);
-            CT[i][k][l] = computeCT(T, i, k, l);
-            CTT[i][k][l] = computeCTT(T, i, k, l);
-        }
-
         // Calculate the coefficient Bmix, BmixT, and BmixTT
         ChemicalScalar Bmix(nspecies), BmixT(nspecies), BmixTT(nspecies);
         for(int i = 0; i < 3; ++i) for(int k = 0; k < 3; ++k)
@@ -354,15 +377,18 @@ auto gaseousChemicalModelSpycherReed(const GaseousMixture& mixture) -> PhaseChem
         return res;
     };
 
-    // Define the chemical model function of the gaseous phase
-    PhaseChemicalModel f = [=](double T, double P, const Vector& n)
+    // Define the composition stage of the chemical model
+    auto evaluate = [=](const Block& block, double T, double P, const Vector& n)
     {
         // Calculate state of the mixture
         const GaseousMixtureState state = mixture.state(T, P, n);
 
-        return model(state);
+        return model(block, state);
     };
 
+    // Define the chemical model function of the gaseous phase
+    PhaseChemicalModel f = makePhaseChemicalModel(prepare, evaluate);
+
     return f;
 }
 
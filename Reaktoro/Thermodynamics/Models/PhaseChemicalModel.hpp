@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <functional>
+#include <type_traits>
 
 // Reaktoro includes
 #include <Reaktoro/Common/ChemicalScalar.hpp>
@@ -69,4 +70,37 @@ struct PhaseChemicalModelResult
 /// The signature of the chemical model function that calculates the chemical properties of a phase.
 using PhaseChemicalModel = std::function<PhaseChemicalModelResult(double, double, const Vector&)>;
 
+/// Return a two-stage chemical model function of a phase.
+/// The chemical model is split into a temperature-pressure stage, `prepare(T, P)`,
+/// that returns a model-specific block of quantities depending only on temperature
+/// and pressure, and a composition stage, `evaluate(block, T, P, n)`, that uses
+/// this block to calculate the chemical properties of the phase. The block is
+/// cached for the last temperature and pressure, so that successive evaluations
+/// at fixed temperature and pressure (e.g., in the Newton iterations of
+/// equilibrium and kinetic calculations) only execute the composition stage.
+/// @param prepare The function `(double T, double P) -> Block`
+/// @param evaluate The function `(const Block&, double T, double P, const Vector& n) -> PhaseChemicalModelResult`
+template<typename Prepare, typename Evaluate>
+auto makePhaseChemicalModel(Prepare prepare, Evaluate evaluate) -> PhaseChemicalModel
+{
+    using Block = typename std::decay<decltype(prepare(0.0, 0.0))>::type;
+
+    bool prepared = false;
+    double Tlast = 0.0;
+    double Plast = 0.0;
+    Block block;
+
+    return [=](double T, double P, const Vector& n) mutable -> PhaseChemicalModelResult
+    {
+        if(!prepared || T != Tlast || P != Plast)
+        {
+            block = prepare(T, P);
+            Tlast = T;
+            Plast = P;
+            prepared = true;
+        }
+        return evaluate(block, T, P, n);
+    };
+}
+
 } // namespace Reaktoro
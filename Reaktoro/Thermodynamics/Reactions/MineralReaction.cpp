@@ -26,6 +26,7 @@
 // Reaktoro includes
 #include <Reaktoro/Common/ConvertUtils.hpp>
 #include <Reaktoro/Common/ChemicalScalar.hpp>
+#include <Reaktoro/Common/Constants.hpp>
 #include <Reaktoro/Common/Exception.hpp>
 #include <Reaktoro/Common/ReactionEquation.hpp>
 #include <Reaktoro/Common/SetUtils.hpp>
@@ -39,145 +40,299 @@
 #include <Reaktoro/Core/ThermoProperties.hpp>
 #include <Reaktoro/Core/Utils.hpp>
 #include <Reaktoro/Math/MathUtils.hpp>
+#include <Reaktoro/Thermodynamics/Models/PhaseChemicalModel.hpp>
+#include <Reaktoro/Thermodynamics/Models/PhaseThermoModel.hpp>
 
 namespace Reaktoro {
 namespace internal {
 
-using MineralCatalystFunction = std::function<ChemicalScalar(const ChemicalProperties&)>;
-using MineralMechanismFunction = std::function<ChemicalScalar(const ChemicalProperties&)>;
-
-auto mineralCatalystFunctionActivity(const MineralCatalyst& catalyst, const ChemicalSystem& system) -> MineralCatalystFunction
+/// The location of a species in the chemical properties of its phase.
+struct MineralSpeciesLocation
 {
-    const double power = catalyst.power;
-    const std::string species = catalyst.species;
-    const Index ispecies = system.indexSpeciesWithError(species);
+    /// The index of the phase containing the species
+    Index iphase;
 
-    MineralCatalystFunction fn = [=](const ChemicalProperties& properties) mutable
-    {
-        const ChemicalVector& ln_a = properties.lnActivities();
-        ChemicalScalar ai = exp(ln_a[ispecies]);
-        ChemicalScalar res = pow(ai, power);
-        return res;
-    };
+    /// The index of the species in its phase
+    Index ilocal;
 
-    return fn;
-}
+    /// The index of the first species of the phase in the system
+    Index offset;
 
-auto mineralCatalystFunctionPartialPressure(const MineralCatalyst& catalyst, const ChemicalSystem& system) -> MineralCatalystFunction
+    /// The number of species in the phase
+    Index size;
+};
+
+/// A compiled representation of the rate function of a mineral reaction.
+/// The stoichiometry of the reaction, the Arrhenius constants of its mechanisms, and the exponents
+/// of their catalysts are flattened into arrays once, so that a rate evaluation computes the
+/// saturation index of the mineral a single time and shares it among all mechanisms. The activities
+/// and standard Gibbs energies are read directly from the results of the phase models, avoiding the
+/// assembly of the dense activity vectors of the whole system.
+struct MineralRateKernel
 {
-    const auto gas         = catalyst.species;                         // the species of the catalyst
-    const auto power       = catalyst.power;                           // the power of the catalyst
-    const auto idx_phase   = system.indexPhase("Gaseous");             // the index of the gaseous phase
-    const auto gases       = names(system.phase(idx_phase).species()); // the names of the gaseous species
-    const auto igases      = system.indicesSpecies(gases);             // the indices of the gaseous species
-    const auto igas        = index(gas, gases);                        // the index of the gaseous species
-    const auto num_species = system.numSpecies();                      // the number of species
-    const auto num_gases   = gases.size();                             // the number of gases
-
-    Vector ng;
-    Vector dxidng;
-    Vector dxidn;
-    ChemicalScalar res;
-
-    MineralCatalystFunction fn = [=](const ChemicalProperties& properties) mutable
-    {
-        // The pressure and composition of the system
-        const double& P = properties.pressure();
-        const Vector& n = properties.composition();
+    /// The locations of the species whose ln activities contribute to the rate derivatives.
+    /// The first entries are the species in the reaction, followed by the activity catalysts.
+    std::vector<MineralSpeciesLocation> terms;
 
-        // The molar composition of the gaseous species
-        ng = rows(n, igases);
+    /// The stoichiometries of the species in the reaction
+    Vector stoichiometries;
 
-        // The total number of moles in the gaseous phase
-        const double ngsum = ng.sum();
+    /// The rate constants of the mechanisms at 25 C (in units of mol/(m2*s))
+    Vector kappa;
 
-        // The molar fraction of the gas
-        const double xi = ng[igas]/ngsum;
+    /// The activation energies of the mechanisms divided by the universal gas constant (in units of K)
+    Vector EaR;
 
-        // The derivative of the molar fraction of the gas with respect to the all gaseous species
-        dxidng.noalias() = (Vector::Unit(num_gases, igas) - Vector::Constant(num_gases, xi))/ngsum;
+    /// The empirical powers p and q of the saturation index of each mechanism
+    Vector p, q;
 
-        // The derivative of the molar fraction of the gas with respect to the all species
-        dxidn = zeros(num_species);
-        rows(dxidn, igases) = dxidng;
+    /// The index of the first activity catalyst of each mechanism in the catalyst arrays, plus a final sentinel
+    Indices activity_catalysts_offset;
 
-        // The pressure in units of bar
-        const double Pbar = convertPascalToBar(P);
+    /// The powers of the activity catalysts of all mechanisms
+    Vector activity_catalysts_power;
 
-        // Evaluate the mineral catalyst function
-        res.val = std::pow(xi * Pbar, power);
-        res.ddn = res.val * power/xi * dxidn;
+    /// The index of the first partial pressure catalyst of each mechanism in the catalyst arrays, plus a final sentinel
+    Indices pressure_catalysts_offset;
 
-        return res;
-    };
+    /// The indices of the gaseous species of the partial pressure catalysts of all mechanisms
+    Indices pressure_catalysts_species;
 
-    return fn;
-}
+    /// The powers of the partial pressure catalysts of all mechanisms
+    Vector pressure_catalysts_power;
+
+    /// The indices of the gaseous species in the system
+    Indices igases;
+
+    /// The equilibrium constant of the reaction, if provided
+    ThermoScalarFunction lnk;
 
-auto mineralCatalystFunction(const MineralCatalyst& catalyst, const ChemicalSystem& system) -> MineralCatalystFunction
+    /// The coefficients of the ln activities of the terms in the derivative of the rate
+    Vector coefficients;
+};
+
+auto mineralSpeciesLocation(Index ispecies, const ChemicalSystem& system) -> MineralSpeciesLocation
 {
-    if (catalyst.quantity == "a" || catalyst.quantity == "activity")
-        return mineralCatalystFunctionActivity(catalyst, system);
-    else
-        return mineralCatalystFunctionPartialPressure(catalyst, system);
+    MineralSpeciesLocation location;
+    location.iphase = system.indexPhaseWithSpecies(ispecies);
+    location.offset = system.indexFirstSpeciesInPhase(location.iphase);
+    location.ilocal = ispecies - location.offset;
+    location.size = system.numSpeciesInPhase(location.iphase);
+    return location;
 }
 
-auto mineralMechanismFunction(const MineralMechanism& mechanism, const Reaction& reaction, const ChemicalSystem& system) -> ReactionRateFunction
+auto mineralRateKernel(const MineralReaction& mineralrxn, const Reaction& reaction, const ChemicalSystem& system) -> MineralRateKernel
 {
-    // The number of chemical species in the system
-    const unsigned num_species = system.numSpecies();
-
     // The universal gas constant (in units of kJ/(mol*K))
     const double R = 8.3144621e-3;
 
-    // Create the mineral catalyst functions
-    std::vector<MineralCatalystFunction> catalysts;
-    for(const MineralCatalyst& catalyst : mechanism.catalysts)
-        catalysts.push_back(mineralCatalystFunction(catalyst, system));
+    // The mechanisms of the mineral reaction
+    const auto& mechanisms = mineralrxn.mechanisms();
+
+    // The number of mechanisms
+    const Index num_mechanisms = mechanisms.size();
+
+    MineralRateKernel kernel;
+
+    // Compile the sparse stoichiometry of the reaction
+    for(Index ispecies : reaction.indices())
+        kernel.terms.push_back(mineralSpeciesLocation(ispecies, system));
+    kernel.stoichiometries = reaction.stoichiometries();
+
+    // Compile the Arrhenius constants and the powers of the saturation index of the mechanisms
+    kernel.kappa.resize(num_mechanisms);
+    kernel.EaR.resize(num_mechanisms);
+    kernel.p.resize(num_mechanisms);
+    kernel.q.resize(num_mechanisms);
+
+    std::vector<double> activity_powers, pressure_powers;
+
+    for(Index i = 0; i < num_mechanisms; ++i)
+    {
+        const MineralMechanism& mechanism = mechanisms[i];
+
+        kernel.kappa[i] = mechanism.kappa;
+        kernel.EaR[i] = mechanism.Ea/R;
+        kernel.p[i] = mechanism.p;
+        kernel.q[i] = mechanism.q;
+
+        kernel.activity_catalysts_offset.push_back(activity_powers.size());
+        kernel.pressure_catalysts_offset.push_back(pressure_powers.size());
+
+        // Compile the catalyst exponent tables of the current mechanism
+        for(const MineralCatalyst& catalyst : mechanism.catalysts)
+        {
+            const Index ispecies = system.indexSpeciesWithError(catalyst.species);
+
+            if(catalyst.quantity == "a" || catalyst.quantity == "activity")
+            {
+                kernel.terms.push_back(mineralSpeciesLocation(ispecies, system));
+                activity_powers.push_back(catalyst.power);
+            }
+            else
+            {
+                kernel.pressure_catalysts_species.push_back(ispecies);
+                pressure_powers.push_back(catalyst.power);
+            }
+        }
+    }
 
-    // Auxiliary variables
-    ChemicalScalar aux, f, g;
+    kernel.activity_catalysts_offset.push_back(activity_powers.size());
+    kernel.pressure_catalysts_offset.push_back(pressure_powers.size());
 
-    // Define the mineral mechanism function
-    ReactionRateFunction fn = [=](const ChemicalProperties& properties) mutable
+    kernel.activity_catalysts_power = Vector::Map(activity_powers.data(), activity_powers.size());
+    kernel.pressure_catalysts_power = Vector::Map(pressure_powers.data(), pressure_powers.size());
+
+    // Determine the gaseous species only if there are partial pressure catalysts
+    if(pressure_powers.size())
     {
-        // The temperature and pressure of the system
-        const Temperature T = properties.temperature();
+        const Index igaseous = system.indexPhaseWithError("Gaseous");
+        kernel.igases = system.indicesSpecies(names(system.phase(igaseous).species()));
+    }
 
-        // The result of this function evaluation
-        ChemicalScalar res(num_species);
+    // Set the equilibrium constant of the reaction, if provided
+    kernel.lnk = mineralrxn.equilibriumConstant();
 
-        // Calculate the saturation index of the mineral
-        const auto lnK = reaction.lnEquilibriumConstant(properties);
-        const auto lnQ = reaction.lnReactionQuotient(properties);
-        const auto lnOmega = lnQ - lnK;
+    kernel.coefficients.resize(kernel.terms.size());
 
-        // Calculate the rate constant for the current mechanism
-        const auto kappa = mechanism.kappa * exp(-mechanism.Ea/R * (1.0/T - 1.0/298.15));
+    return kernel;
+}
 
-        // Calculate the saturation index
-        const auto Omega = exp(lnOmega);
+/// Evaluate the sum of the mechanism functions of a mineral reaction.
+/// The result is the specific rate of the mineral reaction (in units of mol/(m2*s)).
+auto mineralMechanismsFunction(MineralRateKernel& kernel, const ChemicalProperties& properties, ChemicalScalar& f) -> void
+{
+    // The temperature and pressure of the system
+    const double T = properties.temperature();
+    const double P = properties.pressure();
 
-        // Calculate the p and q powers of the saturation index Omega
-        const auto pOmega = pow(Omega, mechanism.p);
-        const auto qOmega = pow(1 - pOmega, mechanism.q);
+    // The composition of the system
+    const Vector& n = properties.composition();
 
-        // Calculate the function f
-        f = kappa * qOmega;
+    // The results of the thermodynamic and chemical models of the phases
+    const auto& tres = properties.phaseThermoModelResults();
+    const auto& cres = properties.phaseChemicalModelResults();
 
-        // Calculate the function g
-        g = ChemicalScalar(num_species, 1.0);
+    // The number of species in the reaction
+    const Index num_reactants = kernel.stoichiometries.size();
 
-        for(const MineralCatalystFunction& catalyst : catalysts)
-            g *= catalyst(properties);
+    // The number of mechanisms
+    const Index num_mechanisms = kernel.kappa.size();
 
-        // Calculate the resulting mechanism function
-        res = f * g;
+    // Calculate the ln of the equilibrium constant of the reaction
+    ThermoScalar lnK;
+    if(kernel.lnk) lnK = kernel.lnk(T, P);
+    else
+    {
+        ThermoScalar G0;
+        for(Index i = 0; i < num_reactants; ++i)
+        {
+            const MineralSpeciesLocation& loc = kernel.terms[i];
+            const ThermoVector& G0phase = tres[loc.iphase].standard_partial_molar_gibbs_energies;
+            G0.val += kernel.stoichiometries[i] * G0phase.val[loc.ilocal];
+            G0.ddT += kernel.stoichiometries[i] * G0phase.ddT[loc.ilocal];
+            G0.ddP += kernel.stoichiometries[i] * G0phase.ddP[loc.ilocal];
+        }
+        lnK = -G0/(universalGasConstant * Temperature(T));
+    }
 
-        return res;
-    };
+    // Calculate the ln of the reaction quotient of the reaction
+    ThermoScalar lnQ;
+    for(Index i = 0; i < num_reactants; ++i)
+    {
+        const MineralSpeciesLocation& loc = kernel.terms[i];
+        const ChemicalVector& ln_a = cres[loc.iphase].ln_activities;
+        lnQ.val += kernel.stoichiometries[i] * ln_a.val[loc.ilocal];
+        lnQ.ddT += kernel.stoichiometries[i] * ln_a.ddT[loc.ilocal];
+        lnQ.ddP += kernel.stoichiometries[i] * ln_a.ddP[loc.ilocal];
+    }
+
+    // Calculate the saturation index of the mineral, shared by all mechanisms
+    const ThermoScalar lnOmega = lnQ - lnK;
+    const double Omega = std::exp(lnOmega.val);
 
-    return fn;
+    // The total gaseous amount and the pressure in units of bar, for the partial pressure catalysts
+    const double ngsum = kernel.igases.size() ? rows(n, kernel.igases).sum() : 0.0;
+    const double Pbar = convertPascalToBar(P);
+
+    // The coefficient of the derivative of ln(Omega) in the derivative of the result
+    double dfdlnOmega = 0.0;
+
+    // Initialize the result and the coefficients of the ln activity derivatives
+    f.val = f.ddT = f.ddP = 0.0;
+    f.ddn.setZero(n.rows());
+    kernel.coefficients.fill(0.0);
+
+    Index iterm = num_reactants;
+
+    for(Index i = 0; i < num_mechanisms; ++i)
+    {
+        // Calculate the rate constant of the current mechanism and its temperature derivative
+        const double kappa = kernel.kappa[i] * std::exp(-kernel.EaR[i] * (1.0/T - 1.0/298.15));
+        const double kappa_T = kappa * kernel.EaR[i]/(T*T);
+
+        // Calculate the function of the saturation index and its derivative with respect to ln(Omega)
+        const double pOmega = std::pow(Omega, kernel.p[i]);
+        const double qOmega = std::pow(1 - pOmega, kernel.q[i]);
+        const double qOmega_lnOmega = -kernel.q[i] * kernel.p[i] * pOmega * std::pow(1 - pOmega, kernel.q[i] - 1);
+
+        // Calculate the ln of the catalyst function g and its temperature and pressure derivatives
+        ThermoScalar lng;
+
+        for(Index j = kernel.activity_catalysts_offset[i]; j < kernel.activity_catalysts_offset[i + 1]; ++j)
+        {
+            const MineralSpeciesLocation& loc = kernel.terms[num_reactants + j];
+            const ChemicalVector& ln_a = cres[loc.iphase].ln_activities;
+            const double power = kernel.activity_catalysts_power[j];
+            lng.val += power * ln_a.val[loc.ilocal];
+            lng.ddT += power * ln_a.ddT[loc.ilocal];
+            lng.ddP += power * ln_a.ddP[loc.ilocal];
+        }
+
+        for(Index j = kernel.pressure_catalysts_offset[i]; j < kernel.pressure_catalysts_offset[i + 1]; ++j)
+        {
+            const double power = kernel.pressure_catalysts_power[j];
+            const double xi = n[kernel.pressure_catalysts_species[j]]/ngsum;
+            lng.val += power * std::log(xi * Pbar);
+            lng.ddP += power/P;
+        }
+
+        const double g = std::exp(lng.val);
+
+        // Calculate the contribution of the current mechanism
+        const double fi = kappa * qOmega * g;
+
+        f.val += fi;
+        f.ddT += kappa_T * qOmega * g + kappa * qOmega_lnOmega * g * lnOmega.ddT + fi * lng.ddT;
+        f.ddP += kappa * qOmega_lnOmega * g * lnOmega.ddP + fi * lng.ddP;
+
+        dfdlnOmega += kappa * qOmega_lnOmega * g;
+
+        // Accumulate the coefficients of the ln activities of the activity catalysts
+        for(Index j = kernel.activity_catalysts_offset[i]; j < kernel.activity_catalysts_offset[i + 1]; ++j)
+            kernel.coefficients[iterm++] = fi * kernel.activity_catalysts_power[j];
+
+        // Accumulate the derivatives of the partial pressure catalysts with respect to the amounts of the gases
+        for(Index j = kernel.pressure_catalysts_offset[i]; j < kernel.pressure_catalysts_offset[i + 1]; ++j)
+        {
+            const double power = kernel.pressure_catalysts_power[j];
+            const Index igas = kernel.pressure_catalysts_species[j];
+            for(Index k : kernel.igases)
+                f.ddn[k] -= fi * power/ngsum;
+            f.ddn[igas] += fi * power/n[igas];
+        }
+    }
+
+    // Set the coefficients of the ln activities of the species in the reaction
+    kernel.coefficients.head(num_reactants) += dfdlnOmega * kernel.stoichiometries;
+
+    // Assemble the derivatives of the result with respect to the amounts of the species in one pass
+    for(Index i = 0; i < kernel.terms.size(); ++i)
+    {
+        const MineralSpeciesLocation& loc = kernel.terms[i];
+        const ChemicalVector& ln_a = cres[loc.iphase].ln_activities;
+        f.ddn.segment(loc.offset, loc.size) += kernel.coefficients[i] * ln_a.ddn.row(loc.ilocal).transpose();
+    }
 }
 
 inline auto surfaceAreaUnitError(std::string unit) -> void
@@ -461,13 +616,14 @@ auto createReaction(const MineralReaction& mineralrxn, const ChemicalSystem& sys
     if(mineralrxn.equilibriumConstant())
         reaction.setEquilibriumConstant(mineralrxn.equilibriumConstant());
 
-    // Create the mineral mechanism functions
-    std::vector<ReactionRateFunction> mechanisms;
-    for(const MineralMechanism& mechanism : mineralrxn.mechanisms())
-        mechanisms.push_back(mineralMechanismFunction(mechanism, reaction, system));
+    // Compile the rate kernel of the mineral reaction
+    MineralRateKernel kernel = mineralRateKernel(mineralrxn, reaction, system);
+
+    // The sum function of the mechanism contributions
+    ChemicalScalar f(num_species);
 
     // Create the mineral rate function
-    ReactionRateFunction rate = [=](const ChemicalProperties& properties)
+    ReactionRateFunction rate = [=](const ChemicalProperties& properties) mutable
     {
         // The composition of the chemical system
         const Vector& n = properties.composition();
@@ -475,12 +631,8 @@ auto createReaction(const MineralReaction& mineralrxn, const ChemicalSystem& sys
         // The number of moles of the mineral
         const double nm = n[imineral];
 
-        // The sum function of the mechanism contributions
-        ChemicalScalar f(num_species);
-
-        // Iterate over all mechanism functions
-        for(const ReactionRateFunction& mechanism : mechanisms)
-            f += mechanism(properties);
+        // Evaluate the sum of the mechanism contributions
+        mineralMechanismsFunction(kernel, properties, f);
 
         // Multiply the mechanism contributions by the molar surface area of the mineral
         f *= molar_surface_area;
@@ -0,0 +1,77 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Mesh.hpp"
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+
+namespace Reaktoro {
+
+Mesh::Mesh()
+{
+    setDiscretization(m_num_cells, m_xl, m_xr);
+}
+
+Mesh::Mesh(Index num_cells, double xl, double xr)
+{
+    setDiscretization(num_cells, xl, xr);
+}
+
+auto Mesh::setDiscretization(Index num_cells, double xl, double xr) -> void
+{
+    Assert(num_cells > 0,
+        "Could not set the discretization of the mesh.",
+        "Expecting a positive number of cells.");
+
+    Assert(xr > xl,
+        "Could not set the discretization of the mesh.",
+        "Expecting a right boundary greater than the left boundary.");
+
+    m_num_cells = num_cells;
+    m_xl = xl;
+    m_xr = xr;
+    m_dx = (xr - xl)/num_cells;
+    m_xcells = linspace(num_cells, xl + 0.5*m_dx, xr - 0.5*m_dx);
+}
+
+auto Mesh::numCells() const -> Index
+{
+    return m_num_cells;
+}
+
+auto Mesh::xl() const -> double
+{
+    return m_xl;
+}
+
+auto Mesh::xr() const -> double
+{
+    return m_xr;
+}
+
+auto Mesh::dx() const -> double
+{
+    return m_dx;
+}
+
+auto Mesh::xcells() const -> const Vector&
+{
+    return m_xcells;
+}
+
+} // namespace Reaktoro
@@ -0,0 +1,77 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+#include <Reaktoro/Math/Matrix.hpp>
+
+namespace Reaktoro {
+
+/// A type that describes a uniform one-dimensional mesh of cells.
+class Mesh
+{
+public:
+    /// Construct a default Mesh instance.
+    Mesh();
+
+    /// Construct a Mesh instance with given number of cells and domain boundaries.
+    /// @param num_cells The number of cells in the mesh
+    /// @param xl The x-coordinate of the left boundary (in units of m)
+    /// @param xr The x-coordinate of the right boundary (in units of m)
+    Mesh(Index num_cells, double xl = 0.0, double xr = 1.0);
+
+    /// Set the discretization of the mesh.
+    /// @param num_cells The number of cells in the mesh
+    /// @param xl The x-coordinate of the left boundary (in units of m)
+    /// @param xr The x-coordinate of the right boundary (in units of m)
+    auto setDiscretization(Index num_cells, double xl = 0.0, double xr = 1.0) -> void;
+
+    /// Return the number of cells in the mesh.
+    auto numCells() const -> Index;
+
+    /// Return the x-coordinate of the left boundary (in units of m).
+    auto xl() const -> double;
+
+    /// Return the x-coordinate of the right boundary (in units of m).
+    auto xr() const -> double;
+
+    /// Return the length of the cells (in units of m).
+    auto dx() const -> double;
+
+    /// Return the x-coordinates of the centers of the cells (in units of m).
+    auto xcells() const -> const Vector&;
+
+private:
+    /// The number of cells in the mesh.
+    Index m_num_cells = 10;
+
+    /// The x-coordinate of the left boundary (in units of m).
+    double m_xl = 0.0;
+
+    /// The x-coordinate of the right boundary (in units of m).
+    double m_xr = 1.0;
+
+    /// The length of the cells (in units of m).
+    double m_dx = 0.1;
+
+    /// The x-coordinates of the centers of the cells (in units of m).
+    Vector m_xcells;
+};
+
+} // namespace Reaktoro
@@ -0,0 +1,289 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ReactiveTransportSolver.hpp"
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/TimeUtils.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Partition.hpp>
+#include <Reaktoro/Core/ReactionSystem.hpp>
+#include <Reaktoro/Kinetics/KineticState.hpp>
+#include <Reaktoro/Transport/Mesh.hpp>
+#include <Reaktoro/Util/ChemicalSolver.hpp>
+
+namespace Reaktoro {
+
+struct ReactiveTransportSolver::Impl
+{
+    /// The chemical system instance
+    ChemicalSystem system;
+
+    /// The reaction system instance
+    ReactionSystem reactions;
+
+    /// The partition of the chemical system
+    Partition partition;
+
+    /// The mesh of the reactive transport problem
+    Mesh mesh;
+
+    /// The solver for the transport equations
+    TransportSolver transport;
+
+    /// The solver for the chemical calculations at the cells
+    ChemicalSolver solver;
+
+    /// The number of threads for the chemical calculations
+    Index nthreads = 1;
+
+    /// The time step for which the transport solver was last initialized
+    double dt = 0.0;
+
+    /// The temperatures and pressures at every cell
+    Vector T, P;
+
+    /// The indices of the equilibrium fluid and solid species
+    Indices iefs, iess;
+
+    /// The formula matrices of the equilibrium fluid and solid species w.r.t. the equilibrium elements
+    Matrix Wf, Ws;
+
+    /// The amounts of the equilibrium elements in the fluid injected at the left boundary
+    Vector bl;
+
+    /// The amounts of each equilibrium element in the fluid, solid, and all equilibrium species at every cell
+    std::vector<Vector> bf, bs, be;
+
+    /// The accumulated result of the reactive transport steps
+    ReactiveTransportResult result;
+
+    /// Construct a custom Impl instance with given chemical system
+    Impl(const ChemicalSystem& system)
+    : system(system), partition(system)
+    {}
+
+    /// Construct a custom Impl instance with given reaction system
+    Impl(const ReactionSystem& reactions)
+    : system(reactions.system()), reactions(reactions), partition(system)
+    {}
+
+    /// Set the partition of the chemical system
+    auto setPartition(const Partition& partition_) -> void
+    {
+        partition = partition_;
+
+        // The indices of the equilibrium elements and species
+        const Indices& iee = partition.indicesEquilibriumElements();
+        iefs = partition.indicesEquilibriumFluidSpecies();
+        iess = partition.indicesEquilibriumSolidSpecies();
+
+        // The formula matrices of the mobile and immobile equilibrium species
+        Wf = submatrix(system.formulaMatrix(), iee, iefs);
+        Ws = submatrix(system.formulaMatrix(), iee, iess);
+    }
+
+    /// Set the chemical state of the fluid injected at the left boundary
+    auto setBoundaryState(const ChemicalState& state) -> void
+    {
+        bl = Wf * rows(state.speciesAmounts(), iefs);
+    }
+
+    /// Initialize the chemical state of all cells uniformly
+    auto initialize(const KineticState& state) -> void
+    {
+        const Index ncells = mesh.numCells();
+        const Index Ee = partition.numEquilibriumElements();
+
+        Assert(bl.rows() == static_cast<int>(Ee),
+            "Could not initialize the reactive transport solver.",
+            "The chemical state at the left boundary has not been set.");
+
+        // Initialize the chemical solver over all cells
+        if(reactions.numReactions())
+            solver = ChemicalSolver(reactions, ncells);
+        else solver = ChemicalSolver(system, ncells);
+
+        solver.setPartition(partition);
+        solver.setNumThreads(nthreads);
+        solver.setStates(state);
+
+        // Initialize the structure-of-arrays fields
+        T = constants(ncells, state.temperature());
+        P = constants(ncells, state.pressure());
+        bf.assign(Ee, zeros(ncells));
+        bs.assign(Ee, zeros(ncells));
+        be.assign(Ee, zeros(ncells));
+
+        // Initialize the transport solver
+        transport.setMesh(mesh);
+        dt = 0.0;
+
+        // Reset the accumulated result
+        result = ReactiveTransportResult();
+        result.num_cells = ncells;
+    }
+
+    /// Perform one reactive transport step
+    auto step(double t, double dt_) -> void
+    {
+        Assert(solver.numPoints() == mesh.numCells(),
+            "Could not perform a reactive transport step.",
+            "The reactive transport solver has not been initialized.");
+
+        const Time begin = time();
+
+        // Initialize the transport solver, whose factorization depends on the time step
+        if(dt_ != dt)
+        {
+            dt = dt_;
+            transport.setTimeStep(dt);
+            transport.initialize();
+        }
+
+        const Index ncells = mesh.numCells();
+        const Index Ee = bf.size();
+
+        // Split the element amounts at every cell into the mobile and immobile parts
+        Vector bfk, bsk;
+        for(Index k = 0; k < ncells; ++k)
+        {
+            const Vector& n = solver.state(k).speciesAmounts();
+            bfk = Wf * rows(n, iefs);
+            bsk = Ws * rows(n, iess);
+            for(Index j = 0; j < Ee; ++j)
+            {
+                bf[j][k] = bfk[j];
+                bs[j][k] = bsk[j];
+            }
+        }
+
+        // Transport the element amounts in the fluid species
+        for(Index j = 0; j < Ee; ++j)
+            transport.step(bf[j], bl[j]);
+
+        // Assemble the element amounts for the equilibrium calculations
+        for(Index j = 0; j < Ee; ++j)
+            be[j] = bf[j] + bs[j];
+
+        const Time end_transport = time();
+
+        // Equilibrate every cell with the updated element amounts
+        solver.equilibrate(T, P, ChemicalSolver::Grid<double>(be));
+
+        const Time end_equilibrium = time();
+
+        // React every cell over the time step
+        if(reactions.numReactions())
+            solver.react(t, dt);
+
+        const Time end = time();
+
+        result.num_steps += 1;
+        result.time_transport += elapsed(end_transport, begin);
+        result.time_equilibrium += elapsed(end_equilibrium, end_transport);
+        result.time_kinetics += elapsed(end, end_equilibrium);
+        result.time += elapsed(end, begin);
+    }
+};
+
+ReactiveTransportSolver::ReactiveTransportSolver(const ChemicalSystem& system)
+: pimpl(new Impl(system))
+{
+    setPartition(Partition(system));
+}
+
+ReactiveTransportSolver::ReactiveTransportSolver(const ReactionSystem& reactions)
+: pimpl(new Impl(reactions))
+{
+    setPartition(Partition(reactions.system()));
+}
+
+ReactiveTransportSolver::ReactiveTransportSolver(const ReactiveTransportSolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+ReactiveTransportSolver::~ReactiveTransportSolver()
+{}
+
+auto ReactiveTransportSolver::operator=(ReactiveTransportSolver other) -> ReactiveTransportSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto ReactiveTransportSolver::setMesh(const Mesh& mesh) -> void
+{
+    pimpl->mesh = mesh;
+}
+
+auto ReactiveTransportSolver::setVelocity(double val) -> void
+{
+    pimpl->transport.setVelocity(val);
+    pimpl->dt = 0.0;
+}
+
+auto ReactiveTransportSolver::setDiffusionCoeff(double val) -> void
+{
+    pimpl->transport.setDiffusionCoeff(val);
+    pimpl->dt = 0.0;
+}
+
+auto ReactiveTransportSolver::setScheme(TransportScheme scheme) -> void
+{
+    pimpl->transport.setScheme(scheme);
+    pimpl->dt = 0.0;
+}
+
+auto ReactiveTransportSolver::setPartition(const Partition& partition) -> void
+{
+    pimpl->setPartition(partition);
+}
+
+auto ReactiveTransportSolver::setNumThreads(Index nthreads) -> void
+{
+    pimpl->nthreads = nthreads;
+}
+
+auto ReactiveTransportSolver::setBoundaryState(const ChemicalState& state) -> void
+{
+    pimpl->setBoundaryState(state);
+}
+
+auto ReactiveTransportSolver::initialize(const KineticState& state) -> void
+{
+    pimpl->initialize(state);
+}
+
+auto ReactiveTransportSolver::step(double t, double dt) -> void
+{
+    pimpl->step(t, dt);
+}
+
+auto ReactiveTransportSolver::chemicalSolver() -> ChemicalSolver&
+{
+    return pimpl->solver;
+}
+
+auto ReactiveTransportSolver::result() const -> const ReactiveTransportResult&
+{
+    return pimpl->result;
+}
+
+} // namespace Reaktoro
@@ -0,0 +1,135 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+#include <Reaktoro/Transport/TransportSolver.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalSolver;
+class ChemicalState;
+class ChemicalSystem;
+class KineticState;
+class Mesh;
+class Partition;
+class ReactionSystem;
+
+/// A type that describes the accumulated result of reactive transport steps.
+struct ReactiveTransportResult
+{
+    /// The number of cells in the mesh
+    Index num_cells = 0;
+
+    /// The number of reactive transport steps performed
+    Index num_steps = 0;
+
+    /// The wall time spent for the transport of the fluid element amounts (in units of s)
+    double time_transport = 0;
+
+    /// The wall time spent for the equilibrium calculations at every cell (in units of s)
+    double time_equilibrium = 0;
+
+    /// The wall time spent for the kinetic calculations at every cell (in units of s)
+    double time_kinetics = 0;
+
+    /// The wall time spent for all reactive transport steps (in units of s)
+    double time = 0;
+};
+
+/// A solver for one-dimensional reactive transport problems using operator splitting.
+/// Every step first transports the molar amounts of the equilibrium elements in the
+/// fluid species of each cell, while those in the solid species remain immobile.
+/// The chemical state of every cell is then equilibrated with the updated element
+/// amounts and, if a reaction system was given, reacted over the time step, using
+/// a ChemicalSolver instance. All field data is stored as structure-of-arrays,
+/// with one vector over the cells for each element, which is the layout consumed
+/// by ChemicalSolver::equilibrate.
+/// @note Only the equilibrium species are transported. The amounts of kinetic species,
+/// including those in fluid phases (e.g., kinetically controlled aqueous species),
+/// remain in their cells and change only through the kinetic calculations. Partitions
+/// with kinetic fluid species should be used only when this is acceptable.
+class ReactiveTransportSolver
+{
+public:
+    /// Construct a ReactiveTransportSolver instance for equilibrium-controlled chemistry.
+    explicit ReactiveTransportSolver(const ChemicalSystem& system);
+
+    /// Construct a ReactiveTransportSolver instance for kinetically-controlled chemistry.
+    explicit ReactiveTransportSolver(const ReactionSystem& reactions);
+
+    /// Construct a copy of a ReactiveTransportSolver instance.
+    ReactiveTransportSolver(const ReactiveTransportSolver& other);
+
+    /// Destroy this ReactiveTransportSolver instance.
+    virtual ~ReactiveTransportSolver();
+
+    /// Assign a copy of a ReactiveTransportSolver instance.
+    auto operator=(ReactiveTransportSolver other) -> ReactiveTransportSolver&;
+
+    /// Set the mesh of the reactive transport problem.
+    auto setMesh(const Mesh& mesh) -> void;
+
+    /// Set the velocity of the fluid (in units of m/s).
+    auto setVelocity(double val) -> void;
+
+    /// Set the diffusion coefficient of the fluid species (in units of m2/s).
+    auto setDiffusionCoeff(double val) -> void;
+
+    /// Set the numerical scheme for the advection term.
+    auto setScheme(TransportScheme scheme) -> void;
+
+    /// Set the partition of the chemical system.
+    /// The kinetic species in the partition are not transported, even if they are fluid species.
+    auto setPartition(const Partition& partition) -> void;
+
+    /// Set the number of threads used for the chemical calculations at the cells.
+    /// @see ChemicalSolver::setNumThreads
+    auto setNumThreads(Index nthreads) -> void;
+
+    /// Set the chemical state of the fluid injected at the left boundary.
+    /// The amounts of its fluid species should be expressed with the same scale as those in the cells.
+    auto setBoundaryState(const ChemicalState& state) -> void;
+
+    /// Initialize the chemical state of all cells uniformly.
+    /// This method should be invoked after all the parameters of the problem have been set.
+    auto initialize(const KineticState& state) -> void;
+
+    /// Perform one reactive transport step.
+    /// @param t The current time (in units of s)
+    /// @param dt The time step (in units of s)
+    auto step(double t, double dt) -> void;
+
+    /// Return the chemical solver with the chemical states at all cells.
+    auto chemicalSolver() -> ChemicalSolver&;
+
+    /// Return the accumulated result of the reactive transport steps.
+    auto result() const -> const ReactiveTransportResult&;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
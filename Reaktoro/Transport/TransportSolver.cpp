@@ -0,0 +1,225 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "TransportSolver.hpp"
+
+// C++ includes
+#include <cmath>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Transport/Mesh.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// The van Leer limiter function.
+inline auto vanLeer(double r) -> double
+{
+    return (r + std::abs(r))/(1.0 + std::abs(r));
+}
+
+} // namespace
+
+struct TransportSolver::Impl
+{
+    /// The mesh of the transport problem
+    Mesh mesh;
+
+    /// The velocity of the transport problem (in units of m/s)
+    double velocity = 0.0;
+
+    /// The diffusion coefficient of the transport problem (in units of m2/s)
+    double diffusion = 0.0;
+
+    /// The time step of the transport problem (in units of s)
+    double dt = 0.0;
+
+    /// The numerical scheme for the advection term
+    TransportScheme scheme = TransportScheme::ImplicitUpwind;
+
+    /// The sub-diagonal, diagonal, and super-diagonal of the factorized tridiagonal matrix
+    Vector a, b, c;
+
+    /// The coefficient of the boundary value in the right-hand side of the implicit step
+    double cl = 0.0;
+
+    /// The number of explicit advection sub-steps in the flux limited scheme
+    Index nsubsteps = 0;
+
+    /// The Courant number of every explicit advection sub-step
+    double courant = 0.0;
+
+    /// The auxiliary vector with the advective fluxes at the cell faces
+    Vector flux;
+
+    /// Initialize the transport solver
+    auto initialize() -> void
+    {
+        Assert(velocity >= 0.0,
+            "Could not initialize the transport solver.",
+            "Expecting a non-negative velocity.");
+
+        Assert(diffusion >= 0.0,
+            "Could not initialize the transport solver.",
+            "Expecting a non-negative diffusion coefficient.");
+
+        Assert(dt > 0.0,
+            "Could not initialize the transport solver.",
+            "Expecting a positive time step.");
+
+        const Index n = mesh.numCells();
+        const double dx = mesh.dx();
+
+        // The dimensionless diffusion and advection numbers
+        const double alpha = diffusion*dt/(dx*dx);
+        const double beta = velocity*dt/dx;
+
+        // The implicit step only includes advection in the upwind scheme
+        const double gamma = (scheme == TransportScheme::ImplicitUpwind) ? beta : 0.0;
+
+        // Assemble the tridiagonal matrix of the implicit step, in which the
+        // diffusive flux at the left boundary uses the half-cell distance dx/2
+        // and the right boundary has no diffusive flux
+        a = constants(n, -alpha - gamma);
+        b = constants(n, 1.0 + 2*alpha + gamma);
+        c = constants(n, -alpha);
+        a[0] = 0.0;
+        b[0] = 1.0 + 3*alpha + gamma;
+        b[n - 1] = 1.0 + alpha + gamma;
+        c[n - 1] = 0.0;
+        cl = 2*alpha + gamma;
+
+        // Factorize the tridiagonal matrix, with `b` storing the pivots and `a` the multipliers
+        for(Index i = 1; i < n; ++i)
+        {
+            a[i] /= b[i - 1];
+            b[i] -= a[i] * c[i - 1];
+        }
+
+        // Determine the sub-steps of the explicit flux limited advection, keeping a Courant number below 1/2
+        nsubsteps = (scheme == TransportScheme::FluxLimited) ? Index(std::ceil(2*beta)) : 0;
+        courant = nsubsteps ? beta/nsubsteps : 0.0;
+        flux.resize(n + 1);
+    }
+
+    /// Apply the explicit flux limited advection step
+    auto advect(Vector& u, double ul) -> void
+    {
+        const Index n = u.rows();
+
+        for(Index s = 0; s < nsubsteps; ++s)
+        {
+            // The advective flux at the left boundary face
+            flux[0] = ul;
+
+            // The advective fluxes at the internal faces with limited second-order reconstruction
+            for(Index i = 0; i + 1 < n; ++i)
+            {
+                const double uprev = i ? u[i - 1] : ul;
+                const double du = u[i + 1] - u[i];
+                const double r = du ? (u[i] - uprev)/du : 0.0;
+                flux[i + 1] = u[i] + 0.5*vanLeer(r)*(1.0 - courant)*du;
+            }
+
+            // The first-order advective flux at the right (outflow) boundary face
+            flux[n] = u[n - 1];
+
+            for(Index i = 0; i < n; ++i)
+                u[i] -= courant * (flux[i + 1] - flux[i]);
+        }
+    }
+
+    /// Step the transport equation of a field
+    auto step(Vector& u, double ul) -> void
+    {
+        Assert(u.rows() == static_cast<int>(mesh.numCells()),
+            "Could not step the transport equation.",
+            "Expecting as many field values as there are cells in the mesh.");
+
+        // Apply the explicit advection sub-steps of the flux limited scheme
+        if(nsubsteps) advect(u, ul);
+
+        // Solve the implicit step with the factorized tridiagonal matrix
+        const Index n = u.rows();
+        u[0] += cl * ul;
+        for(Index i = 1; i < n; ++i)
+            u[i] -= a[i] * u[i - 1];
+        u[n - 1] /= b[n - 1];
+        for(Index i = n - 1; i > 0; --i)
+            u[i - 1] = (u[i - 1] - c[i - 1] * u[i])/b[i - 1];
+    }
+};
+
+TransportSolver::TransportSolver()
+: pimpl(new Impl())
+{}
+
+TransportSolver::TransportSolver(const TransportSolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+TransportSolver::~TransportSolver()
+{}
+
+auto TransportSolver::operator=(TransportSolver other) -> TransportSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto TransportSolver::setMesh(const Mesh& mesh) -> void
+{
+    pimpl->mesh = mesh;
+}
+
+auto TransportSolver::setVelocity(double val) -> void
+{
+    pimpl->velocity = val;
+}
+
+auto TransportSolver::setDiffusionCoeff(double val) -> void
+{
+    pimpl->diffusion = val;
+}
+
+auto TransportSolver::setTimeStep(double val) -> void
+{
+    pimpl->dt = val;
+}
+
+auto TransportSolver::setScheme(TransportScheme scheme) -> void
+{
+    pimpl->scheme = scheme;
+}
+
+auto TransportSolver::mesh() const -> const Mesh&
+{
+    return pimpl->mesh;
+}
+
+auto TransportSolver::initialize() -> void
+{
+    pimpl->initialize();
+}
+
+auto TransportSolver::step(Vector& u, double ul) -> void
+{
+    pimpl->step(u, ul);
+}
+
+} // namespace Reaktoro
@@ -0,0 +1,96 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Reaktoro includes
+#include <Reaktoro/Math/Matrix.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class Mesh;
+
+/// The numerical schemes for the advection term in the transport equations.
+enum class TransportScheme
+{
+    /// The first-order implicit upwind scheme (unconditionally stable).
+    ImplicitUpwind,
+
+    /// The explicit second-order flux limited scheme (TVD) with van Leer limiter.
+    /// The advection step is divided into sub-steps that respect the CFL condition.
+    FluxLimited,
+};
+
+/// A solver for the one-dimensional advection-diffusion equation.
+/// This class solves the equation \f$u_t + v u_x = D u_{xx}\f$ on a uniform mesh,
+/// with a prescribed value \f$u_l\f$ at the left (inflow) boundary and a free
+/// outflow at the right boundary. The velocity is expected to be non-negative.
+/// The diffusion term is always treated implicitly, and the tridiagonal matrix
+/// of the implicit step is factorized once in @ref initialize and reused for
+/// every field stepped with the same mesh, coefficients and time step.
+class TransportSolver
+{
+public:
+    /// Construct a default TransportSolver instance.
+    TransportSolver();
+
+    /// Construct a copy of a TransportSolver instance.
+    TransportSolver(const TransportSolver& other);
+
+    /// Destroy this TransportSolver instance.
+    virtual ~TransportSolver();
+
+    /// Assign a copy of a TransportSolver instance.
+    auto operator=(TransportSolver other) -> TransportSolver&;
+
+    /// Set the mesh of the transport problem.
+    auto setMesh(const Mesh& mesh) -> void;
+
+    /// Set the velocity of the transport problem (in units of m/s).
+    auto setVelocity(double val) -> void;
+
+    /// Set the diffusion coefficient of the transport problem (in units of m2/s).
+    auto setDiffusionCoeff(double val) -> void;
+
+    /// Set the time step of the transport problem (in units of s).
+    auto setTimeStep(double val) -> void;
+
+    /// Set the numerical scheme for the advection term.
+    auto setScheme(TransportScheme scheme) -> void;
+
+    /// Return the mesh of the transport problem.
+    auto mesh() const -> const Mesh&;
+
+    /// Initialize the transport solver after its parameters have been set.
+    auto initialize() -> void;
+
+    /// Step the transport equation of a field.
+    /// @param[in,out] u The values of the field at the cells
+    /// @param ul The value of the field at the left boundary
+    auto step(Vector& u, double ul) -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
@@ -0,0 +1,83 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BinaryHeader.hpp"
+
+// C++ includes
+#include <cstring>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Element.hpp>
+#include <Reaktoro/Core/Phase.hpp>
+#include <Reaktoro/Core/Species.hpp>
+
+namespace Reaktoro {
+namespace {
+
+static_assert(sizeof(BinaryHeader) == 48, "Expecting a binary header with six 64-bit words.");
+
+/// Update a 64-bit FNV-1a hash with the characters of a string, including its terminating null character.
+auto fnv1a(std::uint64_t hash, const std::string& str) -> std::uint64_t
+{
+    for(const char c : str)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    return hash * 1099511628211ULL;
+}
+
+} // namespace
+
+auto fingerprint(const ChemicalSystem& system) -> std::uint64_t
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for(const Element& element : system.elements())
+        hash = fnv1a(hash, element.name());
+    for(const Phase& phase : system.phases())
+    {
+        hash = fnv1a(hash, phase.name());
+        for(const Species& species : phase.species())
+            hash = fnv1a(hash, species.name());
+    }
+    return hash;
+}
+
+auto initBinaryHeader(BinaryHeader& header, const char* magic, std::uint64_t version, const ChemicalSystem& system, Index record) -> void
+{
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.fingerprint = fingerprint(system);
+    header.N = system.numSpecies();
+    header.E = system.numElements();
+    header.record = record;
+}
+
+auto checkBinaryHeader(const BinaryHeader& header, const char* magic, std::uint64_t version, const ChemicalSystem& system,
+    const std::string& error, const std::string& source, const std::string& contents) -> void
+{
+    Assert(std::memcmp(header.magic, magic, sizeof(header.magic)) == 0,
+        error, source + " does not contain " + contents + ".");
+
+    Assert(header.version == version,
+        error, source + " has an unsupported format version.");
+
+    Assert(header.fingerprint == fingerprint(system) &&
+        header.N == system.numSpecies() && header.E == system.numElements(),
+        error, source + " was written with a different chemical system.");
+}
+
+} // namespace Reaktoro
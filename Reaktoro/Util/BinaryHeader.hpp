@@ -0,0 +1,78 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <string>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalSystem;
+
+/// The header that starts every binary file of chemical data written by Reaktoro.
+/// The header identifies the format of the file and the chemical system of its records,
+/// which are fixed-size sequences of doubles in native byte order. A format with more
+/// metadata derives from this header and appends its own 64-bit words to it.
+/// @see ChemicalStateWriter, ChemicalSolver::checkpoint
+struct BinaryHeader
+{
+    /// The characters that identify the format of the file
+    char magic[8];
+
+    /// The version of the format
+    std::uint64_t version;
+
+    /// The fingerprint of the chemical system of the records
+    std::uint64_t fingerprint;
+
+    /// The number of species and elements in the chemical system
+    std::uint64_t N, E;
+
+    /// The number of doubles in each record
+    std::uint64_t record;
+};
+
+/// Return the fingerprint of a chemical system.
+/// The fingerprint is a 64-bit FNV-1a hash of the names of the elements, phases, and species.
+auto fingerprint(const ChemicalSystem& system) -> std::uint64_t;
+
+/// Initialize a binary header for the records of a chemical system.
+/// @param header The binary header to be initialized
+/// @param magic The eight characters that identify the format of the file
+/// @param version The version of the format
+/// @param system The chemical system of the records
+/// @param record The number of doubles in each record
+auto initBinaryHeader(BinaryHeader& header, const char* magic, std::uint64_t version, const ChemicalSystem& system, Index record) -> void;
+
+/// Check if a binary header has a given format and is compatible with a chemical system.
+/// @param header The binary header to be checked
+/// @param magic The eight characters that identify the expected format
+/// @param version The expected version of the format
+/// @param system The chemical system of the records
+/// @param error The error message if the check fails
+/// @param source The description of the source of the header (e.g., "The file `states.bin`")
+/// @param contents The description of the expected contents (e.g., "chemical states in binary format")
+auto checkBinaryHeader(const BinaryHeader& header, const char* magic, std::uint64_t version, const ChemicalSystem& system,
+    const std::string& error, const std::string& source, const std::string& contents) -> void;
+
+} // namespace Reaktoro
@@ -18,10 +18,17 @@
 #include "ChemicalSolver.hpp"
 
 // C++ includes
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Profiling.hpp>
 #include <Reaktoro/Core/ChemicalProperties.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 #include <Reaktoro/Core/Partition.hpp>
@@ -31,9 +38,52 @@
 #include <Reaktoro/Equilibrium/EquilibriumSensitivity.hpp>
 #include <Reaktoro/Kinetics/KineticSolver.hpp>
 #include <Reaktoro/Kinetics/KineticState.hpp>
+#include <Reaktoro/Util/BinaryHeader.hpp>
 #include <Reaktoro/Util/ChemicalField.hpp>
 
 namespace Reaktoro {
+namespace {
+
+/// Return a copy of a chemical system whose phase models are not shared with the original system.
+/// The model functions of the phases may keep mutable auxiliary data among evaluations,
+/// so that every thread evaluating chemical properties needs its own copy of them.
+auto independentCopy(const ChemicalSystem& system) -> ChemicalSystem
+{
+    std::vector<Phase> phases;
+    phases.reserve(system.numPhases());
+    for(const Phase& phase : system.phases())
+    {
+        Phase copy;
+        copy.setName(phase.name());
+        copy.setType(phase.type());
+        copy.setSpecies(phase.species());
+        copy.setThermoModel(phase.thermoModel());
+        copy.setChemicalModel(phase.chemicalModel());
+        copy.elements() = phase.elements();
+        phases.push_back(copy);
+    }
+    return ChemicalSystem(phases);
+}
+
+/// The header of a binary checkpoint file of a ChemicalSolver instance.
+struct CheckpointHeader : BinaryHeader
+{
+    /// The number of field points, equilibrium species, and equilibrium elements
+    std::uint64_t npoints, Ne, Ee;
+};
+
+static_assert(sizeof(CheckpointHeader) == 72, "Expecting a checkpoint header with nine 64-bit words.");
+
+/// The characters that identify a checkpoint file
+const char checkpoint_magic[8] = {'R', 'K', 'T', 'C', 'H', 'K', 'P', 'T'};
+
+/// The current version of the checkpoint format
+const std::uint64_t checkpoint_version = 2;
+
+/// The number of field points written or read at once in a checkpoint file
+const Index checkpoint_chunk = 4096;
+
+} // namespace
 
 struct ChemicalSolver::Impl
 {
@@ -46,6 +96,12 @@ struct ChemicalSolver::Impl
     /// The number of field points
     Index npoints;
 
+    /// The number of threads used for the chemical calculations at the field points
+    Index nthreads = 1;
+
+    /// The first field point of each thread, followed by the number of field points
+    Indices offsets;
+
     /// The partitioning of the chemical system
     Partition partition;
 
@@ -64,15 +120,27 @@ struct ChemicalSolver::Impl
     /// The chemical properties at each point in the field
     std::vector<ChemicalProperties> properties;
 
-    /// The equilibrium solver
-    EquilibriumSolver equilibriumsolver;
+    /// The flag that indicates if the chemical properties need to be recomputed from the chemical states
+    bool stale_properties = false;
+
+    /// The chemical systems used by each thread (the first one is the original system)
+    std::vector<ChemicalSystem> systems;
 
-    /// The kinetic solver
-    KineticSolver kineticsolver;
+    /// The equilibrium solvers used by each thread
+    std::vector<EquilibriumSolver> equilibriumsolvers;
+
+    /// The kinetic solvers used by each thread
+    std::vector<KineticSolver> kineticsolvers;
 
     /// The equilibrium sensitivity at every field point
     std::vector<EquilibriumSensitivity> sensitivities;
 
+    /// The counters and timers aggregated over all field points and threads
+    Profiler profile;
+
+    /// The mutex that protects the aggregation of the counters and timers of the threads
+    std::mutex profilemutex;
+
     /// The molar amounts of the chemical components at every field point
     std::vector<Vector> c;
 
@@ -110,8 +178,17 @@ struct ChemicalSolver::Impl
       npoints(npoints),
       states(npoints, KineticState(system)),
       properties(npoints),
-      equilibriumsolver(system)
+      systems(1, system),
+      equilibriumsolvers(1, EquilibriumSolver(system))
     {
+        // Initialize the number of species and elements in the system
+        N = system.numSpecies();
+        E = system.numElements();
+
+        // Initialize the field points of the single thread
+        offsets = {0, npoints};
+
+        // Initialize the default partition of the chemical system
         setPartition(Partition(system));
     }
 
@@ -122,13 +199,17 @@ struct ChemicalSolver::Impl
       npoints(npoints),
       states(npoints, KineticState(system)),
       properties(npoints),
-      equilibriumsolver(system),
-      kineticsolver(reactions)
+      systems(1, system),
+      equilibriumsolvers(1, EquilibriumSolver(system)),
+      kineticsolvers(1, KineticSolver(reactions))
     {
         // Initialize the number of species and elements in the system
         N = system.numSpecies();
         E = system.numElements();
 
+        // Initialize the field points of the single thread
+        offsets = {0, npoints};
+
         // Initialize the default partition of the chemical system
         setPartition(Partition(system));
     }
@@ -147,13 +228,127 @@ struct ChemicalSolver::Impl
         Nc  = Ee + Nk;
 
         // Set the partition of the equilibrium and kinetic solvers
-        if(Ne) equilibriumsolver.setPartition(partition);
-        if(Nk) kineticsolver.setPartition(partition);
+        if(Ne) for(EquilibriumSolver& solver : equilibriumsolvers)
+            solver.setPartition(partition);
+        if(Nk) for(KineticSolver& solver : kineticsolvers)
+            solver.setPartition(partition);
 
         // Initialize the sensitivities member
         sensitivities.resize(npoints);
     }
 
+    /// Set the number of threads used for the chemical calculations.
+    auto setNumThreads(Index nthreads_) -> void
+    {
+        Assert(nthreads_ > 0,
+            "Could not set the number of threads of the chemical solver.",
+            "Expecting a positive number of threads.");
+
+        // Ensure there are no threads without field points
+        nthreads = std::min(nthreads_, std::max(npoints, Index(1)));
+
+        // Distribute the field points as evenly as possible among the threads
+        offsets.resize(nthreads + 1);
+        for(Index t = 0; t <= nthreads; ++t)
+            offsets[t] = t * npoints / nthreads;
+
+        // Initialize an independent chemical system and solvers for every additional thread
+        systems.resize(1);
+        equilibriumsolvers.resize(1);
+        for(Index t = 1; t < nthreads; ++t)
+        {
+            systems.push_back(independentCopy(systems.front()));
+            equilibriumsolvers.push_back(EquilibriumSolver(systems.back()));
+        }
+
+        if(kineticsolvers.size())
+        {
+            kineticsolvers.resize(1);
+            for(Index t = 1; t < nthreads; ++t)
+                kineticsolvers.push_back(KineticSolver(ReactionSystem(systems[t], reactions.reactions())));
+        }
+
+        // Bind the chemical states at the field points of each thread to its chemical system
+        for(Index t = 0; t < nthreads; ++t)
+        {
+            for(Index k = offsets[t]; k < offsets[t + 1]; ++k)
+            {
+                KineticState state(systems[t]);
+                assign(state, states[k]);
+                states[k] = state;
+            }
+        }
+
+        // Set the partition of the new solvers
+        setPartition(partition);
+    }
+
+    /// Assign the temperature, pressure, amounts and dual potentials of a state to another.
+    /// The destination state remains bound to its own chemical system.
+    static auto assign(KineticState& dst, const KineticState& src) -> void
+    {
+        dst.setTemperature(src.temperature());
+        dst.setPressure(src.pressure());
+        dst.setSpeciesAmounts(src.speciesAmounts());
+        dst.setElementDualPotentials(src.elementDualPotentials());
+        dst.setSpeciesDualPotentials(src.speciesDualPotentials());
+    }
+
+    /// Set the chemical state at a field point.
+    auto setStateAt(Index ipoint, const KineticState& state) -> void
+    {
+        if(nthreads == 1) states[ipoint] = state;
+        else assign(states[ipoint], state);
+    }
+
+    /// Apply a function `f(ithread, ipoint)` at every field point using all threads.
+    template<typename Function>
+    auto parallel(const Function& f) -> void
+    {
+        // Apply the function in a given range of field points, collecting the events recorded by the thread
+        auto apply = [&](Index t, Index begin, Index end)
+        {
+            Profiler saved;
+            std::swap(saved, profiler());
+            try {
+                for(Index k = begin; k < end; ++k)
+                    f(t, k);
+            } catch(...) {
+                std::swap(saved, profiler());
+                throw;
+            }
+            std::swap(saved, profiler());
+            std::lock_guard<std::mutex> lock(profilemutex);
+            profile += saved;
+        };
+
+        if(nthreads == 1)
+            return apply(0, 0, npoints);
+
+        // The exceptions thrown by the threads, if any
+        std::vector<std::exception_ptr> errors(nthreads);
+
+        // Process the field points of each thread concurrently
+        std::vector<std::thread> threads;
+        threads.reserve(nthreads);
+        for(Index t = 0; t < nthreads; ++t)
+            threads.emplace_back([&, t]()
+            {
+                try {
+                    apply(t, offsets[t], offsets[t + 1]);
+                } catch(...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+
+        for(std::thread& thread : threads)
+            thread.join();
+
+        // Rethrow the first exception in the calling thread
+        for(const std::exception_ptr& error : errors)
+            if(error) std::rethrow_exception(error);
+    }
+
     /// Equilibrate the chemical state at every field point.
     auto equilibrate(Array<double> T, Array<double> P, Array<double> b) -> void
     {
@@ -170,15 +365,16 @@ struct ChemicalSolver::Impl
             "Expecting, for each equilibrium element, the same number of amount "
             "values as there are field points.");
 
-        for(Index k = 0; k < npoints; ++k)
+        parallel([&](Index t, Index k)
         {
             const auto Tk = T.data[k];
             const auto Pk = P.data[k];
             const auto bk = b.data + k*Ee;
-            equilibriumsolver.solve(states[k], Tk, Pk, bk);
+            equilibriumsolvers[t].solve(states[k], Tk, Pk, bk);
             properties[k] = states[k].properties();
-            sensitivities[k] = equilibriumsolver.sensitivity();
-        }
+            sensitivities[k] = equilibriumsolvers[t].sensitivity();
+        });
+        stale_properties = false;
     }
 
     /// Equilibrate the chemical state at every field point.
@@ -197,27 +393,183 @@ struct ChemicalSolver::Impl
             "Expecting, for each equilibrium element, the same number of amount "
             "values as there are field points.");
 
-        Vector bk(Ee);
-        for(Index k = 0; k < npoints; ++k)
+        // The grid rows are given either as a pointer to pointers or as a vector of pointers
+        const double* const* brows = b.data ? b.data : b.pointers.data();
+
+        parallel([&](Index t, Index k)
         {
+            Vector bk(Ee);
             const auto Tk  = T.data[k];
             const auto Pk  = P.data[k];
             for(Index j = 0; j < Ee; ++j)
-                bk[j] = b.data[j][k];
-            equilibriumsolver.solve(states[k], Tk, Pk, bk);
+                bk[j] = brows[j][k];
+            equilibriumsolvers[t].solve(states[k], Tk, Pk, bk);
             properties[k] = states[k].properties();
-            sensitivities[k] = equilibriumsolver.sensitivity();
-        }
+            sensitivities[k] = equilibriumsolvers[t].sensitivity();
+        });
+        stale_properties = false;
     }
 
     /// React the chemical state at every field point.
     auto react(double t, double dt) -> void
     {
-        for(Index k = 0; k < npoints; ++k)
+        parallel([&](Index i, Index k)
         {
-            kineticsolver.solve(states[k], t, dt);
+            kineticsolvers[i].solve(states[k], t, dt);
             properties[k] = states[k].properties();
+        });
+        stale_properties = false;
+    }
+
+    /// Return the number of doubles in the checkpoint record of each field point.
+    auto checkpointRecordSize() const -> Index
+    {
+        // The record contains T, P, a flag for the sensitivity, n, y, z, dnedT, dnedP, dnedbe
+        return 3 + N + E + N + Ne + Ne + Ne*Ee;
+    }
+
+    /// Write a binary checkpoint of the chemical states at every field point.
+    auto checkpoint(const std::string& filename) const -> void
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+
+        Assert(out.is_open(),
+            "Could not write the checkpoint of the chemical solver.",
+            "The file `" + filename + "` could not be opened for writing.");
+
+        const Index R = checkpointRecordSize();
+
+        CheckpointHeader header;
+        initBinaryHeader(header, checkpoint_magic, checkpoint_version, system, R);
+        header.npoints = npoints;
+        header.Ne = Ne;
+        header.Ee = Ee;
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        // Pack and write the records of the field points in chunks
+        std::vector<double> buffer;
+        for(Index begin = 0; begin < npoints; begin += checkpoint_chunk)
+        {
+            const Index end = std::min(begin + checkpoint_chunk, npoints);
+            buffer.resize((end - begin) * R);
+            double* record = buffer.data();
+            for(Index k = begin; k < end; ++k, record += R)
+            {
+                const KineticState& state = states[k];
+                const EquilibriumSensitivity& sensitivity = sensitivities[k];
+                const bool sensitive = Index(sensitivity.dnedT.size()) == Ne &&
+                    Index(sensitivity.dnedbe.rows()) == Ne && Index(sensitivity.dnedbe.cols()) == Ee;
+
+                double* data = record;
+                *data++ = state.temperature();
+                *data++ = state.pressure();
+                *data++ = sensitive ? 1.0 : 0.0;
+                Vector::Map(data, N) = state.speciesAmounts(); data += N;
+                Vector::Map(data, E) = state.elementDualPotentials(); data += E;
+                Vector::Map(data, N) = state.speciesDualPotentials(); data += N;
+                if(sensitive)
+                {
+                    Vector::Map(data, Ne) = sensitivity.dnedT; data += Ne;
+                    Vector::Map(data, Ne) = sensitivity.dnedP; data += Ne;
+                    Matrix::Map(data, Ne, Ee) = sensitivity.dnedbe;
+                }
+                else std::fill(data, record + R, 0.0);
+            }
+            out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(double));
         }
+
+        Assert(out.good(),
+            "Could not write the checkpoint of the chemical solver.",
+            "An error occurred while writing to file `" + filename + "`.");
+    }
+
+    /// Restore the chemical states at every field point from a binary checkpoint.
+    auto restart(const std::string& filename) -> void
+    {
+        std::ifstream in(filename, std::ios::binary);
+
+        Assert(in.is_open(),
+            "Could not restart the chemical solver.",
+            "The file `" + filename + "` could not be opened for reading.");
+
+        CheckpointHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        Assert(in.good(),
+            "Could not restart the chemical solver.",
+            "The checkpoint file `" + filename + "` is truncated.");
+
+        checkBinaryHeader(header, checkpoint_magic, checkpoint_version, system,
+            "Could not restart the chemical solver.", "The file `" + filename + "`", "a checkpoint of a chemical solver");
+
+        Assert(header.npoints == npoints,
+            "Could not restart the chemical solver.",
+            "Expecting a checkpoint with the same number of field points as the chemical solver.");
+
+        Assert(header.Ne == Ne && header.Ee == Ee,
+            "Could not restart the chemical solver.",
+            "Expecting a checkpoint with the same partition as the chemical solver.");
+
+        const Index R = checkpointRecordSize();
+
+        Assert(header.record == R,
+            "Could not restart the chemical solver.",
+            "The checkpoint file `" + filename + "` has an inconsistent record size.");
+
+        // Read and unpack the records of the field points in chunks
+        std::vector<double> buffer;
+        Vector n(N), y(E), z(N);
+        for(Index begin = 0; begin < npoints; begin += checkpoint_chunk)
+        {
+            const Index end = std::min(begin + checkpoint_chunk, npoints);
+            buffer.resize((end - begin) * R);
+            in.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(double));
+
+            Assert(in.good(),
+                "Could not restart the chemical solver.",
+                "The checkpoint file `" + filename + "` is truncated.");
+
+            const double* record = buffer.data();
+            for(Index k = begin; k < end; ++k, record += R)
+            {
+                KineticState& state = states[k];
+                EquilibriumSensitivity& sensitivity = sensitivities[k];
+
+                const double* data = record;
+                state.setTemperature(data[0]);
+                state.setPressure(data[1]);
+                const bool sensitive = data[2] != 0.0;
+                data += 3;
+                n = Vector::Map(data, N); data += N;
+                y = Vector::Map(data, E); data += E;
+                z = Vector::Map(data, N); data += N;
+                state.setSpeciesAmounts(n);
+                state.setElementDualPotentials(y);
+                state.setSpeciesDualPotentials(z);
+                if(sensitive)
+                {
+                    sensitivity.dnedT = Vector::Map(data, Ne); data += Ne;
+                    sensitivity.dnedP = Vector::Map(data, Ne); data += Ne;
+                    sensitivity.dnedbe = Matrix::Map(data, Ne, Ee);
+                }
+                else sensitivity = EquilibriumSensitivity();
+            }
+        }
+
+        // The chemical properties are only recomputed from the restored states when needed
+        stale_properties = true;
+    }
+
+    /// Recompute the chemical properties at every field point if they are not up-to-date with the chemical states.
+    auto updateProperties() -> void
+    {
+        if(!stale_properties) return;
+        parallel([&](Index t, Index k)
+        {
+            properties[k] = states[k].properties();
+        });
+        stale_properties = false;
     }
 
     /// Update the molar amounts of the chemical components at every field point.
@@ -289,6 +641,9 @@ struct ChemicalSolver::Impl
     /// Update the porosity and their derivatives at every field point.
     auto updatePorosity() -> void
     {
+        // Ensure the chemical properties are up-to-date
+        updateProperties();
+
         // Check if member `porosity` is initialized
         if(!porosity.size())
             porosity = ChemicalField(partition, npoints);
@@ -308,6 +663,9 @@ struct ChemicalSolver::Impl
     /// Get the saturation of each fluid phase at every field point.
     auto updateFluidSaturations() -> void
     {
+        // Ensure the chemical properties are up-to-date
+        updateProperties();
+
         // Check if member `fluid_saturations` is initialized
         if(fluid_saturations.size() != Nfp)
             fluid_saturations.resize(Nfp, ChemicalField(partition, npoints));
@@ -336,6 +694,9 @@ struct ChemicalSolver::Impl
     /// Get the density of each fluid phase at every field point.
     auto updateFluidDensities() -> void
     {
+        // Ensure the chemical properties are up-to-date
+        updateProperties();
+
         // Check if member `fluid_densities` is initialized
         if(fluid_densities.size() != Nfp)
             fluid_densities.resize(Nfp, ChemicalField(partition, npoints));
@@ -361,6 +722,9 @@ struct ChemicalSolver::Impl
     /// Update the volumes of each fluid phase at every field point.
     auto updateFluidVolumes() -> void
     {
+        // Ensure the chemical properties are up-to-date
+        updateProperties();
+
         // Check if member `fluid_volumes` is initialized
         if(fluid_volumes.size() != Nfp)
             fluid_volumes.resize(Nfp, ChemicalField(partition, npoints));
@@ -386,6 +750,9 @@ struct ChemicalSolver::Impl
     /// Update the total volume of the fluid phases at every field point.
     auto updateFluidTotalVolume() -> void
     {
+        // Ensure the chemical properties are up-to-date
+        updateProperties();
+
         // Check if member `fluid_total_volume` is initialized
         if(!fluid_total_volume.size())
             fluid_total_volume = ChemicalField(partition, npoints);
@@ -408,6 +775,9 @@ struct ChemicalSolver::Impl
     /// Update the total volume of the solid phases at every field point.
     auto updateSolidTotalVolume() -> void
     {
+        // Ensure the chemical properties are up-to-date
+        updateProperties();
+
         // Check if member `solid_total_volume` is initialized
         if(!solid_total_volume.size())
             solid_total_volume = ChemicalField(partition, npoints);
@@ -430,6 +800,9 @@ struct ChemicalSolver::Impl
     /// Update the kinetic rates of the chemical components at every field point.
     auto updateComponentRates() -> void
     {
+        // Ensure the chemical properties are up-to-date
+        updateProperties();
+
         // Check if member `rc` is initialized
         if(rc.size() != Nc)
             rc.resize(Nc, ChemicalField(partition, npoints));
@@ -517,10 +890,30 @@ auto ChemicalSolver::setPartition(const Partition& partition) -> void
     pimpl->setPartition(partition);
 }
 
+auto ChemicalSolver::setNumThreads(Index nthreads) -> void
+{
+    pimpl->setNumThreads(nthreads);
+}
+
+auto ChemicalSolver::numThreads() const -> Index
+{
+    return pimpl->nthreads;
+}
+
+auto ChemicalSolver::profile() const -> const Profiler&
+{
+    return pimpl->profile;
+}
+
+auto ChemicalSolver::clearProfile() -> void
+{
+    pimpl->profile.clear();
+}
+
 auto ChemicalSolver::setStates(const KineticState& state) -> void
 {
     for(Index k = 0; k < pimpl->npoints; ++k)
-        pimpl->states[k] = state;
+        pimpl->setStateAt(k, state);
 }
 
 auto ChemicalSolver::setStates(const Array<KineticState>& states) -> void
@@ -529,7 +922,7 @@ auto ChemicalSolver::setStates(const Array<KineticState>& states) -> void
         "Could not set the chemical states at every field point.",
         "Expecting the same number of chemical states as there are field points.");
     for(Index k = 0; k < states.size; ++k)
-        pimpl->states[k] = states.data[k];
+        pimpl->setStateAt(k, states.data[k]);
 }
 
 auto ChemicalSolver::setStateAt(Index ipoint, const KineticState& state) -> void
@@ -537,7 +930,7 @@ auto ChemicalSolver::setStateAt(Index ipoint, const KineticState& state) -> void
     Assert(ipoint < pimpl->npoints,
         "Could not set the chemical state at given field point.",
         "Expecting a field point index smaller than the number of field points.");
-    pimpl->states[ipoint] = state;
+    pimpl->setStateAt(ipoint, state);
 }
 
 auto ChemicalSolver::setStateAt(const Array<Index>& ipoints, const KineticState& state) -> void
@@ -576,6 +969,16 @@ auto ChemicalSolver::react(double t, double dt) -> void
     pimpl->react(t, dt);
 }
 
+auto ChemicalSolver::checkpoint(std::string filename) const -> void
+{
+    pimpl->checkpoint(filename);
+}
+
+auto ChemicalSolver::restart(std::string filename) -> void
+{
+    pimpl->restart(filename);
+}
+
 auto ChemicalSolver::state(Index i) const -> const KineticState&
 {
     return pimpl->states[i];
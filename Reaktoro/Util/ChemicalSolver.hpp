@@ -32,6 +32,7 @@ class ChemicalField;
 class ChemicalSystem;
 class KineticState;
 class Partition;
+class Profiler;
 class ReactionSystem;
 
 /// A type that describes a solver for many chemical calculations.
@@ -70,6 +71,24 @@ public:
     /// Set the partitioning of the chemical system.
     auto setPartition(const Partition& partition) -> void;
 
+    /// Set the number of threads used for the chemical calculations at the field points.
+    /// The field points are distributed in contiguous blocks among the threads, each one
+    /// with its own copy of the chemical system and of the equilibrium and kinetic solvers.
+    /// Chemical systems created from the PHREEQC and GEMS interfaces should use one thread only.
+    /// @param nthreads The number of threads (default: 1)
+    auto setNumThreads(Index nthreads) -> void;
+
+    /// Return the number of threads used for the chemical calculations at the field points.
+    auto numThreads() const -> Index;
+
+    /// Return the counters and timers of the calculations aggregated over all field points and threads.
+    /// The events are only recorded if Reaktoro is compiled with the `ENABLE_PROFILING` option.
+    /// Use Profiler::json to export them.
+    auto profile() const -> const Profiler&;
+
+    /// Clear the aggregated counters and timers of the calculations.
+    auto clearProfile() -> void;
+
     /// Set the chemical state of all field points uniformly.
     /// @param state The state of the chemical system.
     auto setStates(const KineticState& state) -> void;
@@ -102,6 +121,28 @@ public:
     /// React the chemical state at every field point.
     auto react(double t, double dt) -> void;
 
+    /// Write a binary checkpoint of the chemical states at every field point.
+    /// The checkpoint contains, for every field point, the temperature, pressure, molar amounts
+    /// of the species, dual potentials of the elements and species, and the sensitivity of the
+    /// last equilibrium calculation. The file starts with a BinaryHeader (the characters `RKTCHKPT`,
+    /// the format version, a fingerprint of the chemical system, the number of species, elements,
+    /// and doubles per field point), extended with the number of field points, equilibrium species,
+    /// and equilibrium elements. It is followed by one fixed-size record of doubles per field
+    /// point in native byte order.
+    /// Every record is 8-byte aligned, so that the file can also be memory-mapped by other tools.
+    /// @param filename The name of the checkpoint file
+    /// @see restart
+    auto checkpoint(std::string filename) const -> void;
+
+    /// Restore the chemical states at every field point from a binary checkpoint.
+    /// The restored dual potentials allow the next equilibrium calculations to warm-start,
+    /// and the restored sensitivities allow the field quantities (e.g., porosity) to be
+    /// evaluated before any further calculation. The chemical properties at the field points
+    /// are only recomputed from the restored states when a field quantity is first requested.
+    /// @param filename The name of the checkpoint file
+    /// @see checkpoint
+    auto restart(std::string filename) -> void;
+
     /// Return the chemical state at given index.
     auto state(Index i) const -> const KineticState&;
 
@@ -0,0 +1,434 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ChemicalStateArchive.hpp"
+
+// C++ includes
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+// POSIX includes
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumState.hpp>
+#include <Reaktoro/Util/BinaryHeader.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// The header of a binary file of chemical states.
+struct StateArchiveHeader : BinaryHeader
+{
+    /// The flag that indicates if the records contain the dual potentials
+    std::uint64_t duals;
+};
+
+static_assert(sizeof(StateArchiveHeader) == 56, "Expecting a state archive header with seven 64-bit words.");
+
+/// The characters that identify a binary file of chemical states
+const char archive_magic[8] = {'R', 'K', 'T', 'S', 'T', 'A', 'T', 'E'};
+
+/// The current version of the format
+const std::uint64_t archive_version = 2;
+
+/// The number of states buffered before they are written to a file
+const Index archive_chunk = 4096;
+
+/// Return the number of doubles in the record of each state.
+auto recordSize(Index N, Index E, bool duals) -> Index
+{
+    // The record contains T, P, n, and optionally y, z
+    return 2 + N + (duals ? E + N : 0);
+}
+
+/// Return the header of a binary file of chemical states of a chemical system.
+auto archiveHeader(const ChemicalSystem& system, bool duals) -> StateArchiveHeader
+{
+    StateArchiveHeader header;
+    initBinaryHeader(header, archive_magic, archive_version, system,
+        recordSize(system.numSpecies(), system.numElements(), duals));
+    header.duals = duals;
+    return header;
+}
+
+/// Check if a header is compatible with a chemical system.
+auto checkArchiveHeader(const StateArchiveHeader& header, const ChemicalSystem& system, std::string error, std::string source) -> void
+{
+    checkBinaryHeader(header, archive_magic, archive_version, system,
+        error, source, "chemical states in binary format");
+
+    Assert(header.record == recordSize(header.N, header.E, header.duals),
+        error, source + " has an inconsistent record size.");
+}
+
+/// Pack a chemical state into a record.
+auto packRecord(const ChemicalState& state, Index N, Index E, bool duals, double* data) -> void
+{
+    *data++ = state.temperature();
+    *data++ = state.pressure();
+    Vector::Map(data, N) = state.speciesAmounts(); data += N;
+    if(duals)
+    {
+        const EquilibriumState* equilibrium = dynamic_cast<const EquilibriumState*>(&state);
+
+        Assert(equilibrium != nullptr,
+            "Could not write the dual potentials of the chemical state.",
+            "Expecting an EquilibriumState instance.");
+
+        Vector::Map(data, E) = equilibrium->elementDualPotentials(); data += E;
+        Vector::Map(data, N) = equilibrium->speciesDualPotentials();
+    }
+}
+
+/// Unpack a chemical state from a record.
+auto unpackRecord(const double* data, Index N, Index E, bool duals, ChemicalState& state) -> void
+{
+    state.setTemperature(data[0]);
+    state.setPressure(data[1]);
+    data += 2;
+    state.setSpeciesAmounts(Vector::Map(data, N)); data += N;
+    if(duals)
+    {
+        EquilibriumState* equilibrium = dynamic_cast<EquilibriumState*>(&state);
+        if(equilibrium)
+        {
+            equilibrium->setElementDualPotentials(Vector::Map(data, E)); data += E;
+            equilibrium->setSpeciesDualPotentials(Vector::Map(data, N));
+        }
+    }
+}
+
+} // namespace
+
+auto writeBinary(std::ostream& out, const ChemicalState& state) -> void
+{
+    const bool duals = dynamic_cast<const EquilibriumState*>(&state) != nullptr;
+
+    const StateArchiveHeader header = archiveHeader(state.system(), duals);
+
+    std::vector<double> record(header.record);
+    packRecord(state, header.N, header.E, duals, record.data());
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(record.data()), record.size() * sizeof(double));
+
+    Assert(out.good(),
+        "Could not write the chemical state to the binary stream.",
+        "An error occurred while writing to the stream.");
+}
+
+auto readBinary(std::istream& in, ChemicalState& state) -> void
+{
+    StateArchiveHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    Assert(in.good(),
+        "Could not read the chemical state from the binary stream.",
+        "The stream is truncated.");
+
+    checkArchiveHeader(header, state.system(),
+        "Could not read the chemical state from the binary stream.", "The stream");
+
+    std::vector<double> record(header.record);
+    in.read(reinterpret_cast<char*>(record.data()), record.size() * sizeof(double));
+
+    Assert(in.good(),
+        "Could not read the chemical state from the binary stream.",
+        "The stream is truncated.");
+
+    unpackRecord(record.data(), header.N, header.E, header.duals, state);
+}
+
+struct ChemicalStateWriter::Impl
+{
+    /// The name of the binary file
+    std::string filename;
+
+    /// The output stream of the binary file
+    std::ofstream out;
+
+    /// The header of the binary file
+    StateArchiveHeader header;
+
+    /// The number of states already written to the file
+    Index num_written = 0;
+
+    /// The records of the states not yet written to the file
+    std::vector<double> buffer;
+
+    /// Construct a ChemicalStateWriter::Impl instance
+    Impl(std::string filename, const ChemicalSystem& system, bool duals)
+    : filename(filename), header(archiveHeader(system, duals))
+    {
+        const std::string error = "Could not open the file of chemical states for writing.";
+        const std::string source = "The file `" + filename + "`";
+
+        // Check if the file already exists with some content, in which case the new states are appended
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        const std::streamoff size = in.is_open() ? std::streamoff(in.tellg()) : 0;
+
+        if(size > 0)
+        {
+            StateArchiveHeader existing;
+            in.seekg(0);
+            in.read(reinterpret_cast<char*>(&existing), sizeof(existing));
+
+            Assert(in.good(), error, source + " is truncated.");
+
+            checkArchiveHeader(existing, system, error, source);
+
+            Assert(existing.duals == header.duals, error,
+                source + (existing.duals ? " contains" : " does not contain") + " the dual potentials of the states.");
+
+            const std::streamoff bytes = size - sizeof(header);
+            const std::streamoff record_bytes = header.record * sizeof(double);
+
+            Assert(bytes % record_bytes == 0, error, source + " ends with an incomplete record.");
+
+            num_written = bytes/record_bytes;
+
+            in.close();
+            out.open(filename, std::ios::binary | std::ios::app);
+
+            Assert(out.is_open(), error, source + " could not be opened for appending.");
+        }
+        else
+        {
+            in.close();
+            out.open(filename, std::ios::binary | std::ios::trunc);
+
+            Assert(out.is_open(), error, source + " could not be opened for writing.");
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        buffer.reserve(archive_chunk * header.record);
+    }
+
+    /// Append a chemical state to the buffer, writing it to the file when full
+    auto write(const ChemicalState& state) -> void
+    {
+        Assert(Index(state.speciesAmounts().size()) == header.N,
+            "Could not write the chemical state to the file `" + filename + "`.",
+            "Expecting a chemical state with the same chemical system as the file.");
+
+        const Index offset = buffer.size();
+        buffer.resize(offset + header.record);
+        packRecord(state, header.N, header.E, header.duals, buffer.data() + offset);
+
+        if(buffer.size() >= archive_chunk * header.record)
+            flush();
+    }
+
+    /// Write the buffered records to the file
+    auto flush() -> void
+    {
+        out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(double));
+        out.flush();
+
+        Assert(out.good(),
+            "Could not write the chemical states to the file `" + filename + "`.",
+            "An error occurred while writing to the file.");
+
+        num_written += buffer.size()/header.record;
+        buffer.clear();
+    }
+
+    /// Return the number of states in the file, including the buffered ones
+    auto numStates() const -> Index
+    {
+        return num_written + buffer.size()/header.record;
+    }
+};
+
+ChemicalStateWriter::ChemicalStateWriter(std::string filename, const ChemicalSystem& system, bool duals)
+: pimpl(new Impl(filename, system, duals))
+{}
+
+ChemicalStateWriter::~ChemicalStateWriter()
+{
+    // Write the remaining records without raising errors in the destructor
+    pimpl->out.write(reinterpret_cast<const char*>(pimpl->buffer.data()), pimpl->buffer.size() * sizeof(double));
+}
+
+auto ChemicalStateWriter::write(const ChemicalState& state) -> void
+{
+    pimpl->write(state);
+}
+
+auto ChemicalStateWriter::flush() -> void
+{
+    pimpl->flush();
+}
+
+auto ChemicalStateWriter::numStates() const -> Index
+{
+    return pimpl->numStates();
+}
+
+struct ChemicalStateReader::Impl
+{
+    /// The header of the binary file
+    StateArchiveHeader header;
+
+    /// The number of states in the file
+    Index num_states = 0;
+
+    /// The pointer to the first record in the file
+    const double* records = nullptr;
+
+#if defined(_WIN32)
+    /// The contents of the file after its header
+    std::vector<double> contents;
+#else
+    /// The memory-mapped contents of the file, unmapped on destruction
+    std::shared_ptr<const void> mapping;
+#endif
+
+    /// Construct a ChemicalStateReader::Impl instance
+    Impl(std::string filename, const ChemicalSystem& system)
+    {
+        const std::string error = "Could not open the file of chemical states for reading.";
+        const std::string source = "The file `" + filename + "`";
+
+#if defined(_WIN32)
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+
+        Assert(in.is_open(), error, source + " could not be opened for reading.");
+
+        const std::size_t size = std::streamoff(in.tellg());
+
+        Assert(size >= sizeof(header), error, source + " is truncated.");
+
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        contents.resize((size - sizeof(header))/sizeof(double));
+        in.read(reinterpret_cast<char*>(contents.data()), contents.size() * sizeof(double));
+
+        Assert(in.good(), error, "An error occurred while reading " + source + ".");
+
+        records = contents.data();
+#else
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+
+        Assert(fd != -1, error, source + " could not be opened for reading.");
+
+        struct stat info;
+        const bool stated = ::fstat(fd, &info) == 0;
+        const std::size_t size = stated ? info.st_size : 0;
+
+        void* data = size >= sizeof(header) ?
+            ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+
+        ::close(fd);
+
+        Assert(size >= sizeof(header), error, source + " is truncated.");
+
+        Assert(data != MAP_FAILED, error, source + " could not be memory-mapped.");
+
+        mapping.reset(data, [=](const void*) { ::munmap(data, size); });
+
+        std::memcpy(&header, data, sizeof(header));
+
+        records = reinterpret_cast<const double*>(static_cast<const char*>(data) + sizeof(header));
+#endif
+
+        checkArchiveHeader(header, system, error, source);
+
+        // Ignore an incomplete record at the end of a file still being written
+        num_states = (size - sizeof(header))/(header.record * sizeof(double));
+    }
+
+    /// Return the record of the i-th state
+    auto record(Index i) const -> const double*
+    {
+        Assert(i < num_states,
+            "Could not read the chemical state with given index.",
+            "The index " + std::to_string(i) + " is out of range, with " + std::to_string(num_states) + " states in the file.");
+        return records + i * header.record;
+    }
+
+    /// Return the offset of the dual potentials in a record
+    auto dualsOffset() const -> Index
+    {
+        Assert(header.duals,
+            "Could not read the dual potentials of the chemical state.",
+            "The file does not contain the dual potentials of the states.");
+        return 2 + header.N;
+    }
+};
+
+ChemicalStateReader::ChemicalStateReader(std::string filename, const ChemicalSystem& system)
+: pimpl(new Impl(filename, system))
+{}
+
+ChemicalStateReader::~ChemicalStateReader()
+{}
+
+auto ChemicalStateReader::numStates() const -> Index
+{
+    return pimpl->num_states;
+}
+
+auto ChemicalStateReader::hasDualPotentials() const -> bool
+{
+    return pimpl->header.duals;
+}
+
+auto ChemicalStateReader::temperature(Index i) const -> double
+{
+    return pimpl->record(i)[0];
+}
+
+auto ChemicalStateReader::pressure(Index i) const -> double
+{
+    return pimpl->record(i)[1];
+}
+
+auto ChemicalStateReader::speciesAmounts(Index i) const -> Eigen::Map<const Vector>
+{
+    return Eigen::Map<const Vector>(pimpl->record(i) + 2, pimpl->header.N);
+}
+
+auto ChemicalStateReader::elementDualPotentials(Index i) const -> Eigen::Map<const Vector>
+{
+    return Eigen::Map<const Vector>(pimpl->record(i) + pimpl->dualsOffset(), pimpl->header.E);
+}
+
+auto ChemicalStateReader::speciesDualPotentials(Index i) const -> Eigen::Map<const Vector>
+{
+    return Eigen::Map<const Vector>(pimpl->record(i) + pimpl->dualsOffset() + pimpl->header.E, pimpl->header.N);
+}
+
+auto ChemicalStateReader::read(Index i, ChemicalState& state) const -> void
+{
+    unpackRecord(pimpl->record(i), pimpl->header.N, pimpl->header.E, pimpl->header.duals, state);
+}
+
+} // namespace Reaktoro
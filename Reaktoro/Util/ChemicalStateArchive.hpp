@@ -0,0 +1,134 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+#include <Reaktoro/Math/Matrix.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalState;
+class ChemicalSystem;
+
+/// Write a chemical state to a binary stream.
+/// The stream receives a header with a fingerprint of the chemical system followed by
+/// a single record with the temperature, pressure, and molar amounts of the species.
+/// The dual potentials of the elements and species are also written if the state is
+/// an EquilibriumState instance. The data is written in the native byte order.
+/// @param out The binary output stream
+/// @param state The chemical state to be written
+auto writeBinary(std::ostream& out, const ChemicalState& state) -> void;
+
+/// Read a chemical state from a binary stream written with @ref writeBinary.
+/// The chemical system of `state` must be the one used to write the stream, otherwise
+/// an exception is thrown. The dual potentials are read only if they were written and
+/// `state` is an EquilibriumState instance.
+/// @param in The binary input stream
+/// @param state The chemical state to be read
+auto readBinary(std::istream& in, ChemicalState& state) -> void;
+
+/// Used for appending many chemical states of the same chemical system to a binary file.
+/// The file contains a header with a fingerprint of the chemical system, followed by
+/// fixed-size records with the temperature, pressure, molar amounts of the species, and
+/// optionally the dual potentials of the elements and species. The records are buffered
+/// and written in chunks. If the file already exists, its header is checked and new
+/// records are appended to it.
+/// @see ChemicalStateReader
+class ChemicalStateWriter
+{
+public:
+    /// Construct a ChemicalStateWriter instance.
+    /// @param filename The name of the binary file
+    /// @param system The chemical system of the states
+    /// @param duals The flag that indicates if the dual potentials are also written
+    ChemicalStateWriter(std::string filename, const ChemicalSystem& system, bool duals = false);
+
+    /// Destroy this instance, writing all buffered records to the file.
+    virtual ~ChemicalStateWriter();
+
+    /// Append a chemical state to the file.
+    /// If the dual potentials are written, `state` must be an EquilibriumState instance.
+    auto write(const ChemicalState& state) -> void;
+
+    /// Write all buffered records to the file.
+    auto flush() -> void;
+
+    /// Return the number of states in the file, including the buffered ones.
+    auto numStates() const -> Index;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+/// Used for reading chemical states from a binary file written with ChemicalStateWriter.
+/// The file is memory-mapped, so that the temperatures, pressures, molar amounts, and dual
+/// potentials of the states can be accessed without copying them.
+/// @see ChemicalStateWriter
+class ChemicalStateReader
+{
+public:
+    /// Construct a ChemicalStateReader instance.
+    /// An exception is thrown if the file was written with a different chemical system.
+    /// @param filename The name of the binary file
+    /// @param system The chemical system of the states
+    ChemicalStateReader(std::string filename, const ChemicalSystem& system);
+
+    /// Destroy this instance, unmapping the file.
+    virtual ~ChemicalStateReader();
+
+    /// Return the number of states in the file.
+    auto numStates() const -> Index;
+
+    /// Return true if the file contains the dual potentials of the states.
+    auto hasDualPotentials() const -> bool;
+
+    /// Return the temperature of the i-th state (in units of K).
+    auto temperature(Index i) const -> double;
+
+    /// Return the pressure of the i-th state (in units of Pa).
+    auto pressure(Index i) const -> double;
+
+    /// Return a read-only view of the molar amounts of the species of the i-th state (in units of mol).
+    auto speciesAmounts(Index i) const -> Eigen::Map<const Vector>;
+
+    /// Return a read-only view of the dual potentials of the elements of the i-th state (in units of J/mol).
+    auto elementDualPotentials(Index i) const -> Eigen::Map<const Vector>;
+
+    /// Return a read-only view of the dual potentials of the species of the i-th state (in units of J/mol).
+    auto speciesDualPotentials(Index i) const -> Eigen::Map<const Vector>;
+
+    /// Read the i-th state into a ChemicalState instance.
+    /// The dual potentials are also read if they are in the file and `state` is an EquilibriumState instance.
+    auto read(Index i, ChemicalState& state) const -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
@@ -19,3 +19,4 @@
 
 #include <Reaktoro/Util/ChemicalField.hpp>
 #include <Reaktoro/Util/ChemicalSolver.hpp>
+#include <Reaktoro/Util/ChemicalStateArchive.hpp>
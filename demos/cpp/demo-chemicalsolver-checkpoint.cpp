@@ -0,0 +1,79 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    Index npoints = 2000;
+
+    ChemicalEditor editor;
+    editor.addAqueousPhase("H O Na Cl C Ca Mg");
+    editor.addGaseousPhase("H2O(g) CO2(g)");
+    editor.addMineralPhase("Calcite");
+    editor.addMineralPhase("Dolomite");
+
+    ChemicalSystem system(editor);
+
+    EquilibriumCompositionProblem composition(system);
+    composition.setAqueousComposition("1 molal NaCl");
+    composition.setGaseousComposition("CO2");
+    composition.setSolidComposition("0.1 Calcite; 0.9 Dolomite");
+    composition.setAqueousSaturation(0.8);
+    composition.setGaseousSaturation(0.2);
+    composition.setPorosity(0.3);
+
+    EquilibriumState state = equilibrate(composition);
+
+    Index Ee = system.numElements();
+
+    Vector T = constants(npoints, state.temperature());
+    Vector P = constants(npoints, state.pressure());
+    Matrix be(Ee, npoints);
+    be.colwise() = state.elementAmounts();
+
+    // Equilibrate the field from a cold start and write a checkpoint of it
+    ChemicalSolver solver(system, npoints);
+
+    Time begin = time();
+    solver.equilibrate(T, P, be);
+    const double time_cold = elapsed(begin);
+
+    begin = time();
+    solver.checkpoint("checkpoint.bin");
+    const double time_checkpoint = elapsed(begin);
+
+    // Restart another chemical solver from the checkpoint and continue with warm-started calculations
+    ChemicalSolver restarted(system, npoints);
+
+    begin = time();
+    restarted.restart("checkpoint.bin");
+    const double time_restart = elapsed(begin);
+
+    const double maxdiff = (solver.porosity().val() - restarted.porosity().val()).cwiseAbs().maxCoeff();
+
+    begin = time();
+    restarted.equilibrate(T, P, be);
+    const double time_warm = elapsed(begin);
+
+    std::cout << "Time cold-start equilibrium (s): " << time_cold << std::endl;
+    std::cout << "Time checkpoint (s):             " << time_checkpoint << std::endl;
+    std::cout << "Time restart (s):                " << time_restart << std::endl;
+    std::cout << "Time warm-start equilibrium (s): " << time_warm << std::endl;
+    std::cout << "Max difference in porosity after restart: " << maxdiff << std::endl;
+}
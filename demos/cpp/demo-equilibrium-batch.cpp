@@ -0,0 +1,97 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    // Define the chemical system and an equilibrium problem used as template for the batch.
+    Database database("supcrt98.xml");
+
+    ChemicalEditor editor(database);
+    editor.addAqueousPhase("H2O NaCl CO2");
+    editor.addGaseousPhase("H2O(g) CO2(g)");
+    editor.addMineralPhase("Halite");
+
+    ChemicalSystem system(editor);
+
+    EquilibriumProblem problem(system);
+    problem.setTemperature(60, "celsius");
+    problem.setPressure(300, "bar");
+    problem.add("H2O", 1, "kg");
+    problem.add("CO2", 100, "g");
+    problem.add("NaCl", 0.1, "mol");
+
+    // The number of independent equilibrium problems in the batch
+    const Index num_problems = 1000;
+
+    const Index N = system.numSpecies();
+    const Index E = system.numElements();
+
+    // Allocate the structure-of-arrays buffers of the batch (owned by the application).
+    std::vector<double> T(num_problems), P(num_problems), b(num_problems*E);
+    std::vector<double> n(num_problems*N, 0.0), y(num_problems*E, 0.0), z(num_problems*N, 0.0);
+
+    // Vary temperature and pressure across the problems.
+    const Vector b0 = problem.elementAmounts();
+    for(Index k = 0; k < num_problems; ++k)
+    {
+        T[k] = problem.temperature() + 50.0 * k/num_problems;
+        P[k] = problem.pressure() + 100e5 * k/num_problems;
+        Vector::Map(b.data() + k*E, E) = b0;
+    }
+
+    EquilibriumBatch batch;
+    batch.size = num_problems;
+    batch.T = T.data();
+    batch.P = P.data();
+    batch.be = b.data();
+    batch.n = n.data();
+    batch.y = y.data();
+    batch.z = z.data();
+
+    EquilibriumSolver solver(system);
+
+    // Solve the batch from a cold start, and again using the previous results as initial guess.
+    Time begin = time();
+    EquilibriumResult cold = solver.solve(batch);
+    const double time_cold = elapsed(begin);
+
+    begin = time();
+    EquilibriumResult warm = solver.solve(batch);
+    const double time_warm = elapsed(begin);
+
+    // Solve the same problems one state at a time for comparison.
+    std::vector<EquilibriumState> states(num_problems, EquilibriumState(system));
+    begin = time();
+    for(Index k = 0; k < num_problems; ++k)
+        solver.solve(states[k], T[k], P[k], b.data() + k*E);
+    const double time_states = elapsed(begin);
+
+    double maxdiff = 0.0;
+    for(Index k = 0; k < num_problems; ++k)
+        maxdiff = std::max(maxdiff, (states[k].speciesAmounts() - Vector::Map(n.data() + k*N, N)).cwiseAbs().maxCoeff());
+
+    std::cout << "Succeeded (cold, warm): " << cold.optimum.succeeded << ", " << warm.optimum.succeeded << std::endl;
+    std::cout << "Iterations (cold, warm): " << cold.optimum.iterations << ", " << warm.optimum.iterations << std::endl;
+    std::cout << "Time batch cold-start (s): " << time_cold << std::endl;
+    std::cout << "Time batch warm-start (s): " << time_warm << std::endl;
+    std::cout << "Time per-state solve (s):  " << time_states << std::endl;
+    std::cout << "Max difference in species amounts: " << maxdiff << std::endl;
+}
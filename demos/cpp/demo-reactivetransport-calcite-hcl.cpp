@@ -0,0 +1,85 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    ChemicalEditor editor;
+    editor.addAqueousPhase("H2O HCl CaCO3");
+    editor.addMineralPhase("Calcite");
+
+    editor.addMineralReaction("Calcite")
+        .setEquation("Calcite = Ca++ + CO3--")
+        .addMechanism("logk = -5.81 mol/(m2*s); Ea = 23.5 kJ/mol")
+        .addMechanism("logk = -0.30 mol/(m2*s); Ea = 14.4 kJ/mol; a[H+] = 1.0")
+        .setSpecificSurfaceArea(10, "cm2/g");
+
+    ChemicalSystem system(editor);
+    ReactionSystem reactions(editor);
+
+    Partition partition(system);
+    partition.setKineticPhases({"Calcite"});
+
+    EquilibriumProblem problem_ic(system);
+    problem_ic.setPartition(partition);
+    problem_ic.add("H2O", 1, "kg");
+    problem_ic.add("HCl", 1e-6, "mmol");
+
+    EquilibriumProblem problem_bc(system);
+    problem_bc.setPartition(partition);
+    problem_bc.add("H2O", 1, "kg");
+    problem_bc.add("HCl", 1, "mmol");
+
+    KineticState state_ic = equilibrate(problem_ic);
+    KineticState state_bc = equilibrate(problem_bc);
+
+    state_ic.setSpeciesMass("Calcite", 100, "g");
+
+    const Index ncells = 100;
+    const Index nsteps = 50;
+    const double dt = 60.0;
+
+    ReactiveTransportSolver solver(reactions);
+    solver.setMesh(Mesh(ncells, 0.0, 1.0));
+    solver.setVelocity(1.0e-4);
+    solver.setDiffusionCoeff(1.0e-9);
+    solver.setScheme(TransportScheme::FluxLimited);
+    solver.setPartition(partition);
+    solver.setNumThreads(4);
+    solver.setBoundaryState(state_bc);
+    solver.initialize(state_ic);
+
+    double t = 0.0;
+    for(Index i = 0; i < nsteps; ++i, t += dt)
+        solver.step(t, dt);
+
+    const ReactiveTransportResult& result = solver.result();
+
+    std::cout << "Cells:                  " << result.num_cells << std::endl;
+    std::cout << "Steps:                  " << result.num_steps << std::endl;
+    std::cout << "Time transport (s):     " << result.time_transport << std::endl;
+    std::cout << "Time equilibrium (s):   " << result.time_equilibrium << std::endl;
+    std::cout << "Time kinetics (s):      " << result.time_kinetics << std::endl;
+    std::cout << "Throughput (cells*steps/s): " << result.num_cells * result.num_steps / result.time << std::endl;
+
+    const Index icalcite = system.indexSpecies("Calcite");
+    for(Index k = 0; k < ncells; k += 10)
+        std::cout << "Calcite amount at cell " << k << " (mol): "
+                  << solver.chemicalSolver().state(k).speciesAmount(icalcite) << std::endl;
+}
@@ -0,0 +1,51 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2015 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    // The number of conversions performed in each benchmark
+    const Index num_calls = 1000000;
+
+    // The first call with a pair of units parses both strings and compiles the conversion
+    Time begin = time();
+    double value = units::convert(1.0, "mmol/(kg*s)", "mol/(g*hour)");
+    const double time_first = elapsed(begin);
+
+    // Subsequent calls with the same pair of units only look up the compiled conversion
+    begin = time();
+    for(Index i = 0; i < num_calls; ++i)
+        value += units::convert(1.0, "mmol/(kg*s)", "mol/(g*hour)");
+    const double time_string = elapsed(begin)/num_calls;
+
+    // The compiled conversion can also be kept and applied directly
+    const units::Conversion& conversion = units::conversion("mmol/(kg*s)", "mol/(g*hour)");
+    begin = time();
+    for(Index i = 0; i < num_calls; ++i)
+        value += conversion(1.0);
+    const double time_compiled = elapsed(begin)/num_calls;
+
+    std::cout << "Conversions: 25 celsius = " << units::convert(25.0, "celsius", "K") << " K, "
+              << "212 degF = " << units::convert(212.0, "degF", "degC") << " degC, "
+              << "1 mmol/(kg*s) = " << conversion(1.0) << " mol/(g*hour)" << std::endl;
+    std::cout << "Time of the first convert call (s):       " << time_first << std::endl;
+    std::cout << "Time per cached convert call (s):         " << time_string << std::endl;
+    std::cout << "Time per compiled conversion call (s):    " << time_compiled << std::endl;
+    std::cout << "Checksum: " << value << std::endl;
+}
@@ -387,6 +387,7 @@ def processPlots(plotnodes, plots):
         legendposition = plotnode.get('legendposition')
         showlegend = plotnode.get('showlegend')
         frequency = plotnode.get('frequency')
+        maxpoints = plotnode.get('maxpoints')
         
         # Assert both `x` and `y` entries were provided
         assert x is not None, 'Expecting a `x` statement for the plot.'
@@ -415,6 +416,7 @@ def processPlots(plotnodes, plots):
         if legendposition is not None: plot.legend(legendposition)
         if showlegend is not None: plot.showlegend(showlegend)
         if frequency is not None: plot.frequency(frequency)
+        if maxpoints is not None: plot.maxpoints(maxpoints)
         
         xtics = plotnode.get('xtics')
         ytics = plotnode.get('ytics')
@@ -24,6 +24,9 @@ namespace py = boost::python;
 // Reaktoro includes
 #include <Reaktoro/Math/Matrix.hpp>
 
+// PyReaktoro includes
+#include <PyReaktoro/Common/PyConverters.hpp>
+
 namespace Reaktoro {
 
 auto export_Matrix() -> void
@@ -33,6 +36,9 @@ auto export_Matrix() -> void
 
 	// Export the typedef Matrix = MatrixXd
 	py::scope().attr("Matrix") = py::scope().attr("MatrixXd");
+
+	// Export the type std::vector<Vector>
+	export_std_vector<Vector>("VectorVector");
 }
 
 } // namespace Reaktoro
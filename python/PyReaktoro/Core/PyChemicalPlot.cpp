@@ -69,6 +69,7 @@ auto export_ChemicalPlot() -> void
         .def("xlogscale", &ChemicalPlot::xlogscale)
         .def("ylogscale", &ChemicalPlot::ylogscale)
         .def("frequency", &ChemicalPlot::frequency)
+        .def("maxpoints", &ChemicalPlot::maxpoints)
         .def("__lshift__", lshift, py::return_internal_reference<>())
         .def("open", &ChemicalPlot::open)
         .def("update", &ChemicalPlot::update)
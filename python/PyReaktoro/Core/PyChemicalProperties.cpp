@@ -26,18 +26,29 @@ namespace py = boost::python;
 #include <Reaktoro/Core/ChemicalPropertiesAqueousPhase.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 
+// PyReaktoro includes
+#include <PyReaktoro/Common/PyConverters.hpp>
+
 namespace Reaktoro {
 
+/// Dummy comparison to satisfy requirements of Boost.Python std::vector wrapper
+auto operator==(const ChemicalProperties& lhs, const ChemicalProperties& rhs) -> bool
+{
+    return lhs.temperature() == rhs.temperature() && lhs.pressure() == rhs.pressure();
+}
+
 auto export_ChemicalProperties() -> void
 {
     auto update1 = static_cast<void (ChemicalProperties::*)(double, double)>(&ChemicalProperties::update);
-    auto update2 = static_cast<void (ChemicalProperties::*)(double, double, const Vector&)>(&ChemicalProperties::update);
+    auto update2 = static_cast<void (ChemicalProperties::*)(const Vector&)>(&ChemicalProperties::update);
+    auto update3 = static_cast<void (ChemicalProperties::*)(double, double, const Vector&)>(&ChemicalProperties::update);
 
     py::class_<ChemicalProperties>("ChemicalProperties")
         .def(py::init<>())
         .def(py::init<const ChemicalSystem&>())
         .def("update", update1)
         .def("update", update2)
+        .def("update", update3)
         .def("temperature", &ChemicalProperties::temperature)
         .def("pressure", &ChemicalProperties::pressure)
         .def("composition", &ChemicalProperties::composition, py::return_internal_reference<>())
@@ -80,6 +91,8 @@ auto export_ChemicalProperties() -> void
         .def("solidVolume", &ChemicalProperties::solidVolume)
         .def("aqueous", &ChemicalProperties::aqueous)
         ;
+
+    export_std_vector<ChemicalProperties>("ChemicalPropertiesVector");
 }
 
 } // namespace Reaktoro
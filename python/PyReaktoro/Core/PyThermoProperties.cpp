@@ -25,8 +25,17 @@ namespace py = boost::python;
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 #include <Reaktoro/Core/ThermoProperties.hpp>
 
+// PyReaktoro includes
+#include <PyReaktoro/Common/PyConverters.hpp>
+
 namespace Reaktoro {
 
+/// Dummy comparison to satisfy requirements of Boost.Python std::vector wrapper
+auto operator==(const ThermoProperties& lhs, const ThermoProperties& rhs) -> bool
+{
+    return lhs.temperature() == rhs.temperature() && lhs.pressure() == rhs.pressure();
+}
+
 auto export_ThermoProperties() -> void
 {
     py::class_<ThermoProperties>("ThermoProperties")
@@ -44,6 +53,8 @@ auto export_ThermoProperties() -> void
         .def("standardPartialMolarHeatCapacitiesConstP", &ThermoProperties::standardPartialMolarHeatCapacitiesConstP)
         .def("standardPartialMolarHeatCapacitiesConstV", &ThermoProperties::standardPartialMolarHeatCapacitiesConstV)
         ;
+
+    export_std_vector<ThermoProperties>("ThermoPropertiesVector");
 }
 
 } // namespace Reaktoro
@@ -35,11 +35,17 @@ auto export_EquilibriumOptions() -> void
         .value("ApproximationDiagonal", GibbsHessian::ApproximationDiagonal)
         ;
 
+    py::enum_<InverseMethod>("InverseMethod")
+        .value("Nested", InverseMethod::Nested)
+        .value("Monolithic", InverseMethod::Monolithic)
+        ;
+
     py::class_<EquilibriumOptions>("EquilibriumOptions")
         .def_readwrite("epsilon", &EquilibriumOptions::epsilon)
         .def_readwrite("warmstart", &EquilibriumOptions::warmstart)
         .def_readwrite("hessian", &EquilibriumOptions::hessian)
         .def_readwrite("method", &EquilibriumOptions::method)
+        .def_readwrite("inverse", &EquilibriumOptions::inverse)
         .def_readwrite("optimum", &EquilibriumOptions::optimum)
         .def_readwrite("nonlinear", &EquilibriumOptions::nonlinear)
         ;
@@ -22,7 +22,11 @@
 namespace py = boost::python;
 
 // Reaktoro includes
+#include <Reaktoro/Core/ChemicalProperties.hpp>
+#include <Reaktoro/Core/ThermoProperties.hpp>
 #include <Reaktoro/Interfaces/Gems.hpp>
+#include <Reaktoro/Thermodynamics/Models/PhaseChemicalModel.hpp>
+#include <Reaktoro/Thermodynamics/Models/PhaseThermoModel.hpp>
 
 namespace Reaktoro {
 
@@ -32,10 +36,21 @@ auto export_Gems() -> void
         .def_readwrite("warmstart", &GemsOptions::warmstart)
         ;
 
+    auto properties1 = static_cast<PhaseThermoModelResult(Gems::*)(Index, double, double)>(&Gems::properties);
+    auto properties2 = static_cast<PhaseChemicalModelResult(Gems::*)(Index, double, double, const Vector&)>(&Gems::properties);
+    auto properties3 = static_cast<std::vector<ThermoProperties>(Gems::*)(const std::vector<double>&, const std::vector<double>&)>(&Gems::properties);
+    auto properties4 = static_cast<std::vector<ChemicalProperties>(Gems::*)(const std::vector<double>&, const std::vector<double>&, const std::vector<Vector>&)>(&Gems::properties);
+
     py::class_<Gems, py::bases<Interface>>("Gems")
         .def(py::init<>())
         .def(py::init<std::string>())
         .def("setOptions", &Gems::setOptions)
+        .def("setNumThreads", &Gems::setNumThreads)
+        .def("numThreads", &Gems::numThreads)
+        .def("properties", properties1)
+        .def("properties", properties2)
+        .def("properties", properties3)
+        .def("properties", properties4)
         .def("equilibrate", &Gems::equilibrate)
         .def("converged", &Gems::converged)
         .def("numIterations", &Gems::numIterations)
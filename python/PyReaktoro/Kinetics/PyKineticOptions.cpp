@@ -31,10 +31,19 @@ auto export_KineticOptions() -> void
     py::class_<KineticOutputOptions>("KineticOutputOptions")
         .def_readwrite("active", &KineticOutputOptions::active)
         .def_readwrite("format", &KineticOutputOptions::format)
+        .def_readwrite("interval", &KineticOutputOptions::interval)
+        .def_readwrite("tolerance", &KineticOutputOptions::tolerance)
+        .def_readwrite("events", &KineticOutputOptions::events)
+        ;
+
+    py::enum_<KineticMethod>("KineticMethod")
+        .value("Nested", KineticMethod::Nested)
+        .value("DAE", KineticMethod::DAE)
         ;
 
     py::class_<KineticOptions>("KineticOptions")
         .def_readwrite("equilibrium", &KineticOptions::equilibrium)
+        .def_readwrite("method", &KineticOptions::method)
         .def_readwrite("ode", &KineticOptions::ode)
         .def_readwrite("output", &KineticOptions::output)
         ;
@@ -195,6 +195,8 @@ auto export_ChemicalSolver() -> void
         .def("numKineticSpecies", &ChemicalSolver::numKineticSpecies)
         .def("numComponents", &ChemicalSolver::numComponents)
         .def("setPartition", &ChemicalSolver::setPartition)
+        .def("setNumThreads", &ChemicalSolver::setNumThreads)
+        .def("numThreads", &ChemicalSolver::numThreads)
         .def("setStates", PyChemicalSolver::setStates)
         .def("setStateAt", PyChemicalSolver::setStateAt)
         .def("equilibrate", PyChemicalSolver::equilibrate)
@@ -68,6 +68,56 @@ TEST_CASE("Electrolyte Solution: NaCl")
     CHECK(ln_g[4] == approx(ln_g_expected[4]));
 }
 
+TEST_CASE("Electrolyte Solution: NaCl with zero ion size parameter")
+{
+    // Set the ion size parameter of Na+ to zero, which is treated as a special case in the
+    // sigma function of the Debye-Huckel model, and place Na+ after an ion with non-zero size
+    DebyeHuckelParams params;
+    params.aion("Na+", 0.0);
+
+    ChemicalEditor editor(db);
+    editor.addAqueousPhase("H2O(l) H+ OH- Na+ Cl-")
+        .setChemicalModelDebyeHuckel(params);
+
+    ChemicalSystem system(editor);
+
+    const double T = 298.15;
+    const double P = 1e5;
+
+    Vector n(5);
+    n << 1.0/waterMolarMass, 1.0e-3, 1.0e-3, 0.5, 0.5;
+
+    const ChemicalVector ln_a = system.properties(T, P, n).lnActivities();
+
+    // Compare the molar derivatives of the ln activities with central finite differences
+    for(Index j = 0; j < 5; ++j)
+    {
+        const double h = 1e-6 * n[j];
+
+        Vector nplus = n, nminus = n;
+        nplus[j] += h;
+        nminus[j] -= h;
+
+        const Vector ln_a_plus = system.properties(T, P, nplus).lnActivities().val;
+        const Vector ln_a_minus = system.properties(T, P, nminus).lnActivities().val;
+
+        const Vector fd = (ln_a_plus - ln_a_minus)/(2*h);
+
+        for(Index i = 0; i < 5; ++i)
+            CHECK(ln_a.ddn(i, j) == approx(fd[i]).epsilon(1e-5));
+    }
+
+    // The ln activity coefficient of Na+ does not depend on the Debye-Huckel parameter B
+    const double I = 0.501;
+    const double A = 0.51137763214615395;
+    const double bNa = 0.082;
+    const double ln10 = std::log(10.0);
+
+    const Vector ln_g = system.properties(T, P, n).lnActivityCoefficients().val;
+
+    CHECK(ln_g[3] == approx(ln10 * (-A*std::sqrt(I) + bNa*I)));
+}
+
 //TEST_CASE("Electrolyte Solution: KCl")
 //{
 //    DebyeHuckelParams db;
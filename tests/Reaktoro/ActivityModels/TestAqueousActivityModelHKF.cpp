@@ -0,0 +1,83 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("HKF model with zero ionic strength")
+{
+    Database db("supcrt98");
+
+    ChemicalEditor editor(db);
+    editor.addAqueousPhase("H2O(l) H+ OH- Na+ Cl- CO2(aq)")
+        .setChemicalModelHKF();
+
+    ChemicalSystem system(editor);
+
+    const double T = 298.15;
+    const double P = 1e5;
+
+    const Index iwater = system.indexSpecies("H2O(l)");
+
+    SUBCASE("Pure water")
+    {
+        Vector n = zeros(6);
+        n[iwater] = 1.0/waterMolarMass;
+
+        ChemicalProperties properties = system.properties(T, P, n);
+
+        const ChemicalVector ln_g = properties.lnActivityCoefficients();
+        const ChemicalVector ln_a = properties.lnActivities();
+
+        CHECK(ln_g.val.allFinite());
+        CHECK(ln_g.ddT.allFinite());
+        CHECK(ln_g.ddP.allFinite());
+        CHECK(ln_g.ddn.allFinite());
+        CHECK(ln_a.val[iwater] == approx(0.0));
+        CHECK(ln_a.ddn.row(iwater).allFinite());
+    }
+
+    SUBCASE("Water with only a neutral solute")
+    {
+        Vector n = zeros(6);
+        n[iwater] = 1.0/waterMolarMass;
+        n[system.indexSpecies("CO2(aq)")] = 0.1;
+
+        ChemicalProperties properties = system.properties(T, P, n);
+
+        const ChemicalVector ln_g = properties.lnActivityCoefficients();
+        const ChemicalVector ln_a = properties.lnActivities();
+
+        CHECK(ln_g.val.allFinite());
+        CHECK(ln_g.ddT.allFinite());
+        CHECK(ln_g.ddP.allFinite());
+        CHECK(ln_g.ddn.allFinite());
+        CHECK(std::isfinite(ln_a.val[iwater]));
+        CHECK(std::isfinite(ln_a.ddT[iwater]));
+        CHECK(std::isfinite(ln_a.ddP[iwater]));
+        CHECK(ln_a.ddn.row(iwater).allFinite());
+
+        // The ions have zero activity coefficients in the molality scale, apart from the water term
+        const double ln_xw = std::log(n[iwater]/n.sum());
+        CHECK(ln_g.val[system.indexSpecies("Na+")] == approx(0.0));
+        CHECK(ln_g.val[system.indexSpecies("Cl-")] == approx(0.0));
+        CHECK(ln_g.val[iwater] == approx(ln_a.val[iwater] - ln_xw));
+    }
+}
@@ -0,0 +1,126 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <type_traits>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+const int N = 4;
+
+/// Return the mole amounts of the species together with their temperature and pressure derivatives.
+template<typename V, typename M>
+auto amounts() -> ChemicalVectorBase<V,V,V,M>
+{
+    V val(N), ddT(N), ddP(N);
+    val << 0.5, 1.5, 2.0, 0.25;
+    ddT << 0.1, -0.2, 0.3, 0.05;
+    ddP << -0.01, 0.02, 0.0, 0.03;
+    M ddn = M::Identity(N, N);
+    return {val, ddT, ddP, ddn};
+}
+
+/// Check that a fixed-size chemical scalar is equal to its dynamic counterpart.
+template<typename VF, typename NF>
+auto checkEqual(const ChemicalScalarBase<VF,NF>& fixed, const ChemicalScalar& dynamic) -> void
+{
+    CHECK(fixed.val == approx(dynamic.val));
+    CHECK(fixed.ddT == approx(dynamic.ddT));
+    CHECK(fixed.ddP == approx(dynamic.ddP));
+    for(int j = 0; j < N; ++j)
+        CHECK(fixed.ddn[j] == approx(dynamic.ddn[j]));
+}
+
+/// Check that a fixed-size chemical vector is equal to its dynamic counterpart.
+template<typename VF, typename TF, typename PF, typename NF>
+auto checkEqual(const ChemicalVectorBase<VF,TF,PF,NF>& fixed, const ChemicalVector& dynamic) -> void
+{
+    for(int i = 0; i < N; ++i)
+    {
+        CHECK(fixed.val[i] == approx(dynamic.val[i]));
+        CHECK(fixed.ddT[i] == approx(dynamic.ddT[i]));
+        CHECK(fixed.ddP[i] == approx(dynamic.ddP[i]));
+        for(int j = 0; j < N; ++j)
+            CHECK(fixed.ddn(i, j) == approx(dynamic.ddn(i, j)));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Fixed-size chemical scalars agree with dynamic ones")
+{
+    const ChemicalVectorFixed<N,N> nf = amounts<VectorFixed<N>, MatrixFixed<N,N>>();
+    const ChemicalVector nd = amounts<Vector, Matrix>();
+
+    const ChemicalScalarFixed<N> sf = sum(nf);
+    const ChemicalScalar sd = sum(nd);
+
+    checkEqual(sf, sd);
+    CHECK(sf.val == approx(4.25));
+    CHECK(sf.ddT == approx(0.25));
+    for(int j = 0; j < N; ++j)
+        CHECK(sf.ddn[j] == approx(1.0));
+
+    const ChemicalScalarFixed<N> rf = log(sf) * sf + sqrt(sf) / sf - exp(sf / 10.0) + pow(sf, 1.5);
+    const ChemicalScalar rd = log(sd) * sd + sqrt(sd) / sd - exp(sd / 10.0) + pow(sd, 1.5);
+
+    checkEqual(rf, rd);
+}
+
+TEST_CASE("Fixed-size chemical vectors agree with dynamic ones")
+{
+    const ChemicalVectorFixed<N,N> nf = amounts<VectorFixed<N>, MatrixFixed<N,N>>();
+    const ChemicalVector nd = amounts<Vector, Matrix>();
+
+    SUBCASE("Mole fractions and their logarithms")
+    {
+        const ChemicalVectorFixed<N,N> xf = nf / sum(nf);
+        const ChemicalVector xd = nd / sum(nd);
+        checkEqual(xf, xd);
+
+        // The mole derivatives of the mole fractions are (delta_ij - x_i)/sum(n)
+        for(int i = 0; i < N; ++i)
+            for(int j = 0; j < N; ++j)
+                CHECK(xf.ddn(i, j) == approx(((i == j) - xf.val[i])/4.25));
+
+        checkEqual(log(xf) + nf, log(xd) + nd);
+    }
+
+    SUBCASE("Element-wise functions")
+    {
+        checkEqual(abs(log(nf)), abs(log(nd)));
+        checkEqual(sqrt(nf), sqrt(nd));
+        checkEqual(exp(nf), exp(nd));
+        checkEqual(log(nf), log(nd));
+        checkEqual(nf % nf / exp(nf), nd % nd / exp(nd));
+        checkEqual(sum(nf % log(nf)), sum(nd % log(nd)));
+    }
+
+    SUBCASE("Element-wise functions preserve the fixed-size storage")
+    {
+        static_assert(std::is_same<decltype(log(nf)), ChemicalVectorFixed<N,N>>::value, "");
+        static_assert(std::is_same<decltype(exp(nf)), ChemicalVectorFixed<N,N>>::value, "");
+        static_assert(std::is_same<decltype(nf / sum(nf)), ChemicalVectorFixed<N,N>>::value, "");
+        static_assert(std::is_same<decltype(nd / sum(nd)), ChemicalVector>::value, "");
+    }
+}
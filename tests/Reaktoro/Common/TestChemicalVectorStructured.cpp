@@ -0,0 +1,143 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// Check that two chemical scalars have the same values and derivatives.
+auto checkEqual(const ChemicalScalar& actual, const ChemicalScalar& expected) -> void
+{
+    CHECK(actual.val == approx(expected.val));
+    CHECK(actual.ddT == approx(expected.ddT));
+    CHECK(actual.ddP == approx(expected.ddP));
+    REQUIRE(actual.ddn.size() == expected.ddn.size());
+    for(Index j = 0; j < expected.ddn.size(); ++j)
+        CHECK(actual.ddn[j] == approx(expected.ddn[j]));
+}
+
+/// Check that two chemical vectors have the same values and derivatives.
+auto checkEqual(const ChemicalVector& actual, const ChemicalVector& expected) -> void
+{
+    REQUIRE(actual.val.size() == expected.val.size());
+    REQUIRE(actual.ddn.cols() == expected.ddn.cols());
+    for(Index i = 0; i < expected.val.size(); ++i)
+    {
+        CHECK(actual.val[i] == approx(expected.val[i]));
+        CHECK(actual.ddT[i] == approx(expected.ddT[i]));
+        CHECK(actual.ddP[i] == approx(expected.ddP[i]));
+        for(Index j = 0; j < expected.ddn.cols(); ++j)
+            CHECK(actual.ddn(i, j) == approx(expected.ddn(i, j)));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Structured molar fractions agree with dense ones")
+{
+    Vector n(4);
+    n << 55.5, 0.5, 0.25, 1.0e-6;
+
+    const ChemicalVectorStructured xs = molarFractions(n);
+
+    // The molar fractions computed with the generic dense quotient of chemical vectors
+    const ChemicalVector nc = composition(n);
+    const ChemicalVector xd = nc/sum(nc);
+
+    SUBCASE("Densified molar fractions")
+    {
+        checkEqual(ChemicalVector(xs), xd);
+    }
+
+    SUBCASE("Rows of the molar fractions")
+    {
+        for(Index i = 0; i < n.size(); ++i)
+            checkEqual(xs[i], xd[i]);
+    }
+
+    SUBCASE("Dot products with constant weights and thermo vectors")
+    {
+        Vector w(4);
+        w << 1.0, -2.0, 3.0, 4.0;
+        ChemicalScalar wx(4);
+        wx.val = dot(w, xd.val);
+        wx.ddn = tr(xd.ddn) * w;
+        checkEqual(dot(w, xs), wx);
+
+        ThermoVector t(4);
+        t.val << -237.0, -261.0, -131.0, -386.0;
+        t.ddT << 0.1, 0.2, -0.3, 0.4;
+        t.ddP << 1e-5, 2e-5, 3e-5, -4e-5;
+        checkEqual(dot(t, xs), sum(xd % t));
+    }
+
+    SUBCASE("Single species and empty phases")
+    {
+        const ChemicalVector x1(molarFractions(Vector(ones(1))));
+        CHECK(x1.val[0] == 1.0);
+        CHECK(x1.ddn(0, 0) == 0.0);
+
+        const ChemicalVector x0(molarFractions(Vector(zeros(3))));
+        CHECK(x0.val.isZero());
+        CHECK(x0.ddn.isZero());
+    }
+}
+
+TEST_CASE("Structured molalities agree with dense ones")
+{
+    const Database db("supcrt98");
+
+    std::vector<AqueousSpecies> species;
+    for(auto name : {"H2O(l)", "H+", "OH-", "Na+", "Cl-", "NaCl(aq)", "Ca++", "CaCl+", "CO2(aq)"})
+        species.push_back(db.aqueousSpecies(name));
+
+    const AqueousMixture mixture(species);
+
+    Vector n(9);
+    n << 55.0, 1e-7, 1e-7, 0.4, 0.5, 0.1, 0.02, 0.05, 0.3;
+
+    const AqueousMixtureState state = mixture.state(298.15, 1e5, n);
+
+    // The molalities computed with the generic dense quotient of chemical vectors
+    const Index iwater = mixture.indexWater();
+    const ChemicalVector nc = composition(n);
+    const ChemicalScalar kgH2O = nc[iwater] * waterMolarMass;
+    const ChemicalVector md = nc/kgH2O;
+
+    SUBCASE("Molalities")
+    {
+        checkEqual(ChemicalVector(mixture.molalities(n)), md);
+        checkEqual(state.m, md);
+    }
+
+    SUBCASE("Molar fractions")
+    {
+        checkEqual(state.x, nc/sum(nc));
+    }
+
+    SUBCASE("Stoichiometric molalities and ionic strengths")
+    {
+        const ChemicalVector msd = mixture.stoichiometricMolalities(md);
+        checkEqual(state.ms, msd);
+        checkEqual(state.Ie, mixture.effectiveIonicStrength(md));
+        checkEqual(state.Is, mixture.stoichiometricIonicStrength(msd));
+    }
+}
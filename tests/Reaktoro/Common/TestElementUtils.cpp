@@ -0,0 +1,84 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <map>
+#include <string>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+using Elements = std::map<std::string, double>;
+
+TEST_CASE("Formulas of hydrated minerals")
+{
+    // A dot followed by a number scales the rest of the formula
+    CHECK((elements("CaSO4.2H2O") == Elements{{"Ca", 1}, {"H", 4}, {"O", 6}, {"S", 1}}));
+    CHECK((elements("MgSO4.7H2O") == Elements{{"H", 14}, {"Mg", 1}, {"O", 11}, {"S", 1}}));
+    CHECK((elements("Ca(HCO3)2.(H2O)2") == Elements{{"C", 2}, {"Ca", 1}, {"H", 6}, {"O", 8}}));
+
+    // Other separators are skipped together with the number that follows them
+    CHECK((elements("CaSO4*2H2O") == Elements{{"Ca", 1}, {"H", 2}, {"O", 5}, {"S", 1}}));
+    CHECK((elements("CaSO4·2H2O") == Elements{{"Ca", 1}, {"H", 2}, {"O", 5}, {"S", 1}}));
+}
+
+TEST_CASE("Formulas with nested parentheses")
+{
+    CHECK((elements("Ca5(PO4)3(OH)") == Elements{{"Ca", 5}, {"H", 1}, {"O", 13}, {"P", 3}}));
+    CHECK((elements("K(Al(Si3O8))2") == Elements{{"Al", 2}, {"K", 1}, {"O", 16}, {"Si", 6}}));
+    CHECK((elements("Fe((OH)2)3") == Elements{{"Fe", 1}, {"H", 6}, {"O", 6}}));
+    CHECK((elements("Al(OH)4-") == Elements{{"Al", 1}, {"H", 4}, {"O", 4}}));
+}
+
+TEST_CASE("Formulas with charges and phase suffixes")
+{
+    CHECK((elements("HCO3-") == Elements{{"C", 1}, {"H", 1}, {"O", 3}}));
+    CHECK((elements("Ca++") == Elements{{"Ca", 1}}));
+    CHECK((elements("Fe+3") == Elements{{"Fe", 1}}));
+    CHECK((elements("SO4-2") == Elements{{"O", 4}, {"S", 1}}));
+    CHECK((elements("NH4+") == Elements{{"H", 4}, {"N", 1}}));
+    CHECK((elements("CO2(aq)") == Elements{{"C", 1}, {"O", 2}}));
+    CHECK((elements("H2O(l)") == Elements{{"H", 2}, {"O", 1}}));
+
+    CHECK((charge("Na+") == 1));
+    CHECK((charge("Fe+3") == 3));
+    CHECK((charge("SO4-2") == -2));
+    CHECK((charge("H2O(l)") == 0));
+}
+
+TEST_CASE("Formulas with unknown elements")
+{
+    CHECK((elements("Xx2O") == Elements{{"O", 1}, {"Xx", 2}}));
+    CHECK_THROWS(molarMass("Xx2O"));
+}
+
+TEST_CASE("Formulas with unmatched parentheses")
+{
+    CHECK_THROWS(elements("Ca(OH"));
+    CHECK_THROWS(elements("Ca(OH)2("));
+    CHECK_THROWS(elements("((H2O"));
+}
+
+TEST_CASE("Molar mass of a hydrated mineral")
+{
+    const double mm = molarMass("Ca") + molarMass("S") + 6*molarMass("O") + 4*molarMass("H");
+    CHECK(molarMass("CaSO4.2H2O") == approx(mm));
+    CHECK(molarMass("CaSO4.2H2O") == approx(0.17217).epsilon(1e-4));
+}
@@ -0,0 +1,71 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Memoized functions")
+{
+    std::atomic<int> calls(0);
+
+    std::function<double(double, double)> f = [&](double T, double P) { ++calls; return T + P; };
+    std::function<double(double, double)> g = [&](double T, double P) { ++calls; return T * P; };
+
+    const auto fm = memoize(f);
+    const auto gm = memoize(g);
+
+    SUBCASE("Functions with the same signature have independent caches")
+    {
+        CHECK(fm(2.0, 3.0) == 5.0);
+        CHECK(gm(2.0, 3.0) == 6.0);
+        CHECK(fm(2.0, 3.0) == 5.0);
+        CHECK(gm(2.0, 3.0) == 6.0);
+        CHECK(calls == 2);
+    }
+
+    SUBCASE("Every thread evaluates a memoized function at most once per argument")
+    {
+        const int nthreads = 4;
+        const int nargs = 100;
+
+        // The assertions are not checked inside the threads, since doctest is not thread-safe
+        std::atomic<int> wrong(0);
+
+        std::vector<std::thread> threads;
+        for(int t = 0; t < nthreads; ++t)
+            threads.emplace_back([&]()
+            {
+                for(int repeat = 0; repeat < 3; ++repeat)
+                    for(int i = 0; i < nargs; ++i)
+                        if(fm(i, 1.0) != i + 1.0) ++wrong;
+            });
+
+        for(auto& thread : threads)
+            thread.join();
+
+        CHECK(wrong == 0);
+        CHECK(calls == nthreads * nargs);
+    }
+}
@@ -0,0 +1,130 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// Enable the profiling macros in this test, even if Reaktoro is compiled without them
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING
+#endif
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <chrono>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// The wall time spent in each profiled scope (in units of s)
+const double sleep_time = 0.01;
+
+/// Sleep for the given wall time, as a function with a profiled scope.
+auto sleepProfiled(double seconds) -> void
+{
+    ProfileScope("sleep");
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+}
+
+} // namespace
+
+TEST_CASE("Profiler counters and scope timings")
+{
+    profiler().clear();
+
+    SUBCASE("Counters")
+    {
+        ProfileCount("iterations", 3);
+        ProfileCount("iterations", 4);
+        ProfileCount("backtrack", 1);
+
+        CHECK(profiler().entry("iterations").count == 7);
+        CHECK(profiler().entry("iterations").time == 0.0);
+        CHECK(profiler().entry("backtrack").count == 1);
+        CHECK(profiler().entries().size() == 2);
+    }
+
+    SUBCASE("Events that were not recorded")
+    {
+        CHECK(profiler().entry("unknown").count == 0);
+        CHECK(profiler().entry("unknown").time == 0.0);
+        CHECK(profiler().entries().empty());
+        CHECK(profiler().json() == "{}");
+    }
+
+    SUBCASE("Scope timings")
+    {
+        sleepProfiled(sleep_time);
+        sleepProfiled(sleep_time);
+
+        const ProfilingEntry entry = profiler().entry("sleep");
+        CHECK(entry.count == 2);
+        CHECK(entry.time >= 2*sleep_time);
+    }
+
+    SUBCASE("Scope timings in conditional statements")
+    {
+        for(int i = 0; i < 4; ++i)
+        {
+            if(i % 2) ProfileScope("odd");
+            else ProfileCount("even", 1);
+        }
+
+        CHECK(profiler().entry("odd").count == 2);
+        CHECK(profiler().entry("even").count == 2);
+    }
+
+    SUBCASE("Profilers of other threads")
+    {
+        ProfileCount("main", 1);
+
+        Profiler other;
+        std::thread thread([&]()
+        {
+            ProfileCount("main", 5);
+            sleepProfiled(sleep_time);
+            other = profiler();
+        });
+        thread.join();
+
+        // The events of the other thread are not recorded in the profiler of this thread
+        CHECK(profiler().entry("main").count == 1);
+        CHECK(profiler().entry("sleep").count == 0);
+
+        profiler() += other;
+
+        CHECK(profiler().entry("main").count == 6);
+        CHECK(profiler().entry("sleep").count == 1);
+        CHECK(profiler().entry("sleep").time >= sleep_time);
+    }
+
+    SUBCASE("JSON output")
+    {
+        profiler().record("solve", 0.5);
+        ProfileCount("warmstart", 2);
+
+        CHECK(profiler().json() ==
+            "{\n"
+            "  \"solve\": {\"count\": 1, \"time\": 0.5},\n"
+            "  \"warmstart\": {\"count\": 2, \"time\": 0}\n"
+            "}");
+    }
+
+    profiler().clear();
+}
@@ -0,0 +1,155 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// The number of objects alive
+std::atomic<int> alive(0);
+
+/// An object that counts how many of its kind are alive.
+struct Counted
+{
+    Counted() { ++alive; }
+    ~Counted() { --alive; }
+};
+
+/// Return a pool of Counted objects.
+auto createPool() -> ThreadLocalPool<Counted>
+{
+    return ThreadLocalPool<Counted>([]() { return std::unique_ptr<Counted>(new Counted()); });
+}
+
+/// A barrier that blocks the threads until a given number of them arrive.
+struct Barrier
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    int remaining;
+
+    explicit Barrier(int count) : remaining(count) {}
+
+    auto wait() -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(--remaining == 0) cv.notify_all();
+        else cv.wait(lock, [&]() { return remaining == 0; });
+    }
+};
+
+} // namespace
+
+TEST_CASE("Concurrent threads lease distinct objects")
+{
+    ThreadLocalPool<Counted> pool = createPool();
+
+    const int nthreads = 8;
+    std::vector<const Counted*> objects(nthreads);
+    std::vector<bool> stable(nthreads);
+    Barrier barrier(nthreads);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nthreads; ++t)
+        threads.emplace_back([&, t]()
+        {
+            objects[t] = &pool.local();
+            barrier.wait(); // keep all leases alive at the same time
+            stable[t] = &pool.local() == objects[t];
+        });
+    for(std::thread& thread : threads)
+        thread.join();
+
+    CHECK(std::set<const Counted*>(objects.begin(), objects.end()).size() == nthreads);
+    CHECK(std::count(stable.begin(), stable.end(), true) == nthreads);
+    CHECK(pool.numCreated() == nthreads);
+    CHECK(pool.numIdle() == nthreads);
+}
+
+TEST_CASE("Later threads reuse the objects of threads that exited")
+{
+    ThreadLocalPool<Counted> pool = createPool();
+
+    for(int i = 0; i < 10; ++i)
+        std::thread([&]() { pool.local(); }).join();
+
+    CHECK(pool.numCreated() == 1);
+    CHECK(pool.numIdle() == 1);
+}
+
+TEST_CASE("Objects leased from a destroyed pool are deleted")
+{
+    const int initial = alive;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int stage = 0;
+
+    auto advance = [&](int next)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stage = next;
+        cv.notify_all();
+    };
+
+    auto await = [&](int expected)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return stage == expected; });
+    };
+
+    std::unique_ptr<ThreadLocalPool<Counted>> pool(new ThreadLocalPool<Counted>(createPool()));
+
+    int alive_after_drop = -1;
+
+    // A long-lived thread leases an object, outlives the pool, and then uses another pool
+    std::thread worker([&]()
+    {
+        pool->local();
+        advance(1);
+        await(2);
+        ThreadLocalPool<Counted> other = createPool();
+        other.local();
+        alive_after_drop = alive - initial;
+        advance(3);
+    });
+
+    await(1);
+    CHECK(alive - initial == 1);
+    pool.reset(); // the leased object is still owned by the worker thread
+    CHECK(alive - initial == 1);
+    advance(2);
+    await(3);
+    worker.join();
+
+    // Only the object leased from the other pool was alive after the next lease
+    CHECK(alive_after_drop == 1);
+    CHECK(alive - initial == 0);
+}
@@ -0,0 +1,180 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <vector>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// The number of equilibrium problems in the batch
+const Index num_problems = 6;
+
+/// Return a chemical system with aqueous, gaseous and mineral phases.
+auto createChemicalSystem() -> ChemicalSystem
+{
+    ChemicalEditor editor;
+    editor.addAqueousPhase("H2O(l) H+ OH- Na+ Cl- CO2(aq) HCO3- CO3-- Ca++");
+    editor.addGaseousPhase("H2O(g) CO2(g)");
+    editor.addMineralPhase("Calcite");
+    return ChemicalSystem(editor);
+}
+
+/// The inputs and outputs of a batch of equilibrium problems in structure-of-arrays layout.
+/// The species amounts `n` are the initial guesses on input, and are zero for a cold start.
+/// The species amounts `n0` are the ones used to calculate the element amounts `be`.
+struct BatchData
+{
+    Vector T, P, be, n0, n, y, z, dnedbe;
+    bool succeeded[num_problems];
+};
+
+/// Return the inputs of the equilibrium problems, which alternate between two (T,P) pairs.
+auto createBatchData(const ChemicalSystem& system) -> BatchData
+{
+    const Index N = system.numSpecies();
+    const Index E = system.numElements();
+
+    BatchData data;
+    data.T.resize(num_problems);
+    data.P.resize(num_problems);
+    data.be.resize(num_problems*E);
+    data.n0.resize(num_problems*N);
+    data.n = zeros(num_problems*N);
+    data.y = zeros(num_problems*E);
+    data.z = zeros(num_problems*N);
+    data.dnedbe = zeros(num_problems*N*E);
+
+    for(Index k = 0; k < num_problems; ++k)
+    {
+        const bool hot = k % 3 == 1;
+        data.T[k] = hot ? 348.15 : 298.15;
+        data.P[k] = hot ? 50.0e5 : 1.0e5;
+
+        ChemicalState state(system);
+        state.setSpeciesAmounts(1e-6);
+        state.setSpeciesAmount("H2O(l)", 55.0);
+        state.setSpeciesAmount("Na+", 0.1 + 0.2*k);
+        state.setSpeciesAmount("Cl-", 0.1 + 0.2*k);
+        state.setSpeciesAmount("CO2(aq)", 0.5 + 0.1*k);
+        state.setSpeciesAmount("Calcite", 1.0);
+        data.be.segment(k*E, E) = state.elementAmounts();
+        data.n0.segment(k*N, N) = state.speciesAmounts();
+    }
+
+    return data;
+}
+
+/// Solve the equilibrium problems with a batch calculation.
+auto solveBatch(const ChemicalSystem& system, const EquilibriumOptions& options, BatchData& data) -> void
+{
+    EquilibriumSolver solver(system);
+    solver.setOptions(options);
+
+    EquilibriumBatch batch;
+    batch.size = num_problems;
+    batch.T = data.T.data();
+    batch.P = data.P.data();
+    batch.be = data.be.data();
+    batch.n = data.n.data();
+    batch.y = data.y.data();
+    batch.z = data.z.data();
+    batch.dnedbe = data.dnedbe.data();
+    batch.succeeded = data.succeeded;
+
+    solver.solve(batch);
+}
+
+/// Solve the equilibrium problems one by one with individual equilibrium states.
+auto solveIndividually(const ChemicalSystem& system, const EquilibriumOptions& options, BatchData& data) -> void
+{
+    const Index N = system.numSpecies();
+    const Index E = system.numElements();
+
+    EquilibriumSolver solver(system);
+    solver.setOptions(options);
+
+    for(Index k = 0; k < num_problems; ++k)
+    {
+        EquilibriumState state(system);
+        state.setSpeciesAmounts(data.n.segment(k*N, N));
+
+        const Vector be = data.be.segment(k*E, E);
+        const EquilibriumResult res = solver.solve(state, data.T[k], data.P[k], be);
+
+        data.n.segment(k*N, N) = state.speciesAmounts();
+        data.y.segment(k*E, E) = state.elementDualPotentials();
+        data.z.segment(k*N, N) = state.speciesDualPotentials();
+        data.succeeded[k] = res.optimum.succeeded;
+
+        const Matrix dnedbe = solver.sensitivity().dnedbe;
+        data.dnedbe.segment(k*N*E, N*E) = Vector::Map(dnedbe.data(), N*E);
+    }
+}
+
+/// Check that the batch and the individual calculations give the same results.
+auto checkEqual(const BatchData& batch, const BatchData& individual) -> void
+{
+    for(Index k = 0; k < num_problems; ++k)
+        CHECK(batch.succeeded[k] == individual.succeeded[k]);
+
+    CHECK((batch.n - individual.n).norm() <= 1e-12 * individual.n.norm());
+    CHECK((batch.y - individual.y).norm() <= 1e-12 * individual.y.norm());
+    CHECK((batch.z - individual.z).norm() <= 1e-12 * individual.z.norm());
+    CHECK((batch.dnedbe - individual.dnedbe).norm() <= 1e-12 * individual.dnedbe.norm());
+}
+
+} // namespace
+
+TEST_CASE("Batch equilibrium calculations agree with individual ones")
+{
+    const ChemicalSystem system = createChemicalSystem();
+
+    BatchData batch = createBatchData(system);
+    BatchData individual = batch;
+
+    EquilibriumOptions options;
+
+    SUBCASE("Converged problems")
+    {
+        solveBatch(system, options, batch);
+        solveIndividually(system, options, individual);
+
+        checkEqual(batch, individual);
+        for(Index k = 0; k < num_problems; ++k)
+            CHECK(batch.succeeded[k]);
+    }
+
+    SUBCASE("Problems stopped before convergence")
+    {
+        // Start from the given species amounts, since the simplex initial guess is also limited in iterations
+        batch.n = individual.n = batch.n0;
+        options.optimum.max_iterations = 2;
+
+        solveBatch(system, options, batch);
+        solveIndividually(system, options, individual);
+
+        checkEqual(batch, individual);
+        for(Index k = 0; k < num_problems; ++k)
+            CHECK_FALSE(batch.succeeded[k]);
+    }
+}
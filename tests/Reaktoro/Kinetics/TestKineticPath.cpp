@@ -0,0 +1,129 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <fstream>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// Return the editor of a system with calcite dissolving in a dilute HCl solution
+auto calciteEditor() -> ChemicalEditor
+{
+    ChemicalEditor editor;
+    editor.addAqueousPhase("H2O HCl CaCO3");
+    editor.addMineralPhase("Calcite");
+    editor.addMineralReaction("Calcite")
+        .setEquation("Calcite = Ca++ + CO3--")
+        .addMechanism("logk = -5.81 mol/(m2*s); Ea = 23.5 kJ/mol")
+        .addMechanism("logk = -0.30 mol/(m2*s); Ea = 14.4 kJ/mol; a[H+] = 1.0")
+        .setSpecificSurfaceArea(10, "cm2/g");
+    return editor;
+}
+
+/// Solve the kinetic path of the calcite system for 5 minutes and return the output times (in minutes)
+auto solveCalcitePath(const KineticOutputOptions& policy, std::string filename, KineticState& state) -> std::vector<double>
+{
+    ChemicalEditor editor = calciteEditor();
+    ChemicalSystem system(editor);
+    ReactionSystem reactions(editor);
+
+    Partition partition(system);
+    partition.setKineticSpecies({"Calcite"});
+
+    EquilibriumProblem problem(system);
+    problem.setPartition(partition);
+    problem.add("H2O", 1, "kg");
+    problem.add("HCl", 1, "mmol");
+
+    state = equilibrate(problem);
+    state.setSpeciesMass("Calcite", 100, "g");
+
+    KineticOptions options;
+    options.output = policy;
+
+    KineticPath path(reactions);
+    path.setOptions(options);
+    path.setPartition(partition);
+
+    ChemicalOutput output = path.output();
+    output.file(filename);
+    output.data("t(units=minute)");
+
+    path.solve(state, 0, 5, "minute");
+
+    std::vector<double> times;
+    std::ifstream file(filename);
+    std::string header;
+    std::getline(file, header);
+    double t;
+    while(file >> t)
+        times.push_back(t);
+    return times;
+}
+
+} // namespace
+
+TEST_CASE("Kinetic path output at every step, fixed times, tolerance, and events")
+{
+    KineticState state_every, state_interval, state_tolerance, state_events;
+
+    KineticOutputOptions every;
+    const std::vector<double> times_every = solveCalcitePath(every, "TestKineticPath-every.txt", state_every);
+
+    KineticOutputOptions interval;
+    interval.interval = 60.0;
+    const std::vector<double> times_interval = solveCalcitePath(interval, "TestKineticPath-interval.txt", state_interval);
+
+    KineticOutputOptions tolerance;
+    tolerance.tolerance = 0.5;
+    const std::vector<double> times_tolerance = solveCalcitePath(tolerance, "TestKineticPath-tolerance.txt", state_tolerance);
+
+    KineticOutputOptions events;
+    events.events = true;
+    const std::vector<double> times_events = solveCalcitePath(events, "TestKineticPath-events.txt", state_events);
+
+    const double calcite = state_every.speciesAmount("Calcite");
+
+    // Every step is output by default
+    REQUIRE(times_every.size() > 6);
+    CHECK(times_every.front() == 0.0);
+    CHECK(times_every.back() == approx(5.0));
+
+    // The states are output at the fixed times
+    REQUIRE(times_interval.size() == 6);
+    for(Index i = 0; i < times_interval.size(); ++i)
+        CHECK(times_interval[i] == approx(i));
+    CHECK(state_interval.speciesAmount("Calcite") == approx(calcite).epsilon(1e-4));
+
+    // The states are output only if they changed more than the tolerance
+    CHECK(times_tolerance.size() < times_every.size());
+    CHECK(times_tolerance.front() == 0.0);
+    CHECK(times_tolerance.back() == approx(5.0));
+    CHECK(state_tolerance.speciesAmount("Calcite") == calcite);
+
+    // The states are output only at events and at the ends of the path
+    CHECK(times_events.size() < times_every.size());
+    CHECK(times_events.front() == 0.0);
+    CHECK(times_events.back() == approx(5.0));
+    CHECK(state_events.speciesAmount("Calcite") == calcite);
+}
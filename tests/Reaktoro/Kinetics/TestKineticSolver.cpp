@@ -0,0 +1,120 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// The amount of calcite dissolved in one hour and the final state of a kinetic path with the given method
+struct CalciteDissolution
+{
+    double dissolved;
+    KineticState state;
+};
+
+/// Dissolve calcite for one hour in an aqueous solution whose initial equilibrium problem is set up by a given function
+auto dissolveCalcite(std::string species, std::function<void(EquilibriumProblem&)> setup, KineticMethod method) -> CalciteDissolution
+{
+    ChemicalEditor editor;
+    editor.addAqueousPhase(species);
+    editor.addMineralPhase("Calcite");
+    editor.addMineralReaction("Calcite")
+        .setEquation("Calcite = Ca++ + CO3--")
+        .addMechanism("logk = -5.81 mol/(m2*s); Ea = 23.5 kJ/mol")
+        .addMechanism("logk = -0.30 mol/(m2*s); Ea = 14.4 kJ/mol; a[H+] = 1.0")
+        .setSpecificSurfaceArea(10, "cm2/g");
+
+    ChemicalSystem system(editor);
+    ReactionSystem reactions(editor);
+
+    Partition partition(system);
+    partition.setKineticSpecies({"Calcite"});
+
+    EquilibriumProblem problem(system);
+    problem.setPartition(partition);
+    problem.add("H2O", 1, "kg");
+    setup(problem);
+
+    KineticState state = equilibrate(problem);
+    state.setSpeciesMass("Calcite", 10, "g");
+
+    const double initial = state.speciesAmount("Calcite");
+
+    KineticOptions options;
+    options.method = method;
+    options.ode.reltol = 1e-6;
+    options.ode.abstol = 1e-14;
+    options.dae.reltol = 1e-6;
+    options.dae.abstol = 1e-12;
+
+    KineticSolver solver(reactions);
+    solver.setOptions(options);
+    solver.setPartition(partition);
+    solver.solve(state, 0, 3600);
+
+    return {initial - state.speciesAmount("Calcite"), state};
+}
+
+/// Check that the DAE and nested methods agree on the dissolution of calcite
+auto checkDaeAgainstNested(std::string species, std::function<void(EquilibriumProblem&)> setup) -> void
+{
+    const CalciteDissolution nested = dissolveCalcite(species, setup, KineticMethod::Nested);
+    const CalciteDissolution dae = dissolveCalcite(species, setup, KineticMethod::DAE);
+
+    REQUIRE(nested.dissolved > 0.0);
+    CHECK(dae.dissolved == approx(nested.dissolved).epsilon(1e-3));
+    CHECK(dae.state.speciesAmount("Ca++") == approx(nested.state.speciesAmount("Ca++")).epsilon(1e-3));
+    CHECK(dae.state.speciesAmount("HCO3-") == approx(nested.state.speciesAmount("HCO3-")).epsilon(1e-3));
+    CHECK(dae.state.speciesAmount("H+") == approx(nested.state.speciesAmount("H+")).epsilon(1e-3));
+}
+
+} // namespace
+
+TEST_CASE("DAE and nested kinetics of calcite dissolution")
+{
+    SUBCASE("Calcite in dilute HCl")
+    {
+        checkDaeAgainstNested("H2O HCl CaCO3", [](EquilibriumProblem& problem)
+        {
+            problem.add("HCl", 1, "mmol");
+        });
+    }
+
+    SUBCASE("Calcite in a NaCl brine with CO2")
+    {
+        checkDaeAgainstNested("H2O NaCl CaCO3 CO2", [](EquilibriumProblem& problem)
+        {
+            problem.add("CO2", 10, "mmol");
+            problem.add("NaCl", 0.1, "mol");
+            problem.add("CaCl2", 1, "mmol");
+        });
+    }
+
+    SUBCASE("Calcite in a NaCl brine with CO2 and selected species")
+    {
+        checkDaeAgainstNested("H2O(l) H+ OH- Na+ Cl- Ca++ HCO3- CO2(aq) CO3-- CaCO3(aq) CaCl+", [](EquilibriumProblem& problem)
+        {
+            problem.add("CO2", 10, "mmol");
+            problem.add("NaCl", 0.1, "mol");
+            problem.add("CaCl2", 1, "mmol");
+        });
+    }
+}
@@ -0,0 +1,75 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+#include <Reaktoro/Math/DaeSolver.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Robertson chemical kinetics problem as an index-1 DAE")
+{
+    // The stiff kinetics of three species, with the last one given by mass conservation
+    DaeProblem problem;
+    problem.setNumEquations(3);
+    problem.setFunction([](double t, const Vector& y, const Vector& ydot, Vector& F)
+    {
+        F.resize(3);
+        F[0] = ydot[0] - (-0.04*y[0] + 1e4*y[1]*y[2]);
+        F[1] = ydot[1] - (0.04*y[0] - 1e4*y[1]*y[2] - 3e7*y[1]*y[1]);
+        F[2] = y[0] + y[1] + y[2] - 1.0;
+        return 0;
+    });
+
+    DaeOptions options;
+    options.reltol = 1e-6;
+    options.abstols.resize(3);
+    options.abstols << 1e-8, 1e-12, 1e-8;
+    options.algebraic = {2};
+
+    DaeSolver solver;
+    solver.setOptions(options);
+    solver.setProblem(problem);
+
+    Vector y(3), ydot(3);
+    y << 1.0, 0.0, 0.0;
+    ydot << -0.04, 0.04, 0.0;
+    solver.initialize(0.0, y, ydot);
+
+    // The reference solution computed with IDA from SUNDIALS (example idaRoberts_dns)
+    const double times[] = {0.4, 4.0, 40.0, 400.0, 4e3, 4e4};
+    const double expected[][3] = {
+        {9.8517e-01, 3.3864e-05, 1.4794e-02},
+        {9.0553e-01, 2.2406e-05, 9.4452e-02},
+        {7.1579e-01, 9.1838e-06, 2.8420e-01},
+        {4.5053e-01, 3.2228e-06, 5.4946e-01},
+        {1.8320e-01, 8.9444e-07, 8.1680e-01},
+        {3.8992e-02, 1.6221e-07, 9.6101e-01}};
+
+    double t = 0.0;
+    for(unsigned k = 0; k < 6; ++k)
+    {
+        while(t < times[k])
+            solver.integrate(t, y, times[k]);
+
+        REQUIRE(t == times[k]);
+        for(unsigned i = 0; i < 3; ++i)
+            CHECK(y[i] == approx(expected[k][i]).epsilon(1e-3));
+        CHECK(y.sum() == approx(1.0).epsilon(1e-12));
+    }
+}
@@ -0,0 +1,59 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("First-order decay integrated to output times closer than the steps")
+{
+    const double k = 2.0;
+
+    ODEProblem problem;
+    problem.setNumEquations(1);
+    problem.setFunction([=](double t, const Vector& y, Vector& f) { f = -k*y; return 0; });
+    problem.setJacobian([=](double t, const Vector& y, Matrix& J) { J.setConstant(1, 1, -k); return 0; });
+
+    ODEOptions options;
+    options.reltol = 1e-8;
+    options.abstol = 1e-14;
+
+    ODESolver solver;
+    solver.setOptions(options);
+    solver.setProblem(problem);
+
+    double t = 0.0;
+    Vector y = ones(1);
+    solver.initialize(t, y);
+
+    // The output times are much closer than the steps of the integration near the end,
+    // so that many of them are interpolated without taking a new step
+    const double dt = 1e-3;
+    for(Index i = 1; i <= 3000; ++i)
+    {
+        const double tout = i * dt;
+        while(t < tout)
+            solver.integrate(t, y, tout);
+        REQUIRE(t == tout);
+        CHECK(y[0] == approx(std::exp(-k*t)).epsilon(1e-5));
+    }
+
+    CHECK(t == approx(3.0));
+    CHECK(y[0] == approx(std::exp(-k*3.0)).epsilon(1e-5));
+}
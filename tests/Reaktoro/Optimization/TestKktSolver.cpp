@@ -0,0 +1,161 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// The number of species in each phase: a large aqueous phase, a gaseous phase, and two pure minerals.
+const Indices phase_sizes = {40, 3, 1, 1};
+
+/// The number of elements
+const Index num_elements = 6;
+
+/// A KKT problem with the structure of a multiphase chemical equilibrium problem near convergence.
+struct KktProblem
+{
+    Hessian H;
+    Matrix A;
+    Vector x, z;
+    KktVector rhs;
+};
+
+/// Create a KKT problem whose Hessian has one diagonal block per phase.
+/// @param ideal If true, the blocks are `diag(1/n) - 1*tr(1)/nt`, singular along the composition of the phase.
+/// Otherwise, the blocks are just `diag(1/n)`.
+auto createKktProblem(bool ideal) -> KktProblem
+{
+    Index num_species = 0;
+    for(Index size : phase_sizes)
+        num_species += size;
+
+    KktProblem problem;
+
+    // The amounts of the species span many orders of magnitude, as in an aqueous phase with solvent and trace species
+    problem.x.resize(num_species);
+    for(Index i = 0; i < num_species; ++i)
+        problem.x[i] = 55.0 * std::pow(10.0, -12.0*i/(num_species - 1));
+
+    // The dual variables of the bound constraints are small, as they are near convergence
+    problem.z = 1e-8 * ones(num_species);
+
+    // The formula matrix of the species, with full row rank and entries between 0 and 3
+    problem.A.resize(num_elements, num_species);
+    for(Index i = 0; i < num_elements; ++i)
+        for(Index j = 0; j < num_species; ++j)
+            problem.A(i, j) = std::floor(4.0*std::abs(std::sin(1.0 + i + 7.0*j + 0.3*i*j)));
+
+    // The block-diagonal Hessian matrix of the ideal Gibbs energy function
+    problem.H.mode = Hessian::Dense;
+    problem.H.dense = zeros(num_species, num_species);
+    problem.H.blocks.resize(num_species);
+    for(Index k = 0, offset = 0; k < phase_sizes.size(); ++k)
+    {
+        const Index size = phase_sizes[k];
+        const auto np = rows(problem.x, offset, size);
+        auto Hk = problem.H.dense.block(offset, offset, size, size);
+        if(size > 1)
+        {
+            Hk.diagonal() = inv(np);
+            if(ideal)
+                Hk.array() -= 1.0/np.sum();
+        }
+        for(Index i = offset; i < offset + size; ++i)
+            problem.H.blocks[i] = k;
+        offset += size;
+    }
+
+    // The right-hand side vector of the KKT equation
+    problem.rhs.rx = linspace(num_species, -1.0, 1.0);
+    problem.rhs.ry = linspace(num_elements, 0.5, 1.5);
+    problem.rhs.rz = 1e-10 * ones(num_species);
+
+    return problem;
+}
+
+/// Solve a KKT problem using a given method.
+auto solveKkt(const KktProblem& problem, const Hessian& H, KktMethod method) -> KktSolution
+{
+    KktOptions options;
+    options.method = method;
+
+    KktSolver solver;
+    solver.setOptions(options);
+
+    KktSolution sol;
+    solver.decompose({H, problem.A, problem.x, problem.z});
+    solver.solve(problem.rhs, sol);
+
+    CHECK(solver.result().succeeded);
+
+    return sol;
+}
+
+/// Check that two solutions of a KKT equation agree.
+auto checkEqual(const KktSolution& actual, const KktSolution& expected) -> void
+{
+    CHECK((actual.dx - expected.dx).norm() <= 1e-8 * expected.dx.norm());
+    CHECK((actual.dy - expected.dy).norm() <= 1e-8 * expected.dy.norm());
+}
+
+/// Return the relative residual of the first two block rows of the KKT equation.
+auto residual(const KktProblem& problem, const KktSolution& sol) -> double
+{
+    const Vector rx = problem.H.dense*sol.dx + (problem.z/problem.x) % sol.dx - tr(problem.A)*sol.dy;
+    const Vector ry = problem.A*sol.dx;
+    const Vector r = problem.rhs.rx + problem.rhs.rz/problem.x;
+    return ((rx - r).norm() + (ry - problem.rhs.ry).norm())/(r.norm() + problem.rhs.ry.norm());
+}
+
+} // namespace
+
+TEST_CASE("Block-diagonal rangespace KKT solver with a large aqueous block")
+{
+    SUBCASE("Ideal phase Hessians singular along their compositions")
+    {
+        const KktProblem problem = createKktProblem(true);
+
+        const KktSolution block = solveKkt(problem, problem.H, KktMethod::Rangespace);
+        const KktSolution dense = solveKkt(problem, problem.H, KktMethod::FullPivLU);
+
+        // The KKT matrix is ill-conditioned along the phase compositions, so that
+        // even the dense LU algorithms only attain residuals of about 1e-9 here
+        checkEqual(block, dense);
+        CHECK(residual(problem, block) < 1e-8);
+    }
+
+    SUBCASE("Diagonal phase Hessians")
+    {
+        const KktProblem problem = createKktProblem(false);
+
+        Hessian Hdiag;
+        Hdiag.mode = Hessian::Diagonal;
+        Hdiag.diagonal = problem.H.dense.diagonal();
+
+        const KktSolution block = solveKkt(problem, problem.H, KktMethod::Rangespace);
+        const KktSolution diagonal = solveKkt(problem, Hdiag, KktMethod::Rangespace);
+        const KktSolution dense = solveKkt(problem, problem.H, KktMethod::PartialPivLU);
+
+        checkEqual(block, diagonal);
+        checkEqual(block, dense);
+        CHECK(residual(problem, block) < 1e-12);
+    }
+}
@@ -0,0 +1,211 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// A linear programming problem in the form `min tr(c)*x` subject to `A*x = b` and `l <= x <= u`, with known optimum.
+struct LinearProblem
+{
+    OptimumProblem problem;
+    Vector xopt;
+};
+
+/// Return a linear problem with the given coefficients, bounds, and optimal solution.
+auto createLinearProblem(const Matrix& A, const Vector& b, const Vector& c, const Vector& l, const Vector& u, const Vector& xopt) -> LinearProblem
+{
+    LinearProblem lp;
+    lp.problem.n = c.rows();
+    lp.problem.A = A;
+    lp.problem.b = b;
+    lp.problem.c = c;
+    lp.problem.l = l;
+    lp.problem.u = u;
+    lp.xopt = xopt;
+    return lp;
+}
+
+/// Return the problem `max 3x1 + 5x2` subject to `x1 <= 4`, `2x2 <= 12`, `3x1 + 2x2 <= 18`, with slack variables.
+auto createProductionProblem() -> LinearProblem
+{
+    Matrix A(3, 5);
+    A << 1, 0, 1, 0, 0,
+         0, 2, 0, 1, 0,
+         3, 2, 0, 0, 1;
+
+    Vector b(3), c(5), xopt(5);
+    b << 4, 12, 18;
+    c << -3, -5, 0, 0, 0;
+    xopt << 2, 6, 2, 0, 0;
+
+    return createLinearProblem(A, b, c, zeros(5), constants(5, infinity()), xopt);
+}
+
+/// Return the degenerate problem of Beale (1955), on which the Dantzig rule cycles without anti-cycling safeguards.
+auto createDegenerateProblem() -> LinearProblem
+{
+    Matrix A(3, 7);
+    A << 1, 0, 0, 0.25,  -8.0, -1.0, 9.0,
+         0, 1, 0, 0.50, -12.0, -0.5, 3.0,
+         0, 0, 1, 0.00,   0.0,  1.0, 0.0;
+
+    Vector b(3), c(7), xopt(7);
+    b << 0, 0, 1;
+    c << 0, 0, 0, -0.75, 20, -0.5, 6;
+    xopt << 0.75, 0, 0, 1, 0, 1, 0;
+
+    return createLinearProblem(A, b, c, zeros(7), constants(7, infinity()), xopt);
+}
+
+/// Return the problem `max x1 + 2x2` subject to `x1 + x2 <= 10`, `x1 <= 3`, and `x2 <= 4`, with the upper
+/// bounds as simple bounds, so that the entering variables reach their upper bounds before any basic variable
+/// reaches its bounds.
+auto createBoundFlipProblem() -> LinearProblem
+{
+    Matrix A(1, 3);
+    A << 1, 1, 1;
+
+    Vector b(1), c(3), u(3), xopt(3);
+    b << 10;
+    c << -1, -2, 0;
+    u << 3, 4, infinity();
+    xopt << 3, 4, 3;
+
+    return createLinearProblem(A, b, c, zeros(3), u, xopt);
+}
+
+/// Return the options for the simplex calculation with a given pricing rule.
+auto simplexOptions(SimplexPricing pricing) -> OptimumOptions
+{
+    OptimumOptions options;
+    options.simplex.pricing = pricing;
+    return options;
+}
+
+/// Solve a linear problem with a given simplex solver and check its solution against the known optimum.
+auto solveAndCheck(OptimumSolverSimplex& solver, const LinearProblem& lp, const OptimumOptions& options) -> OptimumResult
+{
+    OptimumState state;
+    const OptimumResult result = solver.solve(lp.problem, state, options);
+
+    const Vector& x = state.x;
+    const Matrix& A = lp.problem.A;
+    const Vector& b = lp.problem.b;
+
+    CHECK(result.succeeded);
+    REQUIRE(x.rows() == lp.xopt.rows());
+    CHECK((x - lp.xopt).norm() <= 1e-12 * (1.0 + lp.xopt.norm()));
+    CHECK((A*x - b).norm() <= 1e-12 * (1.0 + b.norm()));
+    CHECK(state.f.val == approx(dot(lp.problem.c, lp.xopt)));
+    CHECK(x.minCoeff() >= 0.0);
+    for(Index i = 0; i < x.rows(); ++i)
+        CHECK(x[i] <= lp.problem.u[i]);
+
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Revised simplex method on problems with known optima")
+{
+    for(SimplexPricing pricing : {SimplexPricing::Devex, SimplexPricing::Dantzig})
+    {
+        const OptimumOptions options = simplexOptions(pricing);
+
+        SUBCASE("Nondegenerate problem")
+        {
+            OptimumSolverSimplex solver;
+            solveAndCheck(solver, createProductionProblem(), options);
+        }
+
+        SUBCASE("Degenerate problem")
+        {
+            OptimumSolverSimplex solver;
+            solveAndCheck(solver, createDegenerateProblem(), options);
+        }
+
+        SUBCASE("Bound flips of entering variables")
+        {
+            OptimumSolverSimplex solver;
+            solveAndCheck(solver, createBoundFlipProblem(), options);
+        }
+    }
+}
+
+TEST_CASE("Revised simplex method with product-form updates of the basis")
+{
+    const LinearProblem lp = createDegenerateProblem();
+
+    // Refactorize the basis at every pivot, so that no product-form update is used
+    OptimumOptions refactorized;
+    refactorized.simplex.refactorization = 0;
+
+    OptimumSolverSimplex solver;
+    OptimumSolverSimplex other;
+
+    const OptimumResult updated = solveAndCheck(solver, lp, OptimumOptions());
+    const OptimumResult fresh = solveAndCheck(other, lp, refactorized);
+
+    CHECK(updated.iterations == fresh.iterations);
+}
+
+TEST_CASE("Revised simplex method with warm start")
+{
+    LinearProblem lp = createProductionProblem();
+
+    OptimumSolverSimplex solver;
+    const OptimumResult cold = solveAndCheck(solver, lp, OptimumOptions());
+
+    SUBCASE("Optimal basis of the last calculation still feasible")
+    {
+        // Relax the third constraint to `3x1 + 2x2 <= 19`, whose optimum has the same basis
+        lp.problem.b[2] = 19;
+        lp.xopt << 7.0/3.0, 6, 5.0/3.0, 0, 0;
+
+        const OptimumResult warm = solveAndCheck(solver, lp, OptimumOptions());
+
+        // Phase I is skipped and the last basis is already optimal
+        CHECK(warm.iterations == 1);
+        CHECK(warm.iterations < cold.iterations);
+
+        // The same problem without warm start
+        OptimumOptions options;
+        options.simplex.warmstart = false;
+        const OptimumResult nowarm = solveAndCheck(solver, lp, options);
+        CHECK(nowarm.iterations > warm.iterations);
+    }
+
+    SUBCASE("Optimal basis of the last calculation no longer feasible")
+    {
+        // Tighten the first constraint to `x1 <= 1`, which makes the last basic solution infeasible
+        lp.problem.b[0] = 1;
+        lp.xopt << 1, 6, 0, 0, 3;
+
+        solveAndCheck(solver, lp, OptimumOptions());
+    }
+
+    SUBCASE("Optimal basis of the last calculation with other dimensions")
+    {
+        solveAndCheck(solver, createBoundFlipProblem(), OptimumOptions());
+        solveAndCheck(solver, createProductionProblem(), OptimumOptions());
+    }
+}
@@ -0,0 +1,141 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// A linear equality constrained problem and its state, before and after regularization.
+struct RegularizedProblem
+{
+    OptimumProblem problem;
+    OptimumState state;
+    OptimumOptions options;
+};
+
+/// Return a problem whose constraints resemble the mass balance of a chemical system.
+/// The last row is a linear combination of the others, as the charge balance row is.
+auto createProblem() -> RegularizedProblem
+{
+    RegularizedProblem res;
+
+    res.problem.n = 6;
+    res.problem.A.resize(4, 6);
+    res.problem.A << 2, 1, 1, 0, 0, 2,
+                     1, 0, 1, 2, 3, 1,
+                     0, 1, 0, 1, 0, 0,
+                     3, 2, 2, 3, 3, 3;
+    res.problem.l = zeros(6);
+
+    res.state.x.resize(6);
+    res.state.x << 55.0, 1e-7, 1e-3, 0.5, 2e-5, 1.0;
+    res.state.y = zeros(4);
+    res.state.z = zeros(6);
+
+    res.problem.b = res.problem.A * res.state.x;
+
+    return res;
+}
+
+/// Return a problem whose constraints have a different coefficient matrix.
+auto createOtherProblem() -> RegularizedProblem
+{
+    RegularizedProblem res = createProblem();
+    res.problem.A(0, 1) = 3;
+    res.problem.A(3, 1) = 4;
+    res.problem.b = res.problem.A * res.state.x;
+    return res;
+}
+
+/// Return a problem whose second constraint is trivial, fixing the variables 0, 2, 3, 4, 5 at their lower bounds.
+auto createTrivialProblem() -> RegularizedProblem
+{
+    RegularizedProblem res = createProblem();
+    res.problem.b[1] = 0.0;
+    return res;
+}
+
+/// Regularize a problem with a given regularizer and return the regularized problem.
+auto regularize(Regularizer& regularizer, RegularizedProblem res) -> RegularizedProblem
+{
+    regularizer.regularize(res.problem, res.state, res.options);
+    return res;
+}
+
+/// Check that two regularized problems have the same echelon form.
+auto checkEqual(const RegularizedProblem& actual, const RegularizedProblem& expected) -> void
+{
+    REQUIRE(actual.problem.A.rows() == expected.problem.A.rows());
+    REQUIRE(actual.problem.A.cols() == expected.problem.A.cols());
+    CHECK(actual.problem.A == expected.problem.A);
+    CHECK(actual.problem.b == expected.problem.b);
+    CHECK(actual.state.x == expected.state.x);
+    CHECK(actual.state.y == expected.state.y);
+}
+
+} // namespace
+
+TEST_CASE("Regularized constraints do not depend on the reuse of the preprocessed constraints")
+{
+    Regularizer regularizer;
+
+    // The first calculation preprocesses the constraints
+    const RegularizedProblem miss = regularize(regularizer, createProblem());
+
+    // The linearly dependent row has been removed and the rest echelonized
+    CHECK(miss.problem.A.rows() == 3);
+    CHECK(miss.problem.A.cols() == 6);
+
+    SUBCASE("Preprocessed constraints reused by the same regularizer")
+    {
+        checkEqual(regularize(regularizer, createProblem()), miss);
+    }
+
+    SUBCASE("Preprocessed constraints shared with another regularizer")
+    {
+        Regularizer other;
+        checkEqual(regularize(other, createProblem()), miss);
+    }
+
+    SUBCASE("Preprocessed constraints reused after another coefficient matrix")
+    {
+        const RegularizedProblem first = regularize(regularizer, createOtherProblem());
+        checkEqual(regularize(regularizer, createProblem()), miss);
+
+        Regularizer other;
+        checkEqual(regularize(other, createOtherProblem()), first);
+    }
+
+    SUBCASE("Preprocessed constraints with trivial constraints")
+    {
+        const RegularizedProblem trivial = regularize(regularizer, createTrivialProblem());
+
+        // Only the variable that does not participate in the trivial constraint remains
+        CHECK(trivial.problem.n == 1);
+        CHECK(trivial.problem.A.cols() == 1);
+
+        checkEqual(regularize(regularizer, createProblem()), miss);
+
+        Regularizer other;
+        checkEqual(regularize(other, createTrivialProblem()), trivial);
+        checkEqual(regularize(other, createTrivialProblem()), trivial);
+    }
+}
@@ -0,0 +1,133 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <cmath>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// Return the transport solver for a given mesh, velocity, diffusion coefficient, time step and scheme.
+auto createTransportSolver(const Mesh& mesh, double v, double D, double dt, TransportScheme scheme) -> TransportSolver
+{
+    TransportSolver transport;
+    transport.setMesh(mesh);
+    transport.setVelocity(v);
+    transport.setDiffusionCoeff(D);
+    transport.setTimeStep(dt);
+    transport.setScheme(scheme);
+    transport.initialize();
+    return transport;
+}
+
+/// Return the solution of the advection-diffusion equation for a unit step at the inflow boundary (Ogata and Banks, 1961).
+auto stepFront(double x, double t, double v, double D) -> double
+{
+    const double s = 2*std::sqrt(D*t);
+    return 0.5*(std::erfc((x - v*t)/s) + std::exp(v*x/D)*std::erfc((x + v*t)/s));
+}
+
+/// Return the Gaussian pulse of unit mass with given center and variance.
+auto gaussian(double x, double center, double variance) -> double
+{
+    return std::exp(-(x - center)*(x - center)/(2*variance))/std::sqrt(2*M_PI*variance);
+}
+
+/// Return the maximum error of a field with respect to a function of the cell centers.
+template<typename Function>
+auto maxError(const Vector& u, const Vector& x, Function f) -> double
+{
+    double error = 0.0;
+    for(unsigned i = 0; i < u.rows(); ++i)
+        error = std::max(error, std::abs(u[i] - f(x[i])));
+    return error;
+}
+
+} // namespace
+
+TEST_CASE("Advection and diffusion of a step front from the inflow boundary")
+{
+    const Mesh mesh(200, 0.0, 1.0);
+    const double v = 1.0, D = 1e-2, dt = 1e-3;
+    const Index nsteps = 400;
+    const double t = nsteps*dt;
+
+    auto solve = [&](TransportScheme scheme)
+    {
+        TransportSolver transport = createTransportSolver(mesh, v, D, dt, scheme);
+        Vector u = zeros(mesh.numCells());
+        for(Index i = 0; i < nsteps; ++i)
+            transport.step(u, 1.0);
+        return maxError(u, mesh.xcells(), [&](double x) { return stepFront(x, t, v, D); });
+    };
+
+    // The first-order upwind scheme adds numerical diffusion of about v*dx/2 to the front
+    CHECK(solve(TransportScheme::FluxLimited) < 5e-3);
+    CHECK(solve(TransportScheme::ImplicitUpwind) < 5e-2);
+}
+
+TEST_CASE("Diffusion of a Gaussian pulse")
+{
+    const Mesh mesh(200, 0.0, 1.0);
+    const double D = 1e-3, dt = 1e-2, variance = 1e-3;
+    const Index nsteps = 100;
+    const double t = nsteps*dt;
+
+    TransportSolver transport = createTransportSolver(mesh, 0.0, D, dt, TransportScheme::ImplicitUpwind);
+
+    const Vector& x = mesh.xcells();
+    Vector u(x.rows());
+    for(unsigned i = 0; i < u.rows(); ++i)
+        u[i] = gaussian(x[i], 0.5, variance);
+
+    for(Index i = 0; i < nsteps; ++i)
+        transport.step(u, 0.0);
+
+    // The pulse stays away from the boundaries, so its mass is conserved and its variance grows by 2Dt
+    CHECK(sum(u)*mesh.dx() == approx(1.0));
+    CHECK(maxError(u, x, [&](double x) { return gaussian(x, 0.5, variance + 2*D*t); }) < 5e-3 * gaussian(0.5, 0.5, variance));
+}
+
+TEST_CASE("Advection of a Gaussian pulse with the flux limited scheme")
+{
+    const Mesh mesh(400, 0.0, 1.0);
+    const double v = 1.0, dt = 2e-3, variance = 1e-3;
+    const Index nsteps = 200;
+    const double t = nsteps*dt;
+
+    TransportSolver transport = createTransportSolver(mesh, v, 0.0, dt, TransportScheme::FluxLimited);
+
+    const Vector& x = mesh.xcells();
+    Vector u(x.rows());
+    for(unsigned i = 0; i < u.rows(); ++i)
+        u[i] = gaussian(x[i], 0.25, variance);
+
+    for(Index i = 0; i < nsteps; ++i)
+        transport.step(u, 0.0);
+
+    // The pulse is translated by vt without changing its mass
+    const double mass = sum(u)*mesh.dx();
+    const double center = dot(u, x)*mesh.dx()/mass;
+    CHECK(mass == approx(1.0));
+    CHECK(center == approx(0.25 + v*t));
+    CHECK(maxError(u, x, [&](double x) { return gaussian(x, 0.25 + v*t, variance); }) < 5e-2 * gaussian(0.5, 0.5, variance));
+}
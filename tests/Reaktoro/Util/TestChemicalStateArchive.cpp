@@ -0,0 +1,244 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright (C) 2014-2017 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <doctest/doctest.hpp>
+
+// C++ includes
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// The number of chemical states written to the archives
+const Index num_states = 5;
+
+/// Return a chemical system with aqueous, gaseous and mineral phases.
+auto createChemicalSystem() -> ChemicalSystem
+{
+    ChemicalEditor editor;
+    editor.addAqueousPhase("H2O(l) H+ OH- Na+ Cl- CO2(aq) HCO3- CO3-- Ca++");
+    editor.addGaseousPhase("H2O(g) CO2(g)");
+    editor.addMineralPhase("Calcite");
+    return ChemicalSystem(editor);
+}
+
+/// Return a chemical system with the same elements but other species, and thus another fingerprint.
+auto createOtherChemicalSystem() -> ChemicalSystem
+{
+    ChemicalEditor editor;
+    editor.addAqueousPhase("H2O(l) H+ OH- Na+ Cl- CO2(aq) HCO3- CO3-- Ca++ NaCl(aq)");
+    editor.addGaseousPhase("H2O(g) CO2(g)");
+    editor.addMineralPhase("Calcite");
+    return ChemicalSystem(editor);
+}
+
+/// Return the element amounts of the k-th chemical state.
+auto elementAmounts(const ChemicalSystem& system, Index k) -> Vector
+{
+    ChemicalState state(system);
+    state.setSpeciesAmount("H2O(l)", 55.0);
+    state.setSpeciesAmount("Na+", 0.1 + 0.2*k);
+    state.setSpeciesAmount("Cl-", 0.1 + 0.2*k);
+    state.setSpeciesAmount("CO2(aq)", 0.5 + 0.1*k);
+    state.setSpeciesAmount("Calcite", 1.0);
+    return state.elementAmounts();
+}
+
+/// Return equilibrium states with different temperatures, pressures, and compositions.
+auto createEquilibriumStates(const ChemicalSystem& system) -> std::vector<EquilibriumState>
+{
+    EquilibriumSolver solver(system);
+
+    std::vector<EquilibriumState> states;
+    for(Index k = 0; k < num_states; ++k)
+    {
+        EquilibriumState state(system);
+        solver.solve(state, 298.15 + 10.0*k, 1.0e5 + 1.0e5*k, elementAmounts(system, k));
+        states.push_back(state);
+    }
+    return states;
+}
+
+/// Check that two chemical states have the same temperature, pressure, and molar amounts.
+auto checkEqual(const ChemicalState& actual, const ChemicalState& expected) -> void
+{
+    CHECK(actual.temperature() == expected.temperature());
+    CHECK(actual.pressure() == expected.pressure());
+    CHECK(actual.speciesAmounts() == expected.speciesAmounts());
+}
+
+/// Check that two equilibrium states have the same temperature, pressure, molar amounts, and dual potentials.
+auto checkEqual(const EquilibriumState& actual, const EquilibriumState& expected) -> void
+{
+    checkEqual(static_cast<const ChemicalState&>(actual), static_cast<const ChemicalState&>(expected));
+    CHECK(actual.elementDualPotentials() == expected.elementDualPotentials());
+    CHECK(actual.speciesDualPotentials() == expected.speciesDualPotentials());
+}
+
+} // namespace
+
+TEST_CASE("Chemical states written to and read from binary streams")
+{
+    const ChemicalSystem system = createChemicalSystem();
+    const std::vector<EquilibriumState> states = createEquilibriumStates(system);
+
+    std::stringstream stream;
+    writeBinary(stream, states[1]);
+
+    SUBCASE("Equilibrium states with dual potentials")
+    {
+        EquilibriumState state(system);
+        readBinary(stream, state);
+        checkEqual(state, states[1]);
+    }
+
+    SUBCASE("Chemical states without dual potentials")
+    {
+        ChemicalState state(system);
+        readBinary(stream, state);
+        checkEqual(state, states[1]);
+    }
+
+    SUBCASE("Streams written with another chemical system")
+    {
+        EquilibriumState state(createOtherChemicalSystem());
+        CHECK_THROWS(readBinary(stream, state));
+    }
+}
+
+TEST_CASE("Chemical states written to and memory-mapped from binary files")
+{
+    const ChemicalSystem system = createChemicalSystem();
+    const std::vector<EquilibriumState> states = createEquilibriumStates(system);
+
+    const Index N = system.numSpecies();
+    const Index E = system.numElements();
+
+    const std::string filename = "TestChemicalStateArchive-states.bin";
+    std::remove(filename.c_str());
+
+    // Write the first states, then append the remaining ones to the existing file
+    {
+        ChemicalStateWriter writer(filename, system, true);
+        for(Index k = 0; k < 3; ++k)
+            writer.write(states[k]);
+        CHECK(writer.numStates() == 3);
+    }
+    {
+        ChemicalStateWriter writer(filename, system, true);
+        for(Index k = 3; k < num_states; ++k)
+            writer.write(states[k]);
+        CHECK(writer.numStates() == num_states);
+    }
+
+    SUBCASE("Views of the memory-mapped states")
+    {
+        const ChemicalStateReader reader(filename, system);
+
+        REQUIRE(reader.numStates() == num_states);
+        CHECK(reader.hasDualPotentials());
+
+        for(Index k = 0; k < num_states; ++k)
+        {
+            CHECK(reader.temperature(k) == states[k].temperature());
+            CHECK(reader.pressure(k) == states[k].pressure());
+            CHECK(reader.speciesAmounts(k).size() == N);
+            CHECK(reader.speciesAmounts(k) == states[k].speciesAmounts());
+            CHECK(reader.elementDualPotentials(k).size() == E);
+            CHECK(reader.elementDualPotentials(k) == states[k].elementDualPotentials());
+            CHECK(reader.speciesDualPotentials(k) == states[k].speciesDualPotentials());
+        }
+    }
+
+    SUBCASE("Memory-mapped states read into equilibrium states")
+    {
+        const ChemicalStateReader reader(filename, system);
+
+        for(Index k = 0; k < num_states; ++k)
+        {
+            EquilibriumState state(system);
+            reader.read(k, state);
+            checkEqual(state, states[k]);
+        }
+    }
+
+    SUBCASE("Files written with another chemical system")
+    {
+        const ChemicalSystem other = createOtherChemicalSystem();
+        CHECK_THROWS(ChemicalStateReader(filename, other));
+        CHECK_THROWS(ChemicalStateWriter(filename, other, true));
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Chemical solver restarted from a checkpoint")
+{
+    const ChemicalSystem system = createChemicalSystem();
+
+    const Index npoints = 4;
+    const Index E = system.numElements();
+
+    Vector T(npoints), P(npoints);
+    Matrix be(E, npoints);
+    for(Index k = 0; k < npoints; ++k)
+    {
+        T[k] = 298.15 + 20.0*k;
+        P[k] = 1.0e5 + 1.0e5*k;
+        be.col(k) = elementAmounts(system, k);
+    }
+
+    ChemicalSolver solver(system, npoints);
+    solver.equilibrate(T, P, be);
+
+    const std::string filename = "TestChemicalStateArchive-checkpoint.bin";
+    solver.checkpoint(filename);
+
+    SUBCASE("Restored chemical states and field quantities")
+    {
+        ChemicalSolver restarted(system, npoints);
+        restarted.restart(filename);
+
+        for(Index k = 0; k < npoints; ++k)
+        {
+            const KineticState& actual = restarted.state(k);
+            const KineticState& expected = solver.state(k);
+            checkEqual(actual, expected);
+            CHECK(actual.elementDualPotentials() == expected.elementDualPotentials());
+            CHECK(actual.speciesDualPotentials() == expected.speciesDualPotentials());
+        }
+
+        CHECK(restarted.porosity().val() == solver.porosity().val());
+        CHECK(restarted.fluidTotalVolume().val() == solver.fluidTotalVolume().val());
+    }
+
+    SUBCASE("Checkpoints of other chemical solvers")
+    {
+        ChemicalSolver fewer(system, npoints - 1);
+        CHECK_THROWS(fewer.restart(filename));
+
+        ChemicalSolver other(createOtherChemicalSystem(), npoints);
+        CHECK_THROWS(other.restart(filename));
+    }
+
+    std::remove(filename.c_str());
+}